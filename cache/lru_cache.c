@@ -0,0 +1,196 @@
+#include "lru_cache.h"
+
+/* ------------------------------------------------------------------------- */
+/*                              Internal helpers                             */
+/* ------------------------------------------------------------------------- */
+
+static inline size_t lru_cache_charge(const LruCacheEntry* entry) {
+    return entry->key_size + entry->data_size;
+}
+
+static inline void lru_cache_free_data(const LruCache* cache, LruCacheEntry* entry) {
+    if (entry->data != NULL && cache->deep_deallocate_hashmap_item_data != NULL) {
+        cache->deep_deallocate_hashmap_item_data(entry->data);
+    }
+}
+
+static void lru_cache_unlink(LruCache* cache, LruCacheEntry* entry) {
+    if (entry->prev != NULL) entry->prev->next = entry->next;
+    else cache->front = entry->next;
+    if (entry->next != NULL) entry->next->prev = entry->prev;
+    else cache->back = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void lru_cache_push_front(LruCache* cache, LruCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = cache->front;
+    if (cache->front != NULL) cache->front->prev = entry;
+    else cache->back = entry;
+    cache->front = entry;
+}
+
+static inline void lru_cache_touch(LruCache* cache, LruCacheEntry* entry) {
+    if (cache->front == entry) return;
+    lru_cache_unlink(cache, entry);
+    lru_cache_push_front(cache, entry);
+}
+
+/* Unlinks 'entry', drops its map slot and frees it (and its data, when owned). */
+static void lru_cache_drop(LruCache* cache, LruCacheEntry* entry) {
+    lru_cache_unlink(cache, entry);
+    (void)hash_map_remove_prehashed(cache->map, entry->hash, entry->key, entry->key_size, NULL);
+    cache->size--;
+    cache->bytes -= lru_cache_charge(entry);
+    lru_cache_free_data(cache, entry);
+    free(entry);
+}
+
+static inline int lru_cache_over_bounds(const LruCache* cache) {
+    return (cache->max_entries != 0 && cache->size > cache->max_entries) ||
+           (cache->max_bytes   != 0 && cache->bytes > cache->max_bytes);
+}
+
+/* Evicts from the back until the bounds hold; 'keep' (the entry just put) is never evicted. */
+static void lru_cache_evict(LruCache* cache, const LruCacheEntry* keep) {
+    while (lru_cache_over_bounds(cache) && cache->back != NULL && cache->back != keep) {
+        lru_cache_drop(cache, cache->back);
+        cache->evictions++;
+    }
+}
+
+static LruCacheEntry* lru_cache_lookup(const LruCache* cache, uint64_t h64, const void* key, size_t key_size) {
+    const HashMapItem* item = hash_map_get_prehashed(cache->map, h64, key, key_size);
+    return item != NULL ? (LruCacheEntry*)item->data : NULL;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               Public API                                  */
+/* ------------------------------------------------------------------------- */
+
+LruCache* build_lru_cache(size_t max_entries,
+                          size_t max_bytes,
+                          void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    LruCache* cache = malloc(sizeof(LruCache));
+    if (cache == NULL) {
+        fprintf(stderr, "Failed malloc while trying to build a new LRU cache\n");
+        exit(FAILED_LRU_CACHE_ALLOCATION);
+    }
+
+    cache->map         = build_hash_map();
+    cache->front       = NULL;
+    cache->back        = NULL;
+    cache->size        = 0;
+    cache->bytes       = 0;
+    cache->max_entries = max_entries;
+    cache->max_bytes   = max_bytes;
+    cache->deep_deallocate_hashmap_item_data = deep_deallocate_hashmap_item_data;
+    cache->hits        = 0;
+    cache->misses      = 0;
+    cache->evictions   = 0;
+    return cache;
+}
+
+void lru_cache_destroy(LruCache* cache) {
+    if (cache == NULL) {
+        fprintf(stderr, "You tried to destroy a NULL LRU cache, this is a no-op\n");
+        return;
+    }
+
+    LruCacheEntry* entry = cache->front;
+    while (entry != NULL) {
+        LruCacheEntry* next = entry->next;
+        lru_cache_free_data(cache, entry);
+        free(entry);
+        entry = next;
+    }
+    hash_map_destroy(cache->map, NULL);  /* map data are the entries freed above */
+    free(cache);
+}
+
+int lru_cache_put(LruCache* cache,
+                  const void* key,
+                  size_t key_size,
+                  const void* data,
+                  size_t data_size) {
+    if (cache == NULL) {
+        fprintf(stderr, "You are trying to put data in a NULL LRU cache; did you call build_lru_cache?\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_LRU_CACHE);
+    }
+
+    int inserted;
+    HashMapItem* item = hash_map_get_or_insert(cache->map, key, key_size, &inserted);
+    LruCacheEntry* entry = (LruCacheEntry*)item->data;
+
+    if (!inserted) {
+        lru_cache_free_data(cache, entry);
+        cache->bytes    -= entry->data_size;
+        entry->data      = (void*)data;
+        entry->data_size = data_size;
+        cache->bytes    += data_size;
+        lru_cache_touch(cache, entry);
+        lru_cache_evict(cache, entry);
+        return 1; /* updated existing */
+    }
+
+    entry = malloc(sizeof(LruCacheEntry));
+    if (entry == NULL) {
+        fprintf(stderr, "Failed malloc while trying to put a new LRU cache entry\n");
+        exit(FAILED_LRU_CACHE_ALLOCATION);
+    }
+    entry->hash      = item->hash;
+    entry->data      = (void*)data;
+    entry->data_size = data_size;
+    entry->key_size  = key_size;
+    if (key_size <= HASH_MAP_INLINE_KEY_SIZE) {
+        if (key_size != 0) memcpy(entry->inline_key, key, key_size);
+        entry->key = entry->inline_key;
+    } else {
+        entry->key = (const unsigned char*)item->key;  /* the map's only copy; freed with its slot */
+    }
+    item->data = entry;
+
+    lru_cache_push_front(cache, entry);
+    cache->size++;
+    cache->bytes += lru_cache_charge(entry);
+    lru_cache_evict(cache, entry);
+    return 0; /* inserted new */
+}
+
+const LruCacheEntry* lru_cache_get(LruCache* cache,
+                                   const void* key,
+                                   size_t key_size) {
+    if (cache == NULL) return NULL;
+
+    LruCacheEntry* entry = lru_cache_lookup(cache, hash_map_hash_key(cache->map, key, key_size), key, key_size);
+    if (entry == NULL) {
+        cache->misses++;
+        return NULL;
+    }
+    cache->hits++;
+    lru_cache_touch(cache, entry);
+    return entry;
+}
+
+const LruCacheEntry* lru_cache_peek(const LruCache* cache,
+                                    const void* key,
+                                    size_t key_size) {
+    if (cache == NULL) return NULL;
+    return lru_cache_lookup(cache, hash_map_hash_key(cache->map, key, key_size), key, key_size);
+}
+
+int lru_cache_remove(LruCache* cache,
+                     const void* key,
+                     size_t key_size) {
+    if (cache == NULL) return 0;
+
+    LruCacheEntry* entry = lru_cache_lookup(cache, hash_map_hash_key(cache->map, key, key_size), key, key_size);
+    if (entry == NULL) return 0;
+    lru_cache_drop(cache, entry);
+    return 1;
+}
+
+double lru_cache_hit_ratio(const LruCache* cache) {
+    if (cache == NULL || cache->hits + cache->misses == 0) return 0.0;
+    return (double)cache->hits / (double)(cache->hits + cache->misses);
+}
@@ -0,0 +1,138 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../hashmap/hashmap.h"
+
+#define FAILED_LRU_CACHE_ALLOCATION -83
+#define ATTEMPTED_ACCESS_TO_NULL_LRU_CACHE -82
+
+/*
+ * ============================================================================
+ *  LruCache — Contracts & Ownership
+ * ============================================================================
+ * - Structure: a HashMap from key to LruCacheEntry* (the map's data pointer)
+ *   plus an intrusive doubly-linked recency list threaded through the
+ *   entries, most recently used first. A hit unlinks the entry and pushes
+ *   it to the front; eviction pops the back. Both are O(1): no list walk.
+ *
+ * - Bounds: max_entries and/or max_bytes (0 = no limit on that dimension).
+ *   An entry is charged key_size + data_size bytes: its payload, which the
+ *   cache stores exactly once. On top of that each entry costs a fixed
+ *   LRU_CACHE_ENTRY_OVERHEAD bytes (entry header + map slot, more while the
+ *   map table is sparse), NOT charged: bound max_entries too when many tiny
+ *   entries must not outgrow memory. After every put, least recently used
+ *   entries are evicted until both bounds hold again; the entry just put is
+ *   never evicted by its own put (so one entry larger than max_bytes is kept,
+ *   alone, until the next put).
+ *
+ * - Recency: lru_cache_get() and lru_cache_put() mark the entry most recently
+ *   used; lru_cache_peek() does not (and does not count as a hit or miss).
+ *
+ * - Keys: ALWAYS deep-copied and owned by the cache, once. The map holds the
+ *   copy; entry->key points at it when it spilled to the heap (such copies
+ *   never move), and at the entry's own inline_key for keys of at most
+ *   HASH_MAP_INLINE_KEY_SIZE bytes (map slots move on growth).
+ *
+ * - Data: the deep_deallocate_hashmap_item_data callback given at build time
+ *   decides ownership, as for HashMap:
+ *     * non-NULL -> the cache owns 'data' and frees it with the callback when
+ *       the entry is evicted, removed, replaced by a put, or at destroy;
+ *     * NULL -> the cache never frees 'data'.
+ *
+ * - Entry pointers from lru_cache_get()/lru_cache_peek() stay valid until
+ *   that entry is evicted, removed or replaced (entries never move).
+ *
+ * - Counters: hits / misses (lru_cache_get only) and evictions accumulate
+ *   from build; lru_cache_hit_ratio() = hits / (hits + misses).
+ *
+ * - Thread-safety: NOT thread-safe (a hit writes the recency list).
+ * ============================================================================
+ */
+
+/* One cached key/value pair; lives on the heap until evicted or removed. */
+typedef struct LruCacheEntry {
+    struct LruCacheEntry* prev;  /* more recently used, or NULL at the front */
+    struct LruCacheEntry* next;  /* less recently used, or NULL at the back */
+    uint64_t hash;               /* hash of the key in the cache's map */
+    void*    data;               /* value pointer (ownership: see above) */
+    size_t   data_size;          /* value length in bytes */
+    const unsigned char* key;    /* key bytes: inline_key or the map's heap copy (see above) */
+    size_t   key_size;
+    unsigned char inline_key[HASH_MAP_INLINE_KEY_SIZE];
+} LruCacheEntry;
+
+/* Memory an entry costs beyond its charged key_size + data_size (one map slot at full load). */
+#define LRU_CACHE_ENTRY_OVERHEAD (sizeof(LruCacheEntry) + sizeof(HashMapItem) + 1)
+
+typedef struct LruCache {
+    HashMap*       map;          /* key -> LruCacheEntry* */
+    LruCacheEntry* front;        /* most recently used */
+    LruCacheEntry* back;         /* least recently used, next to evict */
+    size_t         size;         /* entries */
+    size_t         bytes;        /* sum of key_size + data_size over the entries */
+    size_t         max_entries;  /* 0 = unbounded */
+    size_t         max_bytes;    /* 0 = unbounded */
+    void (*deep_deallocate_hashmap_item_data)(void* node_data); /* NULL = data not owned */
+    size_t         hits;
+    size_t         misses;
+    size_t         evictions;
+} LruCache;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Build an empty cache bounded by 'max_entries' and 'max_bytes' (0 = no limit).
+ * 'deep_deallocate_hashmap_item_data' (may be NULL) frees owned values.
+ */
+LruCache* build_lru_cache(size_t max_entries,
+                          size_t max_bytes,
+                          void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/* Destroy the cache, every key copy and (if owned) every value. */
+void lru_cache_destroy(LruCache* cache);
+
+/*
+ * Insert or update (upsert) 'key' as the most recently used entry, then
+ * evict least recently used entries until the bounds hold.
+ * Returns: 1 if an existing key was updated (its old value is freed when
+ *          owned); 0 if a new key was inserted.
+ */
+int lru_cache_put(LruCache* cache,
+                  const void* key,
+                  size_t key_size,
+                  const void* data,
+                  size_t data_size);
+
+/*
+ * Lookup 'key' and mark it most recently used. Counts a hit or a miss.
+ * Returns: the entry, or NULL if not cached.
+ * IMPORTANT: do NOT modify or free the returned pointer.
+ */
+const LruCacheEntry* lru_cache_get(LruCache* cache,
+                                   const void* key,
+                                   size_t key_size);
+
+/* Lookup 'key' without touching recency or counters. Returns the entry or NULL. */
+const LruCacheEntry* lru_cache_peek(const LruCache* cache,
+                                    const void* key,
+                                    size_t key_size);
+
+/*
+ * Remove 'key' (not counted as an eviction; the value is freed when owned).
+ * Returns: 1 if removed; 0 if not cached.
+ */
+int lru_cache_remove(LruCache* cache,
+                     const void* key,
+                     size_t key_size);
+
+/* hits / (hits + misses); 0.0 before the first lru_cache_get(). */
+double lru_cache_hit_ratio(const LruCache* cache);
+
+#endif /* LRU_CACHE_H */
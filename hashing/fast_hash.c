@@ -0,0 +1,102 @@
+#include "fast_hash.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/* Odd 64-bit constants with balanced bits (the wyhash defaults; P0 also in fast_hash.h). */
+#define FAST_HASH_P1 0xe7037ed1a0b428dbULL
+#define FAST_HASH_P2 0x8ebc6af09c88c6e3ULL
+#define FAST_HASH_P3 0x589965cc75374cc3ULL
+
+/* Full 64x64 -> 128-bit product: *a = low half, *b = high half. */
+static inline void fast_hash_mul128(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 fast_hash_u128;
+    fast_hash_u128 r = (fast_hash_u128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/* Multiply and fold the 128-bit product back to 64 bits. */
+static inline uint64_t fast_hash_mix(uint64_t a, uint64_t b) {
+    fast_hash_mul128(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t fast_hash_read64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof v);
+    return v;
+}
+
+static inline uint64_t fast_hash_read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof v);
+    return v;
+}
+
+/* 1..3 bytes: first, middle and last byte (overlapping when len < 3). */
+static inline uint64_t fast_hash_read_small(const uint8_t* p, size_t len) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+}
+
+uint64_t fast_hash_64(const void* key, size_t len, uint64_t seed) {
+    const uint8_t* p = (const uint8_t*)key;
+    uint64_t a, b;
+
+    seed ^= fast_hash_mix(seed ^ FAST_HASH_P0, FAST_HASH_P1);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            /* two overlapping 4-byte reads from each end cover 4..16 bytes */
+            const size_t step = (len >> 3) << 2;
+            a = (fast_hash_read32(p) << 32) | fast_hash_read32(p + step);
+            b = (fast_hash_read32(p + len - 4) << 32) | fast_hash_read32(p + len - 4 - step);
+        } else if (len > 0) {
+            a = fast_hash_read_small(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t remaining = len;
+        if (remaining > 48) {
+            /* three independent lanes keep the multipliers busy on long keys */
+            uint64_t lane1 = seed, lane2 = seed;
+            do {
+                seed  = fast_hash_mix(fast_hash_read64(p)      ^ FAST_HASH_P1, fast_hash_read64(p + 8)  ^ seed);
+                lane1 = fast_hash_mix(fast_hash_read64(p + 16) ^ FAST_HASH_P2, fast_hash_read64(p + 24) ^ lane1);
+                lane2 = fast_hash_mix(fast_hash_read64(p + 32) ^ FAST_HASH_P3, fast_hash_read64(p + 40) ^ lane2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (remaining > 16) {
+            seed = fast_hash_mix(fast_hash_read64(p) ^ FAST_HASH_P1, fast_hash_read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        /* last 16 bytes of the key (may overlap the ones just consumed) */
+        a = fast_hash_read64(p + remaining - 16);
+        b = fast_hash_read64(p + remaining - 8);
+    }
+
+    a ^= FAST_HASH_P1;
+    b ^= seed;
+    fast_hash_mul128(&a, &b);
+    return fast_hash_mix(a ^ FAST_HASH_P0 ^ (uint64_t)len, b ^ FAST_HASH_P1);
+}
@@ -0,0 +1,40 @@
+#ifndef FAST_HASH_H
+#define FAST_HASH_H
+
+/*
+ * Fast 64-bit, seeded, non-cryptographic hashes.
+ *
+ * uint64_t fast_hash_64(key, len, seed):
+ *   - wyhash-style byte hash: keys are read 16 bytes per step (48 for long
+ *     keys) and folded with 64x64->128-bit multiplies; short keys (<= 16 bytes)
+ *     cost one read pair and two multiplies. Produces 64 bits directly.
+ *
+ * uint64_t fast_hash_u64(x, seed):
+ *   - mixer for a single 64-bit integer (e.g. 8-byte keys): seed xor, then a
+ *     multiply-xorshift finalizer. Every output bit depends on every input bit.
+ *
+ * Notes:
+ * - Not cryptographic. A secret, random seed makes colliding key sets hard to
+ *   precompute (HashDoS); it does not make them impossible to find.
+ * - Multi-byte reads use the host byte order: values differ between
+ *   little- and big-endian hosts.
+ */
+
+#include <stddef.h>  /* size_t */
+#include <stdint.h>  /* uint64_t */
+#include <string.h>  /* memcpy */
+
+uint64_t fast_hash_64(const void* key, size_t len, uint64_t seed);
+
+#define FAST_HASH_P0 0xa0761d6478bd642fULL
+
+/* Inline: it sits on the hot path of the integer-keyed maps. */
+static inline uint64_t fast_hash_u64(uint64_t x, uint64_t seed) {
+    x ^= seed ^ FAST_HASH_P0;
+    x ^= x >> 32; x *= 0xd6e8feb86659fd93ULL;
+    x ^= x >> 32; x *= 0xd6e8feb86659fd93ULL;
+    x ^= x >> 32;
+    return x;
+}
+
+#endif /* FAST_HASH_H */
@@ -0,0 +1,228 @@
+#include "concurrent_hashmap.h"
+
+/*
+ * ============================================================================
+ *  ConcurrentHashMap — Lock striping over independent HashMaps
+ * ============================================================================
+ * Every operation:
+ *   1) hashes the key once to pick the segment,
+ *   2) takes that segment's rwlock (read for gets, write for put/remove),
+ *   3) delegates to the pre-hashed HashMap API (no second hash),
+ *   4) releases the lock.
+ * No operation ever holds two segment locks, so there is no lock ordering
+ * to respect and no deadlock is possible.
+ * ============================================================================
+ */
+
+/* Lock helpers: a failing pthread call means a corrupted lock → abort like the rest of the lib. */
+static void concurrent_hash_map_read_lock(ConcurrentHashMapSegment* segment) {
+    if (pthread_rwlock_rdlock(&segment->lock) != 0) {
+        fprintf(stderr, "ConcurrentHashMap: failed to acquire segment read lock\n");
+        exit(FAILED_CONCURRENT_HASH_MAP_LOCK);
+    }
+}
+
+static void concurrent_hash_map_write_lock(ConcurrentHashMapSegment* segment) {
+    if (pthread_rwlock_wrlock(&segment->lock) != 0) {
+        fprintf(stderr, "ConcurrentHashMap: failed to acquire segment write lock\n");
+        exit(FAILED_CONCURRENT_HASH_MAP_LOCK);
+    }
+}
+
+static void concurrent_hash_map_unlock(ConcurrentHashMapSegment* segment) {
+    if (pthread_rwlock_unlock(&segment->lock) != 0) {
+        fprintf(stderr, "ConcurrentHashMap: failed to release segment lock\n");
+        exit(FAILED_CONCURRENT_HASH_MAP_LOCK);
+    }
+}
+
+/* Index of the segment owning hash 'h64' (bits right below the fingerprint bits). */
+static inline size_t concurrent_hash_map_index_of(const ConcurrentHashMap* map, uint64_t h64) {
+    return (size_t)(h64 >> map->segment_shift) & (map->segment_count - 1);
+}
+
+static ConcurrentHashMapSegment* concurrent_hash_map_segment_of(const ConcurrentHashMap* map, uint64_t h64) {
+    return &map->segments[concurrent_hash_map_index_of(map, h64)];
+}
+
+ConcurrentHashMap* build_concurrent_hash_map(size_t segment_count) {
+    return build_concurrent_hash_map_with_allocators(segment_count, NULL, NULL);
+}
+
+/*
+ * Builds the map: rounds segment_count up to a power of two and builds one
+ * HashMap (with the factory's allocator, if any) + rwlock per segment.
+ */
+ConcurrentHashMap* build_concurrent_hash_map_with_allocators(size_t segment_count,
+                                                             ConcurrentHashMapAllocatorFactory factory,
+                                                             void* ctx) {
+    if (segment_count == 0) segment_count = CONCURRENT_HASH_MAP_DEFAULT_SEGMENTS;
+    if (segment_count > CONCURRENT_HASH_MAP_MAX_SEGMENTS) segment_count = CONCURRENT_HASH_MAP_MAX_SEGMENTS;
+
+    size_t count = 1;
+    unsigned bits = 0;
+    while (count < segment_count) {
+        count <<= 1;
+        bits++;
+    }
+
+    ConcurrentHashMap* map = malloc(sizeof(ConcurrentHashMap));
+    if (map == NULL) {
+        fprintf(stderr, "Failed malloc while trying to build a new concurrent hash map\n");
+        exit(FAILED_CONCURRENT_HASH_MAP_ALLOCATION);
+    }
+
+    map->segments = malloc(count * sizeof(ConcurrentHashMapSegment));
+    if (map->segments == NULL) {
+        fprintf(stderr, "Failed malloc while trying to allocate concurrent hash map segments\n");
+        free(map);
+        exit(FAILED_CONCURRENT_HASH_MAP_ALLOCATION);
+    }
+
+    map->segment_count = count;
+    /* top 7 bits feed the fingerprint: take the 'bits' just below them */
+    map->segment_shift = 57u - bits;
+
+    for (size_t i = 0; i < count; i++) {
+        if (pthread_rwlock_init(&map->segments[i].lock, NULL) != 0) {
+            fprintf(stderr, "ConcurrentHashMap: failed to initialize segment lock\n");
+            exit(FAILED_CONCURRENT_HASH_MAP_LOCK);
+        }
+        HashMapAllocator allocator = { NULL, NULL, NULL };
+        if (factory != NULL) factory(i, count, &allocator, ctx);
+        map->segments[i].map = build_hash_map_with_allocator(&allocator);
+    }
+
+    return map;
+}
+
+/*
+ * Destroys every segment (items + optional data via callback) and the map.
+ * The caller guarantees no other thread is using the map.
+ */
+void concurrent_hash_map_destroy(ConcurrentHashMap* map,
+                                 void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You tried to destroy a NULL concurrent hash map, this is a no-op\n");
+        return;
+    }
+
+    for (size_t i = 0; i < map->segment_count; i++) {
+        hash_map_destroy(map->segments[i].map, deep_deallocate_hashmap_item_data);
+        pthread_rwlock_destroy(&map->segments[i].lock);
+    }
+
+    free(map->segments);
+    free(map);
+}
+
+/* Upsert under the owning segment's write lock (see hash_map_put for semantics). */
+int concurrent_hash_map_put(ConcurrentHashMap* map,
+                            const void* key,
+                            size_t key_size,
+                            const void* data,
+                            size_t data_size,
+                            void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You are trying to put data in a NULL concurrent hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    uint64_t h64 = generate_hash(key, key_size);
+    ConcurrentHashMapSegment* segment = concurrent_hash_map_segment_of(map, h64);
+
+    concurrent_hash_map_write_lock(segment);
+    int updated = hash_map_put_prehashed(segment->map, h64, key, key_size, data, data_size,
+                                         deep_deallocate_hashmap_item_data);
+    concurrent_hash_map_unlock(segment);
+
+    return updated;
+}
+
+/* Remove under the owning segment's write lock (see hash_map_remove for semantics). */
+int concurrent_hash_map_remove(ConcurrentHashMap* map,
+                               const void* key,
+                               size_t key_size,
+                               void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "concurrent_hash_map_remove called on a NULL concurrent hash map\n");
+        return 0;
+    }
+
+    uint64_t h64 = generate_hash(key, key_size);
+    ConcurrentHashMapSegment* segment = concurrent_hash_map_segment_of(map, h64);
+
+    concurrent_hash_map_write_lock(segment);
+    int removed = hash_map_remove_prehashed(segment->map, h64, key, key_size,
+                                            deep_deallocate_hashmap_item_data);
+    concurrent_hash_map_unlock(segment);
+
+    return removed;
+}
+
+/*
+ * Lookup under the owning segment's read lock; copies out the data pointer/size.
+ * The HashMapItem itself is never exposed: it may move as soon as the lock drops.
+ */
+int concurrent_hash_map_get(ConcurrentHashMap* map,
+                            const void* key,
+                            size_t key_size,
+                            void** out_data,
+                            size_t* out_data_size) {
+    if (map == NULL) return 0;
+
+    uint64_t h64 = generate_hash(key, key_size);
+    ConcurrentHashMapSegment* segment = concurrent_hash_map_segment_of(map, h64);
+
+    concurrent_hash_map_read_lock(segment);
+    const HashMapItem* item = hash_map_get_prehashed(segment->map, h64, key, key_size);
+    if (item != NULL) {
+        if (out_data != NULL) *out_data = item->data;
+        if (out_data_size != NULL) *out_data_size = item->data_size;
+    }
+    concurrent_hash_map_unlock(segment);
+
+    return item != NULL ? 1 : 0;
+}
+
+/* Lookup and visit the item while the owning segment's read lock is held. */
+int concurrent_hash_map_get_with(ConcurrentHashMap* map,
+                                 const void* key,
+                                 size_t key_size,
+                                 void (*visit)(const HashMapItem* item, void* ctx),
+                                 void* ctx) {
+    if (map == NULL || visit == NULL) return 0;
+
+    uint64_t h64 = generate_hash(key, key_size);
+    ConcurrentHashMapSegment* segment = concurrent_hash_map_segment_of(map, h64);
+
+    concurrent_hash_map_read_lock(segment);
+    const HashMapItem* item = hash_map_get_prehashed(segment->map, h64, key, key_size);
+    if (item != NULL) {
+        visit(item, ctx);
+    }
+    concurrent_hash_map_unlock(segment);
+
+    return item != NULL ? 1 : 0;
+}
+
+/*
+ * Sum of segment sizes. Each segment is read under its own lock, so the
+ * result is exact only when no writer runs concurrently.
+ */
+size_t concurrent_hash_map_size(ConcurrentHashMap* map) {
+    if (map == NULL) return 0;
+
+    size_t total = 0;
+    for (size_t i = 0; i < map->segment_count; i++) {
+        concurrent_hash_map_read_lock(&map->segments[i]);
+        total += map->segments[i].map->size;
+        concurrent_hash_map_unlock(&map->segments[i]);
+    }
+    return total;
+}
+
+size_t concurrent_hash_map_segment_index(const ConcurrentHashMap* map, const void* key, size_t key_size) {
+    if (map == NULL) return 0;
+    return concurrent_hash_map_index_of(map, generate_hash(key, key_size));
+}
@@ -0,0 +1,145 @@
+#ifndef CONCURRENT_HASHMAP_H
+#define CONCURRENT_HASHMAP_H
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  /* pthread_rwlock_t under -std=c11 */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "hashmap.h"
+
+#define CONCURRENT_HASH_MAP_DEFAULT_SEGMENTS 64   /* used when 0 segments are requested */
+#define CONCURRENT_HASH_MAP_MAX_SEGMENTS     4096
+#define CONCURRENT_HASH_MAP_CACHE_LINE       64   /* padding between segment locks */
+#define FAILED_CONCURRENT_HASH_MAP_ALLOCATION -91
+#define FAILED_CONCURRENT_HASH_MAP_LOCK       -90
+
+/*
+ * ============================================================================
+ *  ConcurrentHashMap — Contracts & Ownership
+ * ============================================================================
+ * - Striping: the map is split into a power-of-two number of segments, each
+ *   an independent HashMap guarded by its own pthread reader/writer lock.
+ *   A key always lives in the segment picked by a few bits of its hash, so
+ *   threads touching different segments never contend. Lookups take the
+ *   read side: any number of concurrent gets on a segment proceed together
+ *   (hash_map_get never moves entries).
+ *
+ * - Segment selection uses the hash bits right below the 7-bit fingerprint
+ *   (see HASH_MAP_H2), which the per-segment tables do not use for slot
+ *   selection at any realistic capacity.
+ *
+ * - Table memory: build_concurrent_hash_map_with_allocators() lets a caller
+ *   give each segment's HashMap its own HashMapAllocator (e.g. pages homed on
+ *   a NUMA node, see ShardedHashMap). Hooks run under the segment's write
+ *   lock, or at build/destroy.
+ *
+ * - Ownership: same rules as HashMap.
+ *     * Keys are ALWAYS deep-copied and owned by the map.
+ *     * Data is owned by the map only when a deallocator callback is passed.
+ *
+ * - Values and concurrency: concurrent_hash_map_get() hands back the stored
+ *   data pointer after the lock is released. If the map OWNS values and
+ *   another thread may remove/overwrite the same key meanwhile, that pointer
+ *   can be freed under your feet: use concurrent_hash_map_get_with(), whose
+ *   callback runs while the segment's read lock is held.
+ *
+ * - Thread-safety: all functions are thread-safe, except build/destroy,
+ *   which must not race with any other call on the same map.
+ * ============================================================================
+ */
+
+/* One stripe: a lock, the HashMap it guards and padding against false sharing. */
+typedef struct ConcurrentHashMapSegment {
+    pthread_rwlock_t lock;
+    HashMap*         map;
+    char             pad[CONCURRENT_HASH_MAP_CACHE_LINE];
+} ConcurrentHashMapSegment;
+
+typedef struct ConcurrentHashMap {
+    ConcurrentHashMapSegment* segments;
+    size_t                    segment_count; /* power of two */
+    unsigned                  segment_shift; /* hash >> shift, masked, picks the segment */
+} ConcurrentHashMap;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Per-segment allocator factory: fills *allocator for segment 'segment' of
+ * 'segment_count' (leave it zeroed for malloc/free; its ctx must outlive the
+ * map). Called for segments 0, 1, ... in order, during the build.
+ */
+typedef void (*ConcurrentHashMapAllocatorFactory)(size_t segment, size_t segment_count,
+                                                  HashMapAllocator* allocator, void* ctx);
+
+/*
+ * Build a map with 'segment_count' lock stripes (rounded up to a power of two,
+ * clamped to CONCURRENT_HASH_MAP_MAX_SEGMENTS; 0 → CONCURRENT_HASH_MAP_DEFAULT_SEGMENTS).
+ * A few times the number of worker threads is a good choice.
+ */
+ConcurrentHashMap* build_concurrent_hash_map(size_t segment_count);
+
+/* Same, building segment i's HashMap with the allocator 'factory' gives for it (NULL = malloc/free). */
+ConcurrentHashMap* build_concurrent_hash_map_with_allocators(size_t segment_count,
+                                                             ConcurrentHashMapAllocatorFactory factory,
+                                                             void* ctx);
+
+/* Destroy the map; optionally deep-free each item's data via callback. Not thread-safe. */
+void concurrent_hash_map_destroy(ConcurrentHashMap* map,
+                                 void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Insert or update (upsert) an entry under the segment's write lock.
+ * Returns: 1 if updated an existing key; 0 if inserted a new key.
+ */
+int concurrent_hash_map_put(ConcurrentHashMap* map,
+                            const void* key,
+                            size_t key_size,
+                            const void* data,
+                            size_t data_size,
+                            void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Remove an entry under the segment's write lock.
+ * Returns: 1 if a matching entry was removed; 0 if not found.
+ */
+int concurrent_hash_map_remove(ConcurrentHashMap* map,
+                               const void* key,
+                               size_t key_size,
+                               void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Lookup under the segment's read lock.
+ * Returns: 1 if found (and fills *out_data / *out_data_size when non-NULL); 0 otherwise.
+ * See the header notes about owned values removed concurrently.
+ */
+int concurrent_hash_map_get(ConcurrentHashMap* map,
+                            const void* key,
+                            size_t key_size,
+                            void** out_data,
+                            size_t* out_data_size);
+
+/*
+ * Lookup and run 'visit' on the stored item while the segment's read lock is held.
+ * 'visit' must not modify the item nor call back into the same map.
+ * Returns: 1 if found (visit was called); 0 otherwise.
+ */
+int concurrent_hash_map_get_with(ConcurrentHashMap* map,
+                                 const void* key,
+                                 size_t key_size,
+                                 void (*visit)(const HashMapItem* item, void* ctx),
+                                 void* ctx);
+
+/* Number of live entries (sum over segments, each read under its lock). */
+size_t concurrent_hash_map_size(ConcurrentHashMap* map);
+
+/* Index of the segment owning 'key' (a pure function of its hash), for routing layers. */
+size_t concurrent_hash_map_segment_index(const ConcurrentHashMap* map, const void* key, size_t key_size);
+
+#endif /* CONCURRENT_HASHMAP_H */
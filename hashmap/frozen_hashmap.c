@@ -0,0 +1,241 @@
+#include "frozen_hashmap.h"
+
+/* ------------------------------------------------------------------------- */
+/*                              Internal helpers                             */
+/* ------------------------------------------------------------------------- */
+
+/* 64-bit finalizer (splitmix64): spreads a hash perturbed by a displacement. */
+static inline uint64_t frozen_hash_map_mix(uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27; x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/* Maps a 32-bit value onto [0, n) with a multiply instead of a division (n < 2^32). */
+static inline size_t frozen_hash_map_reduce(uint32_t x, size_t n) {
+    return (size_t)(((uint64_t)x * (uint64_t)n) >> 32);
+}
+
+/* Bucket of a hash: the high half, so slot selection (mixed low half) stays independent. */
+static inline size_t frozen_hash_map_bucket(uint64_t h64, size_t bucket_count) {
+    return frozen_hash_map_reduce((uint32_t)(h64 >> 32), bucket_count);
+}
+
+static inline size_t frozen_hash_map_slot(uint64_t h64, int32_t displacement, size_t size) {
+    uint64_t mixed = frozen_hash_map_mix(h64 ^ ((uint64_t)displacement * 0x9E3779B97F4A7C15ULL));
+    return frozen_hash_map_reduce((uint32_t)mixed, size);
+}
+
+static void* frozen_hash_map_alloc(size_t count, size_t elem_size) {
+    void* p = calloc(count ? count : 1, elem_size);
+    if (p == NULL) {
+        fprintf(stderr, "Failed calloc while trying to freeze a hash map\n");
+        exit(FAILED_FROZEN_HASH_MAP_ALLOCATION);
+    }
+    return p;
+}
+
+/*
+ * Finds a displacement placing every key of one bucket on a free slot, with
+ * no two keys of the bucket on the same slot. 'slots' receives the positions.
+ * Returns the displacement, or 0 if none was found within the search limit.
+ */
+static int32_t frozen_hash_map_displace(const HashMapItem* const* items, size_t count,
+                                        const unsigned char* taken, size_t size, size_t* slots) {
+    for (int32_t d = 1; d <= FROZEN_HASH_MAP_MAX_DISPLACEMENT; d++) {
+        size_t k = 0;
+        for (; k < count; k++) {
+            size_t slot = frozen_hash_map_slot(items[k]->hash, d, size);
+            if (taken[slot]) break;
+
+            size_t j = 0;
+            while (j < k && slots[j] != slot) j++;
+            if (j < k) break;  /* collides with a key of the same bucket */
+
+            slots[k] = slot;
+        }
+        if (k == count) return d;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                   Build                                   */
+/* ------------------------------------------------------------------------- */
+
+FrozenHashMap* hash_map_freeze(const HashMap* hash_map) {
+    if (hash_map == NULL) {
+        fprintf(stderr, "hash_map_freeze called on a NULL hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+    if (hash_map->size > INT32_MAX) {
+        fprintf(stderr, "hash_map_freeze: too many entries (%zu)\n", hash_map->size);
+        return NULL;
+    }
+
+    const size_t n = hash_map->size;
+    const size_t bucket_count = n / FROZEN_HASH_MAP_KEYS_PER_BUCKET + 1;
+
+    /* 1) group the items by bucket (counting sort, no per-bucket allocation) */
+    size_t* bucket_start = frozen_hash_map_alloc(bucket_count + 1, sizeof(size_t));
+    const HashMapItem** grouped = frozen_hash_map_alloc(n, sizeof(HashMapItem*));
+    size_t key_blob_size = 0;
+
+    HashMapIterator it;
+    hash_map_iterator_init(&it, hash_map);
+    for (const HashMapItem* item = hash_map_iterator_next(&it); item != NULL; item = hash_map_iterator_next(&it)) {
+        bucket_start[frozen_hash_map_bucket(item->hash, bucket_count) + 1]++;
+        if (item->key_size > FROZEN_HASH_MAP_INLINE_KEY_SIZE) key_blob_size += item->key_size;
+    }
+    for (size_t b = 0; b < bucket_count; b++) bucket_start[b + 1] += bucket_start[b];
+
+    size_t* fill = frozen_hash_map_alloc(bucket_count, sizeof(size_t));
+    hash_map_iterator_init(&it, hash_map);
+    for (const HashMapItem* item = hash_map_iterator_next(&it); item != NULL; item = hash_map_iterator_next(&it)) {
+        size_t b = frozen_hash_map_bucket(item->hash, bucket_count);
+        grouped[bucket_start[b] + fill[b]++] = item;
+    }
+
+    /* 2) order buckets by decreasing size (counting sort on size) */
+    size_t max_bucket = 0;
+    for (size_t b = 0; b < bucket_count; b++) {
+        size_t s = bucket_start[b + 1] - bucket_start[b];
+        if (s > max_bucket) max_bucket = s;
+    }
+    size_t* by_size_start = frozen_hash_map_alloc(max_bucket + 2, sizeof(size_t));
+    size_t* order = frozen_hash_map_alloc(bucket_count, sizeof(size_t));
+    for (size_t b = 0; b < bucket_count; b++) {
+        by_size_start[max_bucket - (bucket_start[b + 1] - bucket_start[b]) + 1]++;
+    }
+    for (size_t s = 0; s <= max_bucket; s++) by_size_start[s + 1] += by_size_start[s];
+    for (size_t b = 0; b < bucket_count; b++) {
+        size_t rank = max_bucket - (bucket_start[b + 1] - bucket_start[b]);
+        order[by_size_start[rank]++] = b;
+    }
+
+    /* 3) place buckets: multi-key ones by displacement, then singletons on free slots */
+    FrozenHashMap* map = frozen_hash_map_alloc(1, sizeof(FrozenHashMap));
+    map->size          = n;
+    map->bucket_count  = bucket_count;
+    map->displacements = frozen_hash_map_alloc(bucket_count, sizeof(int32_t));
+    map->entries       = frozen_hash_map_alloc(n, sizeof(FrozenHashMapEntry));
+    map->key_blob      = frozen_hash_map_alloc(key_blob_size, 1);
+    map->key_blob_size = key_blob_size;
+    map->hash_kind     = hash_map->hash_kind;
+    map->hash_seed     = hash_map->hash_seed;
+
+    unsigned char* taken = frozen_hash_map_alloc(n, 1);
+    const HashMapItem** placed = frozen_hash_map_alloc(n, sizeof(HashMapItem*));
+    size_t* slots = frozen_hash_map_alloc(max_bucket, sizeof(size_t));
+    size_t next_free = 0;
+    int ok = 1;
+
+    for (size_t o = 0; o < bucket_count && ok; o++) {
+        size_t b = order[o];
+        size_t count = bucket_start[b + 1] - bucket_start[b];
+        const HashMapItem** items = &grouped[bucket_start[b]];
+
+        if (count == 0) break;  /* sorted by size: only empty buckets remain */
+
+        if (count == 1) {
+            while (taken[next_free]) next_free++;
+            slots[0] = next_free;
+            map->displacements[b] = -(int32_t)next_free - 1;
+        } else {
+            int32_t d = frozen_hash_map_displace(items, count, taken, n, slots);
+            if (d == 0) {
+                ok = 0;
+                break;
+            }
+            map->displacements[b] = d;
+        }
+
+        for (size_t k = 0; k < count; k++) {
+            taken[slots[k]] = 1;
+            placed[slots[k]] = items[k];
+        }
+    }
+
+    /* 4) copy entries in slot order: small keys inline, longer ones packed into the blob */
+    if (ok) {
+        size_t blob_pos = 0;
+        for (size_t s = 0; s < n; s++) {
+            const HashMapItem* item = placed[s];
+            FrozenHashMapEntry* e = &map->entries[s];
+            if (item->key_size <= FROZEN_HASH_MAP_INLINE_KEY_SIZE) {
+                e->key = e->inline_key;
+            } else {
+                e->key = map->key_blob + blob_pos;
+                blob_pos += item->key_size;
+            }
+            if (item->key_size != 0) memcpy((void*)e->key, item->key, item->key_size);
+            e->hash      = item->hash;
+            e->key_size  = item->key_size;
+            e->data      = item->data;
+            e->data_size = item->data_size;
+        }
+    } else {
+        fprintf(stderr, "hash_map_freeze: no perfect hash found (keys with identical 64-bit hashes?)\n");
+        frozen_hash_map_destroy(map, NULL);
+        map = NULL;
+    }
+
+    free(bucket_start);
+    free(grouped);
+    free(fill);
+    free(by_size_start);
+    free(order);
+    free(taken);
+    free(placed);
+    free(slots);
+    return map;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               Public API                                  */
+/* ------------------------------------------------------------------------- */
+
+void frozen_hash_map_destroy(FrozenHashMap* map,
+                             void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You tried to destroy a NULL frozen hash map, this is a no-op\n");
+        return;
+    }
+
+    if (deep_deallocate_hashmap_item_data != NULL) {
+        for (size_t i = 0; i < map->size; i++) {
+            if (map->entries[i].data != NULL) deep_deallocate_hashmap_item_data(map->entries[i].data);
+        }
+    }
+
+    free(map->displacements);
+    free(map->entries);
+    free(map->key_blob);
+    free(map);
+}
+
+const FrozenHashMapEntry* frozen_hash_map_get(const FrozenHashMap* map,
+                                              const void* key,
+                                              size_t key_size) {
+    if (map == NULL || map->size == 0) return NULL;
+
+    uint64_t h64 = hash_map_hash_bytes(map->hash_kind, map->hash_seed, key, key_size);
+    int32_t d = map->displacements[frozen_hash_map_bucket(h64, map->bucket_count)];
+    if (d == 0) return NULL;  /* empty bucket: no key hashes here */
+
+    size_t slot = d < 0 ? (size_t)(-(int64_t)d - 1) : frozen_hash_map_slot(h64, d, map->size);
+    const FrozenHashMapEntry* e = &map->entries[slot];
+
+    if (e->hash != h64 || e->key_size != key_size) return NULL;
+    if (key_size != 0 && memcmp(e->key, key, key_size) != 0) return NULL;
+    return e;
+}
+
+size_t frozen_hash_map_memory_bytes(const FrozenHashMap* map) {
+    if (map == NULL) return 0;
+    return sizeof(FrozenHashMap)
+         + map->bucket_count * sizeof(int32_t)
+         + map->size * sizeof(FrozenHashMapEntry)
+         + map->key_blob_size;
+}
@@ -0,0 +1,93 @@
+#ifndef FROZEN_HASHMAP_H
+#define FROZEN_HASHMAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "hashmap.h"
+
+#define FROZEN_HASH_MAP_KEYS_PER_BUCKET 2          /* average keys per displacement bucket */
+#define FROZEN_HASH_MAP_MAX_DISPLACEMENT (1 << 24)  /* seeds tried per bucket before giving up */
+#define FROZEN_HASH_MAP_INLINE_KEY_SIZE 8           /* keys up to this many bytes live inside the entry */
+#define FAILED_FROZEN_HASH_MAP_ALLOCATION -84
+
+/*
+ * ============================================================================
+ *  FrozenHashMap — read-only map over a minimal perfect hash
+ * ============================================================================
+ * hash_map_freeze() takes a populated HashMap and lays its n entries out in
+ * an array of exactly n slots, indexed by a minimal perfect hash built with
+ * hash-and-displace (CHD style):
+ *   - every key's 64-bit hash picks one of ~n/2 buckets;
+ *   - buckets are placed largest first: for each, a displacement d >= 1 is
+ *     searched so that slot = mix(hash, d) mod n is free and distinct for all
+ *     its keys; single-key buckets then take the remaining free slots
+ *     directly (stored as -(slot + 1)).
+ * A lookup is: hash, read one displacement, compute one slot, compare one
+ * key. There is no probing and no empty slot. Keys are hashed with the
+ * source map's hash function and seed (hash_map_hash_key).
+ *
+ * Memory: one FrozenHashMapEntry per key, one int32 per bucket (~2 bytes per
+ * key) and the bytes of longer keys packed back to back; no load-factor
+ * slack and no control bytes. Keys of at most FROZEN_HASH_MAP_INLINE_KEY_SIZE
+ * bytes sit inside the entry, so their lookups touch no third cache line.
+ *
+ * Ownership:
+ * - Keys: copied into the entry or the frozen map's own key blob (the source map is untouched).
+ * - Data: pointers are SHARED with the source map. Decide which of the two
+ *   frees them: typically destroy the source with a NULL callback and the
+ *   frozen map with the real deallocator (or the other way around).
+ *
+ * - Thread-safety: a built FrozenHashMap is immutable; concurrent lookups are safe.
+ * ============================================================================
+ */
+
+typedef struct FrozenHashMapEntry {
+    uint64_t    hash;      /* the source map's hash of the key */
+    const void* key;       /* inline_key or into the map's key blob */
+    size_t      key_size;
+    void*       data;      /* shared with the source map (see ownership) */
+    size_t      data_size;
+    unsigned char inline_key[FROZEN_HASH_MAP_INLINE_KEY_SIZE];
+} FrozenHashMapEntry;
+
+typedef struct FrozenHashMap {
+    size_t              size;          /* number of entries == number of slots */
+    size_t              bucket_count;
+    int32_t*            displacements; /* per bucket: d >= 1 (mixed), -(slot + 1) (direct), 0 (empty bucket) */
+    FrozenHashMapEntry* entries;       /* exactly 'size' slots */
+    unsigned char*      key_blob;      /* keys longer than FROZEN_HASH_MAP_INLINE_KEY_SIZE, back to back */
+    size_t              key_blob_size;
+    int                 hash_kind;     /* hash function and seed copied from the source map */
+    uint64_t            hash_seed;
+} FrozenHashMap;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Build a frozen copy of 'hash_map' (both tables, if a migration is pending).
+ * Returns: the frozen map, or NULL if no perfect hash was found (only possible
+ *          when distinct keys share the same 64-bit hash).
+ */
+FrozenHashMap* hash_map_freeze(const HashMap* hash_map);
+
+/* Destroy the frozen map; optionally deep-free each entry's data via callback. */
+void frozen_hash_map_destroy(FrozenHashMap* map,
+                             void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Single-probe lookup.
+ * Returns: a const pointer to the entry (valid until destroy), or NULL if not found.
+ */
+const FrozenHashMapEntry* frozen_hash_map_get(const FrozenHashMap* map,
+                                              const void* key,
+                                              size_t key_size);
+
+/* Bytes owned by the frozen map (struct, entries, displacements and key blob). */
+size_t frozen_hash_map_memory_bytes(const FrozenHashMap* map);
+
+#endif /* FROZEN_HASHMAP_H */
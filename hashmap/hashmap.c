@@ -1,14 +1,49 @@
 #include "hashmap.h"
+#include "hashmap_ctrl.h"
+#include <time.h>       /* timespec_get, clock (hash_map_random_seed) */
+#include <stdatomic.h>
+
+/* Software prefetch for the batch APIs (a no-op where the compiler offers none) */
+#if defined(__GNUC__) || defined(__clang__)
+#define HASH_MAP_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#elif HASH_MAP_USE_SSE2
+#define HASH_MAP_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
+#else
+#define HASH_MAP_PREFETCH(addr) ((void)(addr))
+#endif
 
 /*
  * ============================================================================
  *  HashMap — Contracts & Ownership
  * ============================================================================
- * - Buckets: array of LinkedList with a sentinel head. A bucket is a logically
- *   empty list when head->data == NULL && head->next == NULL.
+ * - Table: open addressing over 'capacity' slots (always a power of two)
+ *   plus one control byte per slot. A control byte is EMPTY, DELETED
+ *   (tombstone) or, for a FULL slot, a 7-bit fingerprint of the hash
+ *   (HASH_MAP_H2). Probing reads HASH_MAP_GROUP_WIDTH control bytes at once,
+ *   starting at (hash & (capacity - 1)) and jumping by growing multiples of
+ *   the group width (triangular probing over groups):
+ *     * candidate slots are the ones whose byte equals the fingerprint, so
+ *       ~127/128 of non-matching entries are rejected without touching the
+ *       HashMapItem or its key;
+ *     * a group holding an EMPTY byte terminates the probe sequence.
+ *   With SSE2 a group is one 128-bit compare + movemask; elsewhere the same
+ *   masks are computed 8 bytes at a time (SWAR). Defining HASH_MAP_NO_SIMD
+ *   forces the portable path.
+ *   The first HASH_MAP_GROUP_WIDTH control bytes are mirrored after the end
+ *   of the array so a group starting near the end can be loaded in one go.
+ *
+ * - Growth: FULL + DELETED slots are kept at or below 7/8 of the capacity.
+ *   Crossing that threshold triggers a full rehash into a table twice as big
+ *   (or of the same size when tombstones, not live items, are the problem).
  *
  * - Key ownership: the key is ALWAYS deep-copied in hash_map_put() and will
- *   ALWAYS be freed by the map (see hash_map_free_item_with()).
+ *   ALWAYS be freed by the map (see hash_map_free_item_with()). Keys up to
+ *   HASH_MAP_INLINE_KEY_SIZE bytes are copied into the slot itself, so a
+ *   small-key insert costs no allocation at all; longer keys get a heap copy
+ *   (from the map's key arena, when built with build_arena_hash_map()).
+ *
+ * - Item pointers: items are stored inline in 'slots', so a rehash moves them.
+ *   Pointers returned by hash_map_get() die at the next put/remove.
  *
  * - Data ownership:
  *     * if deep_deallocate_hashmap_item_data != NULL → ownership of data
@@ -39,36 +74,367 @@ uint64_t generate_hash(const void* key, size_t key_size) {
     return h64;
 }
 
+uint64_t hash_map_hash_bytes(int hash_kind, uint64_t seed, const void* key, size_t key_size) {
+    switch (hash_kind) {
+    case HASH_MAP_HASH_FAST64:
+        return fast_hash_64(key, key_size, seed);
+    case HASH_MAP_HASH_INT64:
+        if (key_size == sizeof(uint64_t)) {
+            uint64_t x;
+            memcpy(&x, key, sizeof x);
+            return fast_hash_u64(x, seed);
+        }
+        return fast_hash_64(key, key_size, seed);
+    default: {
+        if (key_size > INT_MAX) {
+            fprintf(stderr, "You are trying to hash a hash map key that is too long\n");
+            exit(TOO_LONG_HASHMAP_KEY);
+        }
+        uint64_t hash_buffer[2];
+        MurmurHash3_x64_128(key, (int)key_size, (uint32_t)seed, hash_buffer);
+        return hash_buffer[0];
+    }
+    }
+}
+
+uint64_t hash_map_hash_key(const HashMap* hash_map, const void* key, size_t key_size) {
+    return hash_map_hash_bytes(hash_map->hash_kind, hash_map->hash_seed, key, key_size);
+}
+
 /*
- * Deep-free routine for a LinkedList payload that is a HashMapItem* (i.e., node->data).
- *
- * Compatible with linked_list_remove_hashmap_node_with(...), which passes:
- *   - data as the HashMapItem*,
- *   - deep_deallocate_hashmap_item_data as the optional deallocator for item->data.
- *
- * Frees, in order:
- *   1) item->key            (always heap-allocated by the map),
- *   2) item->data           (ONLY if a data-deallocator is provided),
- *   3) the item struct itself.
+ * Seed from the wall clock, the CPU clock, an address (ASLR) and a call
+ * counter, run through the integer mixer so nearby inputs spread out.
  */
-static void hash_map_free_item_with(void* data,
+uint64_t hash_map_random_seed(void) {
+    static _Atomic uint64_t calls = 0;
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    uint64_t entropy = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    entropy ^= fast_hash_u64((uint64_t)clock(), (uint64_t)(uintptr_t)&calls);
+    return fast_hash_u64(entropy, atomic_fetch_add(&calls, 1) + 1);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                         Key arena (spilled keys)                          */
+/* ------------------------------------------------------------------------- */
+
+#define HASH_MAP_ARENA_ALIGN 16
+#define HASH_MAP_ARENA_HEADER_SIZE \
+    ((sizeof(HashMapArenaChunk) + HASH_MAP_ARENA_ALIGN - 1) & ~(size_t)(HASH_MAP_ARENA_ALIGN - 1))
+
+/*
+ * Size class of a spilled key: 16-byte steps for 17..256 bytes (classes 0..14),
+ * then one class per power of two (512 -> 15, 1024 -> 16, ...).
+ */
+static inline size_t hash_map_arena_class(size_t size) {
+    if (size <= 256) return (size + HASH_MAP_ARENA_ALIGN - 1) / HASH_MAP_ARENA_ALIGN - 2;
+
+    size_t cls = 15;
+    size_t block = 512;
+    while (block < size) {
+        block <<= 1;
+        cls++;
+    }
+    return cls;
+}
+
+static inline size_t hash_map_arena_class_size(size_t cls) {
+    return cls < 15 ? (cls + 2) * HASH_MAP_ARENA_ALIGN : (size_t)512 << (cls - 15);
+}
+
+static HashMapArenaChunk* hash_map_arena_new_chunk(HashMapKeyArena* arena, size_t size) {
+    HashMapArenaChunk* chunk = malloc(HASH_MAP_ARENA_HEADER_SIZE + size);
+    if (chunk == NULL) {
+        fprintf(stderr, "Failed malloc while growing a hash map key arena\n");
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+    chunk->size = size;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->reserved_bytes += HASH_MAP_ARENA_HEADER_SIZE + size;
+    return chunk;
+}
+
+/* A block of at least 'size' bytes: recycled if possible, else carved from a chunk. */
+static void* hash_map_arena_alloc(HashMapKeyArena* arena, size_t size) {
+    size_t cls = hash_map_arena_class(size);
+    void* block = arena->free_lists[cls];
+    if (block != NULL) {
+        memcpy(&arena->free_lists[cls], block, sizeof(void*));
+        return block;
+    }
+
+    size_t block_size = hash_map_arena_class_size(cls);
+    if (block_size > HASH_MAP_ARENA_CHUNK_SIZE / 4) {
+        /* large block: a dedicated chunk, recycled through its class like any other */
+        return (unsigned char*)hash_map_arena_new_chunk(arena, block_size) + HASH_MAP_ARENA_HEADER_SIZE;
+    }
+
+    if (arena->remaining < block_size) {
+        HashMapArenaChunk* chunk = hash_map_arena_new_chunk(arena, HASH_MAP_ARENA_CHUNK_SIZE);
+        arena->cursor = (unsigned char*)chunk + HASH_MAP_ARENA_HEADER_SIZE;
+        arena->remaining = HASH_MAP_ARENA_CHUNK_SIZE;
+    }
+    block = arena->cursor;
+    arena->cursor += block_size;
+    arena->remaining -= block_size;
+    return block;
+}
+
+/* Returns a block obtained for a 'size'-byte key to its class free list. */
+static inline void hash_map_arena_release(HashMapKeyArena* arena, void* block, size_t size) {
+    size_t cls = hash_map_arena_class(size);
+    memcpy(block, &arena->free_lists[cls], sizeof(void*));
+    arena->free_lists[cls] = block;
+}
+
+static void hash_map_arena_destroy(HashMapKeyArena* arena) {
+    HashMapArenaChunk* chunk = arena->chunks;
+    while (chunk != NULL) {
+        HashMapArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+/*
+ * Frees what the map owns for one item:
+ *   1) item->key   (only when spilled to the heap; inline keys need nothing),
+ *   2) item->data  (ONLY if a data-deallocator is provided).
+ * The item struct itself lives inside the table and is not freed here.
+ */
+static void hash_map_free_item_with(HashMap* hash_map, HashMapItem* item,
                                     void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
-    if (data == NULL) return;
+    if (item == NULL) return;
 
-    HashMapItem* item = (HashMapItem*)data;
-    free(item->key);
+    if (item->key_size > HASH_MAP_INLINE_KEY_SIZE) {
+        if (hash_map->key_arena != NULL) {
+            hash_map_arena_release(hash_map->key_arena, item->key, item->key_size);
+        } else {
+            free(item->key);
+        }
+    }
+    item->key = NULL;
 
-    if (deep_deallocate_hashmap_item_data != NULL) {
+    if (deep_deallocate_hashmap_item_data != NULL && item->data != NULL) {
         deep_deallocate_hashmap_item_data(item->data);
     }
-
-    free(item);
+    item->data = NULL;
     return;
 }
 
 /*
- * Builds an empty HashMap with HASH_MAP_BUCKET_NUM buckets.
- * Each bucket is initialized as an empty LinkedList (sentinel head).
+ * Deep-copies 'key' into 'item': inline when it fits in item->inline_key,
+ * otherwise into a new heap buffer (or arena block) owned by the map.
+ */
+static void hash_map_item_set_key(HashMap* hash_map, HashMapItem* item, const void* key, size_t key_size) {
+    item->key_size = key_size;
+
+    if (key_size <= HASH_MAP_INLINE_KEY_SIZE) {
+        if (key_size != 0) memcpy(item->inline_key, key, key_size);
+        item->key = item->inline_key;
+        return;
+    }
+
+    void* key_copy = hash_map->key_arena != NULL ? hash_map_arena_alloc(hash_map->key_arena, key_size)
+                                                 : malloc(key_size);
+    if (!key_copy) {
+        fprintf(stderr, "Failed hash map put operation while copying key\n");
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+    memcpy(key_copy, key, key_size);
+    item->key = key_copy;
+}
+
+/*
+ * Moves an item to another slot. A plain struct copy would leave an inline
+ * key pointing into the source slot, so the pointer is re-targeted.
+ */
+static inline void hash_map_move_item(HashMapItem* dst, const HashMapItem* src) {
+    *dst = *src;
+    if (dst->key_size <= HASH_MAP_INLINE_KEY_SIZE) {
+        dst->key = dst->inline_key;
+    }
+}
+
+/*
+ * 1 if 'item' holds exactly the key (hash, key_size, key bytes), else 0.
+ * Small keys are compared straight from the slot's inline buffer.
+ */
+static inline int hash_map_item_matches(const HashMapItem* item, uint64_t h64,
+                                        const void* key, size_t key_size) {
+    if (item->hash != h64 || item->key_size != key_size) return 0;
+    if (key_size <= HASH_MAP_INLINE_KEY_SIZE) {
+        return key_size == 0 || memcmp(item->inline_key, key, key_size) == 0;
+    }
+    return memcmp(item->key, key, key_size) == 0;
+}
+
+/* Heap bytes taken by the copy of a key of 'key_size' bytes (0 when stored inline). */
+static inline size_t hash_map_spilled_key_bytes(size_t key_size) {
+    return key_size > HASH_MAP_INLINE_KEY_SIZE ? key_size : 0;
+}
+
+/* Table memory goes through the map's allocator hook (malloc/free when unset). */
+static void* hash_map_table_alloc(const HashMap* hash_map, size_t size) {
+    if (hash_map->allocator.allocate == NULL) return malloc(size);
+    return hash_map->allocator.allocate(size, hash_map->allocator.ctx);
+}
+
+static void hash_map_table_release(const HashMap* hash_map, void* ptr, size_t size) {
+    if (ptr == NULL) return;
+    if (hash_map->allocator.allocate == NULL) {
+        free(ptr);
+    } else {
+        hash_map->allocator.release(ptr, size, hash_map->allocator.ctx);
+    }
+}
+
+/*
+ * Allocates 'capacity' slots and capacity + HASH_MAP_GROUP_WIDTH control
+ * bytes (the tail mirrors the first group), all EMPTY.
+ * Exits on allocation failure or size overflow, like the rest of the module.
+ */
+static void hash_map_alloc_table(const HashMap* hash_map, size_t capacity, HashMapItem** slots, uint8_t** ctrl) {
+    if (capacity > SIZE_MAX / sizeof(HashMapItem)) {
+        fprintf(stderr, "Hash map capacity overflow: cannot allocate %zu slots\n", capacity);
+        exit(HASHMAP_CAPACITY_OVERFLOW);
+    }
+
+    *slots = hash_map_table_alloc(hash_map, capacity * sizeof(HashMapItem));
+    *ctrl  = hash_map_table_alloc(hash_map, capacity + HASH_MAP_GROUP_WIDTH);
+    if (*slots == NULL || *ctrl == NULL) {
+        fprintf(stderr, "Failed malloc while trying to allocate hash map table (%zu slots)\n", capacity);
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+    memset(*ctrl, HASH_MAP_CTRL_EMPTY, capacity + HASH_MAP_GROUP_WIDTH);
+}
+
+/* Releases a table obtained from hash_map_alloc_table() (NULL pointers are skipped). */
+static void hash_map_free_table(const HashMap* hash_map, HashMapItem* slots, uint8_t* ctrl, size_t capacity) {
+    hash_map_table_release(hash_map, slots, capacity * sizeof(HashMapItem));
+    hash_map_table_release(hash_map, ctrl, capacity + HASH_MAP_GROUP_WIDTH);
+}
+
+/* Probe loops over HashMapItem slots: hash_map_table_find / hash_map_table_probe. */
+#define HASH_TABLE_PREFIX               hash_map
+#define HASH_TABLE_SLOT                 HashMapItem
+#define HASH_TABLE_KEY_PARAMS           const void* key, size_t key_size
+#define HASH_TABLE_KEY_ARGS             key, key_size
+#define HASH_TABLE_MATCHES(slot, h64)   hash_map_item_matches((slot), (h64), key, key_size)
+#include "hashmap_table_impl.h"
+
+/*
+ * Moves one item (known to be absent from the current table) into the
+ * current table by struct copy, reusing a tombstone if one comes first.
+ */
+static void hash_map_place_moved_item(HashMap* hash_map, const HashMapItem* item) {
+    size_t index = hash_map_table_free_slot(hash_map->ctrl, hash_map->capacity, item->hash);
+    if (hash_map->ctrl[index] == HASH_MAP_CTRL_DELETED) {
+        hash_map->tombstones--;
+    }
+    hash_map_move_item(&hash_map->slots[index], item);
+    hash_map_set_ctrl(hash_map->ctrl, hash_map->capacity, index, HASH_MAP_H2(item->hash));
+    hash_map->generation++;
+}
+
+/* Releases the drained old table and leaves migration mode. */
+static void hash_map_end_migration(HashMap* hash_map) {
+    hash_map_free_table(hash_map, hash_map->old_slots, hash_map->old_ctrl, hash_map->old_capacity);
+    hash_map->old_slots    = NULL;
+    hash_map->old_ctrl   = NULL;
+    hash_map->old_capacity = 0;
+    hash_map->old_size     = 0;
+    hash_map->migrate_pos  = 0;
+    hash_map->generation++;
+}
+
+/*
+ * Migrates up to 'max_slots' old-table slots into the current table.
+ * Items are moved by struct copy (see hash_map_move_item): heap keys and data
+ * are NOT touched.
+ * Returns 1 if a migration is still pending afterwards, 0 otherwise.
+ */
+int hash_map_rehash_step(HashMap* hash_map, size_t max_slots) {
+    if (hash_map == NULL || hash_map->old_slots == NULL) return 0;
+
+    size_t end = hash_map->migrate_pos + max_slots;
+    if (end > hash_map->old_capacity || end < hash_map->migrate_pos) {
+        end = hash_map->old_capacity;
+    }
+
+    for (size_t i = hash_map->migrate_pos; i < end && hash_map->old_size > 0; i++) {
+        if (!HASH_MAP_CTRL_IS_FULL(hash_map->old_ctrl[i])) continue;
+
+        hash_map_place_moved_item(hash_map, &hash_map->old_slots[i]);
+        hash_map_set_ctrl(hash_map->old_ctrl, hash_map->old_capacity, i, HASH_MAP_CTRL_DELETED);
+        hash_map->old_size--;
+    }
+    hash_map->migrate_pos = end;
+
+    if (hash_map->old_size == 0 || hash_map->migrate_pos >= hash_map->old_capacity) {
+        hash_map_end_migration(hash_map);
+        return 0;
+    }
+    return 1;
+}
+
+/* Moves every remaining old-table item, ending the migration (no-op if none). */
+static void hash_map_finish_migration(HashMap* hash_map) {
+    while (hash_map_rehash_step(hash_map, SIZE_MAX)) {
+        /* a single SIZE_MAX step drains the table; loop only for robustness */
+    }
+}
+
+/*
+ * Installs a fresh, empty table of 'new_capacity' slots (power of two).
+ *   - STOP_THE_WORLD: every item is moved right away and tombstones are dropped;
+ *   - INCREMENTAL:    the current table becomes the old table and its items
+ *                     are moved HASH_MAP_REHASH_STEP_SLOTS slots at a time by
+ *                     later put/remove calls (see hash_map_rehash_step()).
+ * Any migration still in progress is completed first, so at most two tables
+ * ever coexist.
+ */
+static void hash_map_rehash(HashMap* hash_map, size_t new_capacity) {
+    hash_map_finish_migration(hash_map);
+
+    HashMapItem* new_slots;
+    uint8_t*     new_ctrl;
+    hash_map_alloc_table(hash_map, new_capacity, &new_slots, &new_ctrl);
+
+    hash_map->old_slots    = hash_map->slots;
+    hash_map->old_ctrl   = hash_map->ctrl;
+    hash_map->old_capacity = hash_map->capacity;
+    hash_map->old_size     = hash_map->size;
+    hash_map->migrate_pos  = 0;
+
+    hash_map->slots      = new_slots;
+    hash_map->ctrl     = new_ctrl;
+    hash_map->capacity   = new_capacity;
+    hash_map->tombstones = 0;
+    hash_map->generation++;
+
+    if (hash_map->rehash_mode != HASH_MAP_REHASH_INCREMENTAL) {
+        hash_map_finish_migration(hash_map);
+    } else {
+        (void)hash_map_rehash_step(hash_map, HASH_MAP_REHASH_STEP_SLOTS);
+    }
+}
+
+/*
+ * Makes room for one more entry in a currently EMPTY slot.
+ * Doubles the capacity when live items alone would fill more than half the
+ * allowed load; otherwise rehashes in place to flush tombstones.
+ */
+static void hash_map_grow_for_insert(HashMap* hash_map) {
+    hash_map_rehash(hash_map, hash_map_grown_capacity(hash_map->capacity, hash_map->size));
+}
+
+/*
+ * Builds an empty HashMap with HASH_MAP_INITIAL_CAPACITY slots
+ * (stop-the-world rehashing; see hash_map_set_rehash_mode()).
  */
 HashMap* build_hash_map(void) {
     HashMap* hash_map = malloc(sizeof(HashMap));
@@ -77,22 +443,156 @@ HashMap* build_hash_map(void) {
         exit(FAILED_HASH_MAP_ALLOCATION);
     }
 
-    for (size_t i = 0; i < HASH_MAP_BUCKET_NUM; i++) {
-        hash_map->buckets[i] = build_empty_linked_list();
+    hash_map->allocator.allocate = NULL;
+    hash_map->allocator.release  = NULL;
+    hash_map->allocator.ctx      = NULL;
+    hash_map_alloc_table(hash_map, HASH_MAP_INITIAL_CAPACITY, &hash_map->slots, &hash_map->ctrl);
+    hash_map->capacity     = HASH_MAP_INITIAL_CAPACITY;
+    hash_map->size         = 0;
+    hash_map->tombstones   = 0;
+    hash_map->old_slots    = NULL;
+    hash_map->old_ctrl   = NULL;
+    hash_map->old_capacity = 0;
+    hash_map->old_size     = 0;
+    hash_map->migrate_pos  = 0;
+    hash_map->rehash_mode  = HASH_MAP_REHASH_STOP_THE_WORLD;
+    hash_map->generation   = 0;
+    hash_map->key_heap_bytes = 0;
+    hash_map->key_arena    = NULL;
+    hash_map->hash_kind    = HASH_MAP_HASH_MURMUR3;
+    hash_map->hash_seed    = MUR_MUR_3_SEED;
+
+    return hash_map;
+}
+
+/* Builds an empty HashMap already sized for 'expected_entries' (see hash_map_reserve()). */
+HashMap* build_hash_map_with_capacity(size_t expected_entries) {
+    HashMap* hash_map = build_hash_map();
+    hash_map_reserve(hash_map, expected_entries);
+    return hash_map;
+}
+
+/*
+ * Grows the table once so that 'expected_entries' live entries fit under the
+ * load limit: the puts that follow never rehash. Never shrinks. The rehash
+ * (if any) follows the map's rehash mode.
+ */
+void hash_map_reserve(HashMap* hash_map, size_t expected_entries) {
+    if (hash_map == NULL) {
+        fprintf(stderr, "hash_map_reserve called on a NULL hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    size_t capacity = hash_map_capacity_for(expected_entries, sizeof(HashMapItem));
+    if (capacity > hash_map->capacity) {
+        hash_map_rehash(hash_map, capacity);
+    }
+}
+
+/* Builds an empty HashMap hashing with 'hash_kind' and 'seed' (see hash_map_hash_bytes()). */
+HashMap* build_hash_map_with_hash(int hash_kind, uint64_t seed) {
+    HashMap* hash_map = build_hash_map();
+    hash_map->hash_kind = hash_map_normalize_hash_kind(hash_kind);
+    hash_map->hash_seed = seed;
+    return hash_map;
+}
+
+/*
+ * Switches the hash function: recomputes every stored hash, then rebuilds the
+ * table at the same capacity so slots and fingerprints follow the new hashes.
+ * The old table must not be probed in between, hence the forced full migration.
+ */
+void hash_map_set_hash(HashMap* hash_map, int hash_kind, uint64_t seed) {
+    if (hash_map == NULL) {
+        fprintf(stderr, "hash_map_set_hash called on a NULL hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    hash_map_finish_migration(hash_map);
+    hash_map->hash_kind = hash_map_normalize_hash_kind(hash_kind);
+    hash_map->hash_seed = seed;
+    if (hash_map->size == 0) return;
+
+    for (size_t i = 0; i < hash_map->capacity; i++) {
+        if (HASH_MAP_CTRL_IS_FULL(hash_map->ctrl[i])) {
+            HashMapItem* item = &hash_map->slots[i];
+            item->hash = hash_map_hash_key(hash_map, item->key, item->key_size);
+        }
+    }
+    hash_map_rehash(hash_map, hash_map->capacity);
+    hash_map_finish_migration(hash_map);
+}
+
+/*
+ * Builds an empty HashMap whose spilled keys live in a per-map arena:
+ * removes recycle key blocks through free lists and destroy releases
+ * whole chunks instead of one allocation per key.
+ */
+HashMap* build_arena_hash_map(void) {
+    HashMap* hash_map = build_hash_map();
+
+    hash_map->key_arena = calloc(1, sizeof(HashMapKeyArena));
+    if (hash_map->key_arena == NULL) {
+        fprintf(stderr, "Failed calloc while trying to build a hash map key arena\n");
+        exit(FAILED_HASH_MAP_ALLOCATION);
     }
 
     return hash_map;
 }
 
 /*
- * Destroys the entire HashMap.
+ * Builds an empty HashMap whose tables come from 'allocator'. The initial
+ * malloc'd table is swapped for one from the hook before any entry exists.
+ */
+HashMap* build_hash_map_with_allocator(const HashMapAllocator* allocator) {
+    HashMap* hash_map = build_hash_map();
+    if (allocator == NULL || allocator->allocate == NULL || allocator->release == NULL) return hash_map;
+
+    hash_map_free_table(hash_map, hash_map->slots, hash_map->ctrl, hash_map->capacity);
+    hash_map->allocator = *allocator;
+    hash_map_alloc_table(hash_map, hash_map->capacity, &hash_map->slots, &hash_map->ctrl);
+    return hash_map;
+}
+
+/*
+ * Selects how the map grows (HASH_MAP_REHASH_STOP_THE_WORLD or
+ * HASH_MAP_REHASH_INCREMENTAL). Switching to stop-the-world while a
+ * migration is pending completes that migration immediately.
+ */
+void hash_map_set_rehash_mode(HashMap* hash_map, int rehash_mode) {
+    if (hash_map == NULL) {
+        fprintf(stderr, "hash_map_set_rehash_mode called on a NULL hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    hash_map->rehash_mode = (rehash_mode == HASH_MAP_REHASH_INCREMENTAL)
+                          ? HASH_MAP_REHASH_INCREMENTAL
+                          : HASH_MAP_REHASH_STOP_THE_WORLD;
+
+    if (hash_map->rehash_mode == HASH_MAP_REHASH_STOP_THE_WORLD) {
+        hash_map_finish_migration(hash_map);
+    }
+}
+
+/* Returns 1 while an incremental migration is in progress, 0 otherwise. */
+int hash_map_is_rehashing(const HashMap* hash_map) {
+    return (hash_map != NULL && hash_map->old_slots != NULL) ? 1 : 0;
+}
+
+/* Hands the data of every FULL slot of one table to the deallocator (arena destroy path). */
+static void hash_map_free_table_data(HashMapItem* slots, const uint8_t* ctrl, size_t capacity,
+                                     void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    for (size_t i = 0; i < capacity; i++) {
+        if (HASH_MAP_CTRL_IS_FULL(ctrl[i]) && slots[i].data != NULL) {
+            deep_deallocate_hashmap_item_data(slots[i].data);
+        }
+    }
+}
+
+/*
+ * Destroys the entire HashMap (both tables if a migration is pending).
  * - deep_deallocate_hashmap_item_data deallocates HashMapItem->data (type-specific).
  *   It can be NULL when data is not dynamically allocated / not owned by the map.
- *
- * Implementation note:
- * We detach each node (set node->next = NULL) before handing it to
- * linked_list_remove_hashmap_node_with(...) to adhere to that function’s contract
- * (“standalone, already-detached node”).
  */
 void hash_map_destroy(HashMap* hash_map,
                       void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
@@ -101,34 +601,96 @@ void hash_map_destroy(HashMap* hash_map,
         return;
     }
 
-    for (size_t i = 0; i < HASH_MAP_BUCKET_NUM; i++) {
-        LinkedList bucket_head = hash_map->buckets[i];
-
-        while (bucket_head != NULL) {
-            LinkedListNode* node = bucket_head;
-            bucket_head = bucket_head->next;
-            
-            /* If this is an empty sentinel (no payload), just free the node. */
-            if (node->data == NULL) {
-                free(node);
-                continue;
+    if (hash_map->key_arena != NULL) {
+        /* Keys go away with their chunks: only owned data needs a per-item visit. */
+        if (deep_deallocate_hashmap_item_data != NULL) {
+            hash_map_free_table_data(hash_map->slots, hash_map->ctrl, hash_map->capacity,
+                                     deep_deallocate_hashmap_item_data);
+            hash_map_free_table_data(hash_map->old_slots, hash_map->old_ctrl, hash_map->old_capacity,
+                                     deep_deallocate_hashmap_item_data);
+        }
+        hash_map_arena_destroy(hash_map->key_arena);
+    } else {
+        for (size_t i = 0; i < hash_map->capacity; i++) {
+            if (HASH_MAP_CTRL_IS_FULL(hash_map->ctrl[i])) {
+                hash_map_free_item_with(hash_map, &hash_map->slots[i], deep_deallocate_hashmap_item_data);
+            }
+        }
+        for (size_t i = 0; i < hash_map->old_capacity; i++) {
+            if (HASH_MAP_CTRL_IS_FULL(hash_map->old_ctrl[i])) {
+                hash_map_free_item_with(hash_map, &hash_map->old_slots[i], deep_deallocate_hashmap_item_data);
             }
-
-            /* Detach to satisfy the “standalone node” precondition */
-            node->next = NULL;
-
-            linked_list_remove_hashmap_node_with(
-                node,                              /* the node to free */
-                hash_map_free_item_with,           /* frees HashMapItem + key + (optional) data */
-                deep_deallocate_hashmap_item_data  /* (optional) data deallocator */
-            );
         }
     }
 
+    hash_map_free_table(hash_map, hash_map->old_slots, hash_map->old_ctrl, hash_map->old_capacity);
+    hash_map_free_table(hash_map, hash_map->slots, hash_map->ctrl, hash_map->capacity);
     free(hash_map);
     return;
 }
 
+/*
+ * Finds 'key' or claims a slot for it, in a single probe (shared by put,
+ * get_or_insert and upsert_with).
+ *
+ * Returns the stored item. *inserted is set to 1 when the key was absent:
+ * the slot then holds a deep copy of the key and data = NULL, data_size = 0.
+ *
+ * While searching for the key we remember the first tombstone, so a new key
+ * reuses it instead of lengthening the chain.
+ * During an incremental migration the old table is searched too (an existing
+ * key is returned where it is), and new keys always go to the current table.
+ */
+static HashMapItem* hash_map_find_or_insert_hashed(HashMap* hash_map,
+                                                   uint64_t h64,
+                                                   const void* key,
+                                                   size_t key_size,
+                                                   int* inserted)
+{
+    /* Pay a bounded share of any pending migration, then check the old table */
+    if (hash_map_rehash_step(hash_map, HASH_MAP_REHASH_STEP_SLOTS)) {
+        size_t old_index = hash_map_table_find(hash_map->old_slots, hash_map->old_ctrl,
+                                               hash_map->old_capacity, h64, key, key_size);
+        if (old_index != hash_map->old_capacity) {
+            *inserted = 0;
+            return &hash_map->old_slots[old_index];
+        }
+    }
+
+    size_t insert_at;   /* first EMPTY/DELETED slot met while probing */
+    size_t index = hash_map_table_probe(hash_map->slots, hash_map->ctrl, hash_map->capacity,
+                                        h64, key, key_size, &insert_at);
+    if (index != hash_map->capacity) {
+        *inserted = 0;
+        return &hash_map->slots[index];
+    }
+
+    /* 'size' also counts items still waiting in the old table: they will all
+     * land in the current one, so they must fit under its load limit too.
+     * Reusing a tombstone never needs growth; consuming an EMPTY slot past the
+     * load limit → rehash, then take the first free slot of the new table. */
+    if (!hash_map_table_claim(hash_map->ctrl, hash_map->capacity, insert_at,
+                              hash_map->size, &hash_map->tombstones)) {
+        hash_map_grow_for_insert(hash_map);
+        insert_at = hash_map_table_free_slot(hash_map->ctrl, hash_map->capacity, h64);
+        if (hash_map->ctrl[insert_at] == HASH_MAP_CTRL_DELETED) {
+            hash_map->tombstones--;
+        }
+    }
+
+    HashMapItem* slot = &hash_map->slots[insert_at];
+    slot->hash      = h64;
+    hash_map_item_set_key(hash_map, slot, key, key_size);  /* map owns this (inline or heap) */
+    hash_map->key_heap_bytes += hash_map_spilled_key_bytes(key_size);
+    slot->data      = NULL;
+    slot->data_size = 0;
+    hash_map_set_ctrl(hash_map->ctrl, hash_map->capacity, insert_at, HASH_MAP_H2(h64));
+    hash_map->size++;
+
+    *inserted = 1;
+    return slot;
+}
+
 /*
  * Inserts or updates an entry (upsert).
  *
@@ -141,95 +703,86 @@ void hash_map_destroy(HashMap* hash_map,
  *   - data ownership is transferred to the map ONLY if
  *     deep_deallocate_hashmap_item_data != NULL; otherwise the map will not free it.
  */
-int hash_map_put(HashMap* hash_map,
-                 const void* key,
-                 size_t key_size,
-                 const void* data,
-                 size_t data_size,
-                 void (*deep_deallocate_hashmap_item_data)(void* node_data))
+static int hash_map_put_hashed(HashMap* hash_map,
+                               uint64_t h64,
+                               const void* key,
+                               size_t key_size,
+                               const void* data,
+                               size_t data_size,
+                               void (*deep_deallocate_hashmap_item_data)(void* node_data))
 {
+    int inserted;
+    HashMapItem* item = hash_map_find_or_insert_hashed(hash_map, h64, key, key_size, &inserted);
+
+    /* Existing key: if the map owns the old value (callback provided), free it first. */
+    if (!inserted && item->data != NULL && deep_deallocate_hashmap_item_data != NULL) {
+        deep_deallocate_hashmap_item_data(item->data);
+    }
+    item->data      = (void*)data;  /* new value (ownership as per callback presence) */
+    item->data_size = data_size;
+
+    return inserted ? 0 : 1;
+}
+
+/* Fails hard on a NULL map or table (shared by hash_map_put and hash_map_put_batch). */
+static void hash_map_check_writable(const HashMap* hash_map) {
     if (hash_map == NULL) {
         fprintf(stderr, "You are trying to put data in a NULL hash map; did you call build_hash_map(void)?\n");
         exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
     }
 
-    /* Hash the key and pick the bucket */
-    uint64_t h64 = generate_hash(key, key_size);
-    size_t bucket_index = (size_t)(h64 % HASH_MAP_BUCKET_NUM);
-    LinkedList bucket_list = hash_map->buckets[bucket_index];
-
-    if (is_linked_list_null(bucket_list)) {
-        fprintf(stderr, "Unexpected error: hash map buckets initialized, but a bucket list is NULL\n");
+    if (hash_map->slots == NULL || hash_map->ctrl == NULL) {
+        fprintf(stderr, "Unexpected error: hash map built, but its table is NULL\n");
         exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP_BUCKET);
     }
+}
 
-    /* Empty logical list → insert as first item */
-    if (is_linked_list_empty(bucket_list)) {
-
-        void* key_copy = malloc(key_size);
-        if (!key_copy) {
-            fprintf(stderr, "Failed hash map put operation while copying key\n");
-            exit(FAILED_HASH_MAP_ALLOCATION);
-        }
-        memcpy(key_copy, key, key_size);
-
-        HashMapItem new_item_val;
-        new_item_val.hash      = h64;
-        new_item_val.key       = key_copy;     /* map owns and frees this */
-        new_item_val.key_size  = key_size;
-        new_item_val.data      = data;         /* ownership depends on callback presence */
-        new_item_val.data_size = data_size;
-
-        linked_list_push_back(bucket_list, ll_alloc_HashMapItem(new_item_val));
-        return 0; /* new key */
-    }
-
-    /* Bucket has nodes → walk and search for key */
-    LinkedList node = bucket_list;
-    while (node != NULL) {
-        HashMapItem* item = (HashMapItem*)node->data;
-
-        if (item != NULL &&
-            item->hash == h64 &&
-            item->key_size == key_size &&
-            memcmp(item->key, key, key_size) == 0)
-        {
-            /* Found existing key → update value.
-             * If the map owns the old value (callback provided), free it first. */
-            if (item->data != NULL && deep_deallocate_hashmap_item_data != NULL) {
-                deep_deallocate_hashmap_item_data(item->data);
-            }
-            item->data      = data;       /* new value (ownership as per callback presence) */
-            item->data_size = data_size;
-            return 1; /* updated existing */
-        }
-
-        if (node->next == NULL) {
-            /* Reached tail with no match → append */
-
-            void* key_copy = malloc(key_size);
-            if (!key_copy) {
-                fprintf(stderr, "Failed hash map put operation while copying key\n");
-                exit(FAILED_HASH_MAP_ALLOCATION);
-            }
-            memcpy(key_copy, key, key_size);
+int hash_map_put(HashMap* hash_map,
+                 const void* key,
+                 size_t key_size,
+                 const void* data,
+                 size_t data_size,
+                 void (*deep_deallocate_hashmap_item_data)(void* node_data))
+{
+    hash_map_check_writable(hash_map);
+    return hash_map_put_hashed(hash_map, hash_map_hash_key(hash_map, key, key_size), key, key_size,
+                               data, data_size, deep_deallocate_hashmap_item_data);
+}
 
-            HashMapItem new_item_val;
-            new_item_val.hash      = h64;
-            new_item_val.key       = key_copy;  /* map owns and frees this */
-            new_item_val.key_size  = key_size;
-            new_item_val.data      = data;      /* ownership depends on callback presence */
-            new_item_val.data_size = data_size;
+/*
+ * Get-or-insert: one hash, one probe. The returned item is mutable: callers
+ * update data / data_size in place (never hash / key / key_size).
+ */
+HashMapItem* hash_map_get_or_insert(HashMap* hash_map,
+                                    const void* key,
+                                    size_t key_size,
+                                    int* inserted)
+{
+    hash_map_check_writable(hash_map);
 
-            linked_list_push_back(node, ll_alloc_HashMapItem(new_item_val));
-            return 0; /* inserted new */
-        }
+    int was_inserted;
+    HashMapItem* item = hash_map_find_or_insert_hashed(hash_map, hash_map_hash_key(hash_map, key, key_size),
+                                                       key, key_size, &was_inserted);
+    if (inserted != NULL) *inserted = was_inserted;
+    return item;
+}
 
-        node = node->next;
+/* Read-modify-write through 'update', on the item found or inserted by a single probe. */
+int hash_map_upsert_with(HashMap* hash_map,
+                         const void* key,
+                         size_t key_size,
+                         void (*update)(HashMapItem* item, int inserted, void* ctx),
+                         void* ctx)
+{
+    if (update == NULL) {
+        fprintf(stderr, "hash_map_upsert_with called without an update function\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
     }
 
-    /* Unreachable in normal flow */
-    return 0;
+    int inserted;
+    HashMapItem* item = hash_map_get_or_insert(hash_map, key, key_size, &inserted);
+    update(item, inserted, ctx);
+    return inserted ? 0 : 1;
 }
 
 /*
@@ -240,9 +793,42 @@ int hash_map_put(HashMap* hash_map,
  *   0 if the key was not found
  *
  * Implementation detail:
- * For head removal with multiple elements, we do not change the head pointer;
- * instead, we promote the second node's payload into the head and free the second node.
+ * The slot becomes a tombstone (DELETED) when keys stored further along some
+ * probe sequence may depend on it, and EMPTY otherwise (see hash_map_table_vacate).
  */
+static int hash_map_remove_hashed(HashMap* hash_map,
+                                  uint64_t h64,
+                                  const void* key,
+                                  size_t key_size,
+                                  void (*deep_deallocate_hashmap_item_data)(void* node_data))
+{
+    if (hash_map_rehash_step(hash_map, HASH_MAP_REHASH_STEP_SLOTS)) {
+        size_t old_index = hash_map_table_find(hash_map->old_slots, hash_map->old_ctrl,
+                                               hash_map->old_capacity, h64, key, key_size);
+        if (old_index != hash_map->old_capacity) {
+            hash_map->key_heap_bytes -= hash_map_spilled_key_bytes(key_size);
+            hash_map_free_item_with(hash_map, &hash_map->old_slots[old_index], deep_deallocate_hashmap_item_data);
+            (void)hash_map_table_vacate(hash_map->old_ctrl, hash_map->old_capacity, old_index);
+            hash_map->old_size--;
+            hash_map->size--;
+            return 1;
+        }
+    }
+
+    size_t index = hash_map_table_find(hash_map->slots, hash_map->ctrl, hash_map->capacity,
+                                       h64, key, key_size);
+    if (index == hash_map->capacity) {
+        return 0; /* Not found */
+    }
+
+    hash_map->key_heap_bytes -= hash_map_spilled_key_bytes(key_size);
+    hash_map_free_item_with(hash_map, &hash_map->slots[index], deep_deallocate_hashmap_item_data);
+    hash_map->size--;
+    hash_map->tombstones += (size_t)hash_map_table_vacate(hash_map->ctrl, hash_map->capacity, index);
+
+    return 1;
+}
+
 int hash_map_remove(HashMap* hash_map,
                     const void* key,
                     size_t key_size,
@@ -253,123 +839,468 @@ int hash_map_remove(HashMap* hash_map,
         return 0;
     }
 
-    /* Locate bucket */
-    uint64_t h64 = generate_hash(key, key_size);
-    size_t bucket_index = (size_t)(h64 % HASH_MAP_BUCKET_NUM);
-    LinkedList bucket_head = hash_map->buckets[bucket_index];
+    return hash_map_remove_hashed(hash_map, hash_map_hash_key(hash_map, key, key_size), key, key_size,
+                                  deep_deallocate_hashmap_item_data);
+}
+
+/*
+ * Looks up an entry by key.
+ *
+ * Returns:
+ *   const HashMapItem* (INTERNAL pointer; DO NOT MODIFY or FREE it)
+ *   NULL if not found
+ *
+ * Lookups never migrate: during an incremental rehash they probe the current
+ * table and then the old one, so reads stay side-effect free and pointers
+ * from earlier gets are not invalidated by later gets.
+ */
+static const HashMapItem* hash_map_get_hashed(const HashMap* hash_map,
+                                              uint64_t h64,
+                                              const void* key,
+                                              size_t key_size)
+{
+    size_t index = hash_map_table_find(hash_map->slots, hash_map->ctrl, hash_map->capacity,
+                                       h64, key, key_size);
+    if (index != hash_map->capacity) {
+        /* INTERNAL pointer: read-only, valid until the next put/remove */
+        return &hash_map->slots[index];
+    }
 
-    /* Empty logical list → nothing to remove */
-    if (is_linked_list_empty(bucket_head)) {
+    if (hash_map->old_slots != NULL) {
+        index = hash_map_table_find(hash_map->old_slots, hash_map->old_ctrl, hash_map->old_capacity,
+                                    h64, key, key_size);
+        if (index != hash_map->old_capacity) {
+            return &hash_map->old_slots[index];
+        }
+    }
+
+    return NULL;
+}
+
+const HashMapItem* hash_map_get(HashMap* hash_map,
+                                const void* key,
+                                size_t key_size)
+{
+    if (hash_map == NULL) return NULL;
+
+    return hash_map_get_hashed(hash_map, hash_map_hash_key(hash_map, key, key_size), key, key_size);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                     Pre-hashed operations (caller's hash)                 */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Same as put/remove/get, with the hash supplied by the caller. The hash is
+ * trusted as is: it MUST be hash_map_hash_key(hash_map, key, key_size), or the entry ends
+ * up where the other calls will never look for it.
+ */
+int hash_map_put_prehashed(HashMap* hash_map,
+                           uint64_t hash,
+                           const void* key,
+                           size_t key_size,
+                           const void* data,
+                           size_t data_size,
+                           void (*deep_deallocate_hashmap_item_data)(void* node_data))
+{
+    hash_map_check_writable(hash_map);
+    return hash_map_put_hashed(hash_map, hash, key, key_size, data, data_size,
+                               deep_deallocate_hashmap_item_data);
+}
+
+int hash_map_remove_prehashed(HashMap* hash_map,
+                              uint64_t hash,
+                              const void* key,
+                              size_t key_size,
+                              void (*deep_deallocate_hashmap_item_data)(void* node_data))
+{
+    if (hash_map == NULL) {
+        fprintf(stderr, "hash_map_remove_prehashed called on a NULL hash map\n");
         return 0;
     }
 
-    /* Case 1: check head */
-    {
-        HashMapItem* first_item = (HashMapItem*)bucket_head->data;
-
-        if (first_item != NULL &&
-            first_item->hash == h64 &&
-            first_item->key_size == key_size &&
-            memcmp(first_item->key, key, key_size) == 0)
-        {
-            if (bucket_head->next == NULL) {
-                /* Single-node bucket: free payload and mark head empty */
-                hash_map_free_item_with(first_item, deep_deallocate_hashmap_item_data);
-                bucket_head->data = NULL;
-                return 1;
-            } else {
-                /* Multi-node bucket: free head payload, promote second into head, free second node */
-                hash_map_free_item_with(first_item, deep_deallocate_hashmap_item_data);
-
-                LinkedListNode* second = bucket_head->next;
-
-                bucket_head->data = second->data;  /* transfer payload */
-                bucket_head->next = second->next;
-
-                /* second is now a standalone node with NULLed fields */
-                second->data = NULL;
-                second->next = NULL;
-
-                /* Free only the node structure (payload already transferred) */
-                free(second);
-                return 1;
+    return hash_map_remove_hashed(hash_map, hash, key, key_size, deep_deallocate_hashmap_item_data);
+}
+
+const HashMapItem* hash_map_get_prehashed(HashMap* hash_map,
+                                          uint64_t hash,
+                                          const void* key,
+                                          size_t key_size)
+{
+    if (hash_map == NULL) return NULL;
+
+    return hash_map_get_hashed(hash_map, hash, key, key_size);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                          Batch operations (prefetch)                      */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Batches run in windows of HASH_MAP_BATCH_WINDOW keys, in two passes:
+ *   1) hash every key of the window and prefetch its home group of control
+ *      bytes and its home slot (plus the old table's while migrating);
+ *   2) resolve the keys one by one, as the single-key calls would.
+ * By the time pass 2 reaches a key its cache lines are (hopefully) in flight
+ * or already loaded, so the misses of a window overlap instead of queuing.
+ * Prefetches are only hints: a put that grows the table mid-window just
+ * wastes the remaining ones.
+ */
+static void hash_map_prefetch_home(const HashMap* hash_map, uint64_t h64) {
+    size_t pos = (size_t)h64 & (hash_map->capacity - 1);
+    HASH_MAP_PREFETCH(hash_map->ctrl + pos);
+    HASH_MAP_PREFETCH(&hash_map->slots[pos]);
+
+    if (hash_map->old_slots != NULL) {
+        size_t old_pos = (size_t)h64 & (hash_map->old_capacity - 1);
+        HASH_MAP_PREFETCH(hash_map->old_ctrl + old_pos);
+        HASH_MAP_PREFETCH(&hash_map->old_slots[old_pos]);
+    }
+}
+
+void hash_map_get_batch(HashMap* hash_map,
+                        const void* const* keys,
+                        const size_t* key_sizes,
+                        size_t count,
+                        const HashMapItem** out_items)
+{
+    if (out_items == NULL) return;
+    if (hash_map == NULL) {
+        for (size_t i = 0; i < count; i++) out_items[i] = NULL;
+        return;
+    }
+
+    uint64_t hashes[HASH_MAP_BATCH_WINDOW];
+    for (size_t base = 0; base < count; base += HASH_MAP_BATCH_WINDOW) {
+        size_t n = count - base < HASH_MAP_BATCH_WINDOW ? count - base : HASH_MAP_BATCH_WINDOW;
+
+        for (size_t i = 0; i < n; i++) {
+            hashes[i] = hash_map_hash_key(hash_map, keys[base + i], key_sizes[base + i]);
+            hash_map_prefetch_home(hash_map, hashes[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+            out_items[base + i] = hash_map_get_hashed(hash_map, hashes[i], keys[base + i], key_sizes[base + i]);
+        }
+    }
+}
+
+size_t hash_map_put_batch(HashMap* hash_map,
+                          const void* const* keys,
+                          const size_t* key_sizes,
+                          const void* const* data,
+                          const size_t* data_sizes,
+                          size_t count,
+                          void (*deep_deallocate_hashmap_item_data)(void* node_data))
+{
+    hash_map_check_writable(hash_map);
+
+    size_t updated = 0;
+    uint64_t hashes[HASH_MAP_BATCH_WINDOW];
+    for (size_t base = 0; base < count; base += HASH_MAP_BATCH_WINDOW) {
+        size_t n = count - base < HASH_MAP_BATCH_WINDOW ? count - base : HASH_MAP_BATCH_WINDOW;
+
+        for (size_t i = 0; i < n; i++) {
+            hashes[i] = hash_map_hash_key(hash_map, keys[base + i], key_sizes[base + i]);
+            hash_map_prefetch_home(hash_map, hashes[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+            updated += (size_t)hash_map_put_hashed(hash_map, hashes[i], keys[base + i], key_sizes[base + i],
+                                                   data != NULL ? data[base + i] : NULL,
+                                                   data_sizes != NULL ? data_sizes[base + i] : 0,
+                                                   deep_deallocate_hashmap_item_data);
+        }
+    }
+    return updated;
+}
+
+/*
+ * Bulk load. The table is sized once for size + count (which also drops
+ * tombstones) and any pending migration is completed, so nothing rehashes
+ * while loading. Keys are then hashed HASH_MAP_BULK_LOAD_CHUNK at a time in a
+ * tight loop and placed with the home group of a key a few places ahead
+ * already prefetched. With keys_are_unique the placement skips the key
+ * comparisons entirely: each key takes the first free slot of its probe
+ * sequence.
+ */
+size_t hash_map_bulk_load(HashMap* hash_map,
+                          const void* const* keys,
+                          const size_t* key_sizes,
+                          const void* const* data,
+                          const size_t* data_sizes,
+                          size_t count,
+                          int keys_are_unique,
+                          void (*deep_deallocate_hashmap_item_data)(void* node_data))
+{
+    hash_map_check_writable(hash_map);
+    if (count == 0) return 0;
+
+    hash_map_finish_migration(hash_map);
+    if (count > SIZE_MAX - hash_map->size) {
+        fprintf(stderr, "Hash map capacity overflow: cannot bulk load %zu more entries\n", count);
+        exit(HASHMAP_CAPACITY_OVERFLOW);
+    }
+    if (hash_map->size + hash_map->tombstones + count > hash_map_max_used(hash_map->capacity)) {
+        size_t capacity = hash_map_capacity_for(hash_map->size + count, sizeof(HashMapItem));
+        hash_map_rehash(hash_map, capacity > hash_map->capacity ? capacity : hash_map->capacity);
+        hash_map_finish_migration(hash_map);
+    }
+
+    size_t updated = 0;
+    uint64_t hashes[HASH_MAP_BULK_LOAD_CHUNK];
+    for (size_t base = 0; base < count; base += HASH_MAP_BULK_LOAD_CHUNK) {
+        size_t n = count - base < HASH_MAP_BULK_LOAD_CHUNK ? count - base : HASH_MAP_BULK_LOAD_CHUNK;
+
+        for (size_t i = 0; i < n; i++) {
+            hashes[i] = hash_map_hash_key(hash_map, keys[base + i], key_sizes[base + i]);
+        }
+        for (size_t i = 0; i < n && i < HASH_MAP_BATCH_WINDOW; i++) {
+            hash_map_prefetch_home(hash_map, hashes[i]);
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            if (i + HASH_MAP_BATCH_WINDOW < n) hash_map_prefetch_home(hash_map, hashes[i + HASH_MAP_BATCH_WINDOW]);
+
+            const void* value      = data != NULL ? data[base + i] : NULL;
+            const size_t value_size = data_sizes != NULL ? data_sizes[base + i] : 0;
+            if (!keys_are_unique) {
+                updated += (size_t)hash_map_put_hashed(hash_map, hashes[i], keys[base + i], key_sizes[base + i],
+                                                       value, value_size, deep_deallocate_hashmap_item_data);
+                continue;
             }
+
+            size_t index = hash_map_table_free_slot(hash_map->ctrl, hash_map->capacity, hashes[i]);
+            if (hash_map->ctrl[index] == HASH_MAP_CTRL_DELETED) {
+                hash_map->tombstones--;
+            }
+            HashMapItem* slot = &hash_map->slots[index];
+            slot->hash      = hashes[i];
+            hash_map_item_set_key(hash_map, slot, keys[base + i], key_sizes[base + i]);
+            hash_map->key_heap_bytes += hash_map_spilled_key_bytes(key_sizes[base + i]);
+            slot->data      = (void*)value;
+            slot->data_size = value_size;
+            hash_map_set_ctrl(hash_map->ctrl, hash_map->capacity, index, HASH_MAP_H2(hashes[i]));
+            hash_map->size++;
         }
     }
+    return updated;
+}
 
-    /* Case 2: walk with (prev, curr) and remove if found */
-    LinkedList prev = bucket_head;
-    LinkedList curr = bucket_head->next;
-
-    while (curr != NULL) {
-        HashMapItem* item = (HashMapItem*)curr->data;
-
-        if (item != NULL &&
-            item->hash == h64 &&
-            item->key_size == key_size &&
-            memcmp(item->key, key, key_size) == 0)
-        {
-            /* Stitch neighbors, then free the standalone curr node */
-            prev->next = curr->next;
-            linked_list_remove_hashmap_node_with(
-                curr,
-                hash_map_free_item_with,
-                deep_deallocate_hashmap_item_data
-            );
-            return 1;
+size_t hash_map_remove_batch(HashMap* hash_map,
+                             const void* const* keys,
+                             const size_t* key_sizes,
+                             size_t count,
+                             void (*deep_deallocate_hashmap_item_data)(void* node_data))
+{
+    if (hash_map == NULL) {
+        fprintf(stderr, "hash_map_remove_batch called on a NULL hash map\n");
+        return 0;
+    }
+
+    size_t removed = 0;
+    uint64_t hashes[HASH_MAP_BATCH_WINDOW];
+    for (size_t base = 0; base < count; base += HASH_MAP_BATCH_WINDOW) {
+        size_t n = count - base < HASH_MAP_BATCH_WINDOW ? count - base : HASH_MAP_BATCH_WINDOW;
+
+        for (size_t i = 0; i < n; i++) {
+            hashes[i] = hash_map_hash_key(hash_map, keys[base + i], key_sizes[base + i]);
+            hash_map_prefetch_home(hash_map, hashes[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+            removed += (size_t)hash_map_remove_hashed(hash_map, hashes[i], keys[base + i], key_sizes[base + i],
+                                                      deep_deallocate_hashmap_item_data);
         }
+    }
+    return removed;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                        Iteration (no allocation at all)                   */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * All the walkers below share one "virtual index" space: positions
+ * [0, capacity) are the current table, [capacity, capacity + old_capacity)
+ * the old one while an incremental rehash is pending. Slots are visited in
+ * memory order, one control-byte group at a time, so empty stretches cost a
+ * single group scan and FULL items are read sequentially.
+ */
 
-        prev = curr;
-        curr = curr->next;
+/*
+ * Next FULL item at virtual position >= *position (advancing *position past
+ * it), or NULL when both tables are exhausted.
+ */
+static const HashMapItem* hash_map_next_item(const HashMap* hash_map, size_t* position) {
+    size_t pos = *position;
+
+    if (pos < hash_map->capacity) {
+        size_t index = hash_map_next_full(hash_map->ctrl, hash_map->capacity, pos);
+        if (index < hash_map->capacity) {
+            *position = index + 1;
+            return &hash_map->slots[index];
+        }
+        pos = hash_map->capacity;
+    }
+
+    if (hash_map->old_slots != NULL) {
+        size_t index = hash_map_next_full(hash_map->old_ctrl, hash_map->old_capacity, pos - hash_map->capacity);
+        if (index < hash_map->old_capacity) {
+            *position = hash_map->capacity + index + 1;
+            return &hash_map->old_slots[index];
+        }
     }
 
-    /* Not found */
-    return 0;
+    *position = hash_map->capacity + hash_map->old_capacity;
+    return NULL;
+}
+
+void hash_map_iterator_init(HashMapIterator* it, const HashMap* hash_map) {
+    if (it == NULL) return;
+    it->map        = hash_map;
+    it->position   = 0;
+    it->generation = hash_map != NULL ? hash_map->generation : 0;
+}
+
+const HashMapItem* hash_map_iterator_next(HashMapIterator* it) {
+    if (it == NULL || it->map == NULL) return NULL;
+    if (it->generation != it->map->generation) return NULL;  /* items moved: iteration is over */
+    return hash_map_next_item(it->map, &it->position);
+}
+
+int hash_map_iterator_invalidated(const HashMapIterator* it) {
+    return (it != NULL && it->map != NULL && it->generation != it->map->generation) ? 1 : 0;
 }
 
 /*
- * Looks up an entry by key.
- *
- * Returns:
- *   const HashMapItem* (INTERNAL pointer; DO NOT MODIFY or FREE it)
- *   NULL if not found
+ * Calls visit(item, ctx) once per entry, in memory order.
+ * 'visit' must not put/remove on the same map.
  */
-const HashMapItem* hash_map_get(HashMap* hash_map,
-                                const void* key,
-                                size_t key_size)
+void hash_map_for_each(const HashMap* hash_map,
+                       void (*visit)(const HashMapItem* item, void* ctx),
+                       void* ctx)
 {
-    if (hash_map == NULL) return NULL;
+    if (hash_map == NULL || visit == NULL) return;
 
-    /* Locate bucket */
-    uint64_t h64 = generate_hash(key, key_size);
-    size_t bucket_index = (size_t)(h64 % HASH_MAP_BUCKET_NUM);
-    LinkedList bucket_list = hash_map->buckets[bucket_index];
-
-    if (is_linked_list_empty(bucket_list)) {
-        return NULL;
+    size_t position = 0;
+    for (const HashMapItem* item = hash_map_next_item(hash_map, &position);
+         item != NULL;
+         item = hash_map_next_item(hash_map, &position)) {
+        visit(item, ctx);
     }
+}
+
+void hash_map_cursor_init(HashMapCursor* cursor) {
+    if (cursor == NULL) return;
+    cursor->position   = 0;
+    cursor->generation = 0;
+    cursor->started    = 0;
+    cursor->restarts   = 0;
+}
 
-    /* Walk bucket */
-    LinkedList node = bucket_list;
+/*
+ * Visits the FULL items found in the next 'max_slots' slots (at least one
+ * slot per call) and remembers where it stopped. If items moved since the
+ * previous slice, the pass restarts from the beginning (restarts++), since
+ * the remembered position no longer means anything.
+ */
+int hash_map_scan(const HashMap* hash_map,
+                  HashMapCursor* cursor,
+                  size_t max_slots,
+                  void (*visit)(const HashMapItem* item, void* ctx),
+                  void* ctx)
+{
+    if (hash_map == NULL || cursor == NULL) return 0;
 
-    while (node != NULL) {
-        HashMapItem* item = (HashMapItem*)node->data;
+    if (!cursor->started) {
+        cursor->started    = 1;
+        cursor->position   = 0;
+        cursor->generation = hash_map->generation;
+    } else if (cursor->generation != hash_map->generation) {
+        cursor->position   = 0;
+        cursor->generation = hash_map->generation;
+        cursor->restarts++;
+    }
 
-        if (item != NULL &&
-            item->hash == h64 &&
-            item->key_size == key_size &&
-            memcmp(item->key, key, key_size) == 0)
-        {
-            /* INTERNAL pointer: read-only, lifetime managed by the map */
-            return item;
-        }
+    const size_t total = hash_map->capacity + hash_map->old_capacity;
+    if (cursor->position > total) cursor->position = total;
+    if (max_slots == 0) max_slots = 1;
+    size_t stop = (max_slots >= total - cursor->position) ? total : cursor->position + max_slots;
 
-        if (node->next == NULL) {
-            return NULL;
+    while (cursor->position < stop) {
+        size_t position = cursor->position;
+        const HashMapItem* item = hash_map_next_item(hash_map, &position);
+        if (item == NULL || position > stop) {
+            cursor->position = stop;  /* next item (if any) belongs to a later slice */
+            break;
         }
+        cursor->position = position;
+        if (visit != NULL) visit(item, ctx);
+    }
+
+    return cursor->position < total ? 1 : 0;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                   Stats                                   */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Number of groups probed before reaching slot 'index' when looking up a key
+ * of hash 'h64' (1 = found in its home group). Follows the same triangular
+ * sequence as hash_map_table_find().
+ */
+static size_t hash_map_probe_length(size_t capacity, uint64_t h64, size_t index) {
+    const size_t mask = capacity - 1;
+    size_t pos = (size_t)h64 & mask;
+
+    for (size_t probe = 1; probe <= capacity / HASH_MAP_GROUP_WIDTH; probe++) {
+        if (((index - pos) & mask) < HASH_MAP_GROUP_WIDTH) return probe;
+        pos = (pos + probe * HASH_MAP_GROUP_WIDTH) & mask;
+    }
+    return capacity / HASH_MAP_GROUP_WIDTH;  /* unreachable for a consistent table */
+}
+
+/* Adds the probe lengths of every FULL slot of one table to 'stats'. */
+static void hash_map_stats_probe_table(const HashMapItem* slots, const uint8_t* ctrl, size_t capacity,
+                                       HashMapStats* stats, size_t* total_probes) {
+    for (size_t i = hash_map_next_full(ctrl, capacity, 0); i < capacity; i = hash_map_next_full(ctrl, capacity, i + 1)) {
+        size_t length = hash_map_probe_length(capacity, slots[i].hash, i);
+        size_t bucket = length - 1 < HASH_MAP_STATS_PROBE_BUCKETS ? length - 1 : HASH_MAP_STATS_PROBE_BUCKETS - 1;
 
-        node = node->next;
+        stats->probe_histogram[bucket]++;
+        if (length > stats->max_probe_length) stats->max_probe_length = length;
+        *total_probes += length;
     }
+}
 
-    return NULL; /* for completeness */
+/*
+ * Fills 'stats'. Counters and byte totals are kept up to date by put/remove
+ * and cost O(1); the probe-length figures walk the table (O(capacity)).
+ */
+void hash_map_stats(const HashMap* hash_map, HashMapStats* stats) {
+    if (stats == NULL) return;
+    memset(stats, 0, sizeof *stats);
+    if (hash_map == NULL) return;
+
+    const size_t slot_bytes = sizeof(HashMapItem) + sizeof(uint8_t);
+
+    stats->entries        = hash_map->size;
+    stats->capacity       = hash_map->capacity;
+    stats->tombstones     = hash_map->tombstones;
+    stats->old_capacity   = hash_map->old_capacity;
+    stats->old_entries    = hash_map->old_size;
+    stats->table_bytes    = (hash_map->capacity + hash_map->old_capacity) * slot_bytes
+                          + (hash_map->old_slots != NULL ? 2 : 1) * HASH_MAP_GROUP_WIDTH;
+    stats->key_heap_bytes = hash_map->key_arena != NULL ? hash_map->key_arena->reserved_bytes
+                                                        : hash_map->key_heap_bytes;
+    stats->total_bytes    = sizeof(HashMap) + stats->table_bytes + stats->key_heap_bytes;
+    stats->load_factor    = (double)(hash_map->size - hash_map->old_size + hash_map->tombstones)
+                          / (double)hash_map->capacity;
+
+    size_t total_probes = 0;
+    hash_map_stats_probe_table(hash_map->slots, hash_map->ctrl, hash_map->capacity, stats, &total_probes);
+    if (hash_map->old_slots != NULL) {
+        hash_map_stats_probe_table(hash_map->old_slots, hash_map->old_ctrl, hash_map->old_capacity,
+                                   stats, &total_probes);
+    }
+    stats->mean_probe_length = hash_map->size != 0 ? (double)total_probes / (double)hash_map->size : 0.0;
 }
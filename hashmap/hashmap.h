@@ -7,25 +7,100 @@
 #include <stdint.h>
 #include <limits.h>
 #include <string.h>
-#include "../linked_list/linked_list.h"
 #include "../hashing/murmur3.h"
+#include "../hashing/fast_hash.h"
 
-#define HASH_MAP_BUCKET_NUM 500
+#define HASH_MAP_INITIAL_CAPACITY 16   /* slots in a freshly built map (power of two, >= group width) */
+#define HASH_MAP_MAX_LOAD_NUM 7        /* max load factor = NUM / DEN (full + deleted slots) */
+#define HASH_MAP_MAX_LOAD_DEN 8
+#define HASH_MAP_REHASH_STEP_SLOTS 64  /* old-table slots migrated per put/remove (incremental mode) */
+#define HASH_MAP_INLINE_KEY_SIZE 16    /* keys up to this many bytes live inside the HashMapItem */
+#define HASH_MAP_BATCH_WINDOW 16       /* keys hashed + prefetched ahead by the batch APIs */
+#define HASH_MAP_BULK_LOAD_CHUNK 1024  /* keys hashed per pass by hash_map_bulk_load */
+#define HASH_MAP_STATS_PROBE_BUCKETS 8 /* probe-length histogram size (last bucket: this many groups or more) */
+#define HASH_MAP_ARENA_CHUNK_SIZE (64 * 1024) /* bytes per key-arena chunk (bigger blocks get their own) */
+#define HASH_MAP_ARENA_SIZE_CLASSES 72        /* 16-byte steps up to 256, then powers of two */
 #define FAILED_HASH_MAP_ALLOCATION -96
 #define ATTEMPTED_ACCESS_TO_NULL_HASHMAP -95
 #define ATTEMPTED_ACCESS_TO_NULL_HASHMAP_BUCKET -94
 #define TOO_LONG_HASHMAP_KEY -93
+#define HASHMAP_CAPACITY_OVERFLOW -92
 #define MUR_MUR_3_SEED 32
 
+/*
+ * Control bytes (one per slot, see HashMap.ctrl).
+ * FULL slots hold a 7-bit fingerprint of the hash (0x00..0x7F); the two
+ * special values have the high bit set so a group can test "free" at once.
+ */
+#define HASH_MAP_CTRL_EMPTY   0x80  /* never used: terminates a probe sequence */
+#define HASH_MAP_CTRL_DELETED 0xFE  /* tombstone: removed entry, probing continues past it */
+#define HASH_MAP_CTRL_IS_FULL(c) (((c) & 0x80) == 0)
+#define HASH_MAP_H2(h64) ((uint8_t)((h64) >> 57))  /* fingerprint: top 7 bits (the low bits pick the slot) */
+#define HASH_MAP_GROUP_WIDTH 16     /* control bytes scanned per probe step */
+
+/* Hash functions a map can be built with (see build_hash_map_with_hash) */
+#define HASH_MAP_HASH_MURMUR3 0  /* default: MurmurHash3_x64_128, low 64 bits (generate_hash with MUR_MUR_3_SEED) */
+#define HASH_MAP_HASH_FAST64  1  /* fast_hash_64: wyhash-style, 64 bits computed directly */
+#define HASH_MAP_HASH_INT64   2  /* fast_hash_u64 on 8-byte keys (other key sizes use fast_hash_64) */
+
+/* Rehash modes (see hash_map_set_rehash_mode) */
+#define HASH_MAP_REHASH_STOP_THE_WORLD 0  /* default: a growing put moves every item at once */
+#define HASH_MAP_REHASH_INCREMENTAL    1  /* old and new tables coexist; items move a few at a time */
+
 /*
  * ============================================================================
  *  HashMap — Contracts & Ownership
  * ============================================================================
- * - Buckets: array of LinkedList with a sentinel head. A bucket is a logically
- *   empty list when head->data == NULL && head->next == NULL.
+ * - Table: open addressing over a power-of-two array of HashMapItem slots.
+ *   A parallel control-byte array holds, per slot, EMPTY / DELETED or the
+ *   7-bit fingerprint of a FULL slot's hash. Lookups scan
+ *   HASH_MAP_GROUP_WIDTH control bytes per step (SSE2 when available) and
+ *   only touch items whose fingerprint matches.
+ *
+ * - Growth: when FULL + DELETED slots would exceed 7/8 of the capacity the
+ *   table is rehashed, doubling the capacity (or keeping it, if most of the
+ *   pressure comes from tombstones). Lookups stay O(1) on average.
+ *
+ * - Incremental rehash (opt-in, HASH_MAP_REHASH_INCREMENTAL): growth only
+ *   allocates the new table; the old one is kept alongside and every
+ *   hash_map_put()/hash_map_remove() migrates HASH_MAP_REHASH_STEP_SLOTS of
+ *   its slots, so no single call pays for the whole rehash. hash_map_get()
+ *   searches both tables but never migrates. hash_map_rehash_step() lets
+ *   callers drain a pending migration during idle time.
+ *
+ * - Item pointers: HashMapItem structs live INSIDE the table, so a pointer
+ *   returned by hash_map_get() is valid only until the next hash_map_put(),
+ *   hash_map_remove() or hash_map_rehash_step() on the same map (any of them
+ *   may move entries).
+ *
+ * - Iteration: iterators, hash_map_for_each() and hash_map_scan() allocate
+ *   nothing and walk the slot array in memory order (visiting order is
+ *   therefore arbitrary). Anything that MOVES items (a rehash, or a put/remove
+ *   that migrates during an incremental rehash) bumps map->generation:
+ *   iterators then stop, cursors restart their pass. Removing the item just
+ *   returned by an iterator is fine when no migration is pending.
+ *
+ * - Small keys: keys of at most HASH_MAP_INLINE_KEY_SIZE bytes are copied
+ *   into the item itself (item->key then points at item->inline_key), so
+ *   inserting them allocates nothing. Longer keys spill to a heap copy.
+ *
+ * - Key arena (opt-in, build_arena_hash_map()): spilled keys are carved from
+ *   HASH_MAP_ARENA_CHUNK_SIZE chunks owned by the map instead of one malloc
+ *   each. hash_map_remove() puts the block on a per-size-class free list
+ *   that later inserts reuse; hash_map_destroy() frees whole chunks, and with
+ *   a NULL data callback it does not walk the table at all.
+ *
+ * - Allocator hook (opt-in, build_hash_map_with_allocator()): the slot and
+ *   control-byte tables (the bulk of a map's memory) come from a
+ *   caller-supplied allocate/release pair (e.g. memory bound to one NUMA
+ *   node) instead of malloc/free. Spilled keys and the HashMap struct itself
+ *   still use malloc.
  *
- * - Key ownership: the key is ALWAYS deep-copied in hash_map_put() and will
- *   ALWAYS be freed by the map (see hash_map_free_item_with()).
+ * - Hashing: every map hashes with one HASH_MAP_HASH_* function and a 64-bit
+ *   seed, fixed at build time (build_hash_map_with_hash) or changed later with
+ *   hash_map_set_hash (which rehashes). Maps from build_hash_map() use
+ *   Murmur3 with MUR_MUR_3_SEED, i.e. generate_hash(). A random per-map seed
+ *   (hash_map_random_seed) keeps attackers from precomputing colliding keys.
  *
  * Ownership policy:
  * - Keys: the map ALWAYS owns keys. Keys are deep-copied on insertion and freed by the map.
@@ -38,23 +113,116 @@
  * ============================================================================
  */
 
-/* Each entry stored in a bucket's linked list. */
+/*
+ * Bulk-memory hooks of a map (see build_hash_map_with_allocator()).
+ * 'release' receives the size given to the matching 'allocate', which
+ * page-based allocators (mmap, numa_alloc_*) need.
+ */
+typedef struct HashMapAllocator {
+    void* (*allocate)(size_t size, void* ctx);           /* NULL on failure */
+    void  (*release)(void* ptr, size_t size, void* ctx);
+    void*  ctx;                                          /* passed back to both */
+} HashMapAllocator;
+
+/*
+ * Each entry stored in a table slot.
+ * Invariant: key_size <= HASH_MAP_INLINE_KEY_SIZE  <=>  key == inline_key.
+ */
 typedef struct HashMapItem {
     uint64_t hash;      /* 64-bit hash of the key */
-    void*    key;       /* heap copy of the key bytes (ALWAYS owned by the map) */
+    void*    key;       /* key bytes: inline_key or a heap copy (ALWAYS owned by the map) */
     size_t   key_size;  /* key length in bytes */
     void*    data;      /* value pointer (ownership depends on callback presence) */
     size_t   data_size; /* value length in bytes */
+    unsigned char inline_key[HASH_MAP_INLINE_KEY_SIZE]; /* storage for small keys */
 } HashMapItem;
 
 /*
- * HashMap: fixed number of buckets.
- * Each bucket is a LinkedList with a sentinel head (never NULL after build).
+ * HashMap: growable open-addressing table.
+ * slots holds 'capacity' elements and ctrl 'capacity + HASH_MAP_GROUP_WIDTH'
+ * (the tail mirrors the first group); neither is NULL after build.
+ * old_* describe the table being drained by an incremental rehash
+ * (old_slots == NULL when no migration is pending).
  */
 typedef struct HashMap {
-    LinkedList buckets[HASH_MAP_BUCKET_NUM];
+    HashMapItem* slots;        /* entry storage, meaningful only where ctrl[i] is FULL */
+    uint8_t*     ctrl;         /* control byte per slot (+ mirrored first group) */
+    size_t       capacity;     /* number of slots, always a power of two */
+    size_t       size;         /* live entries, in both tables */
+    size_t       tombstones;   /* number of DELETED slots in the current table */
+
+    HashMapItem* old_slots;    /* previous table during an incremental rehash, else NULL */
+    uint8_t*     old_ctrl;     /* control bytes of the old table */
+    size_t       old_capacity; /* slots in the old table (0 when none) */
+    size_t       old_size;     /* live entries not migrated yet */
+    size_t       migrate_pos;  /* next old slot to migrate */
+    int          rehash_mode;  /* HASH_MAP_REHASH_* */
+    size_t       generation;   /* bumped whenever items move or tables are swapped */
+    size_t       key_heap_bytes; /* bytes of spilled (non-inline) key copies */
+    struct HashMapKeyArena* key_arena; /* spilled-key allocator, NULL = one malloc per key */
+    int          hash_kind;    /* HASH_MAP_HASH_* */
+    uint64_t     hash_seed;    /* seed fed to the hash function */
+    HashMapAllocator allocator; /* table memory; allocate == NULL → malloc/free */
 } HashMap;
 
+/* Chunk of a key arena; block storage follows the (16-byte aligned) header. */
+typedef struct HashMapArenaChunk {
+    struct HashMapArenaChunk* next;
+    size_t                    size;  /* bytes of block storage after the header */
+} HashMapArenaChunk;
+
+/*
+ * Per-map allocator for spilled keys (see build_arena_hash_map()).
+ * Blocks are bump-allocated from the newest chunk; freed blocks are threaded
+ * through their first bytes onto free_lists[size class].
+ */
+typedef struct HashMapKeyArena {
+    HashMapArenaChunk* chunks;         /* every chunk, newest first */
+    unsigned char*     cursor;         /* next free byte in the newest shared chunk */
+    size_t             remaining;      /* bytes left after cursor */
+    void*              free_lists[HASH_MAP_ARENA_SIZE_CLASSES];
+    size_t             reserved_bytes; /* chunk bytes obtained from malloc */
+} HashMapKeyArena;
+
+/*
+ * Snapshot returned by hash_map_stats(). Probe lengths count control-byte
+ * groups scanned to reach an entry (1 = found in its home group); entries
+ * still in the old table of an incremental rehash are measured there.
+ */
+typedef struct HashMapStats {
+    size_t entries;            /* live entries (both tables) */
+    size_t capacity;           /* slots in the current table */
+    size_t tombstones;         /* DELETED slots in the current table */
+    size_t old_capacity;       /* slots in the old table (0 when not rehashing) */
+    size_t old_entries;        /* entries not migrated yet */
+    size_t table_bytes;        /* slot + control-byte arrays of both tables */
+    size_t key_heap_bytes;     /* heap copies of keys longer than HASH_MAP_INLINE_KEY_SIZE (arena: chunk bytes) */
+    size_t total_bytes;        /* HashMap struct + table_bytes + key_heap_bytes (data not included) */
+    double load_factor;        /* (current-table entries + tombstones) / capacity */
+    size_t max_probe_length;
+    double mean_probe_length;
+    size_t probe_histogram[HASH_MAP_STATS_PROBE_BUCKETS]; /* [i] = entries found after i+1 groups */
+} HashMapStats;
+
+/*
+ * Allocation-free iterator over a HashMap (lives on the caller's stack).
+ * Visits the current table, then the old one while a migration is pending,
+ * each in memory order.
+ */
+typedef struct HashMapIterator {
+    const HashMap* map;
+    size_t         position;   /* next virtual slot index to look at */
+    size_t         generation; /* map->generation at init */
+} HashMapIterator;
+
+/* Resumable cursor for hash_map_scan(), to walk a map in bounded slices. */
+typedef struct HashMapCursor {
+    size_t position;   /* next virtual slot index to look at */
+    size_t generation; /* map->generation when the current pass (re)started */
+    int    started;    /* 0 until the first hash_map_scan() call */
+    size_t restarts;   /* passes restarted because items moved between slices */
+} HashMapCursor;
+
 /* ------------------------------------------------------------------------- */
 /*                               API – Prototypes                            */
 /* ------------------------------------------------------------------------- */
@@ -62,9 +230,68 @@ typedef struct HashMap {
 /* Compute a 64-bit hash for 'key' using MurmurHash3_x64_128 (lower 64 bits). */
 uint64_t generate_hash(const void* key, size_t key_size);
 
-/* Build a new hash map with HASH_MAP_BUCKET_NUM initialized (empty) buckets. */
+/* Hash 'key' with the HASH_MAP_HASH_* function 'hash_kind' and 'seed' (Murmur3 uses the low 32 bits). */
+uint64_t hash_map_hash_bytes(int hash_kind, uint64_t seed, const void* key, size_t key_size);
+
+/* The hash 'hash_map' stores for 'key' (what the pre-hashed calls expect). */
+uint64_t hash_map_hash_key(const HashMap* hash_map, const void* key, size_t key_size);
+
+/*
+ * A hard-to-guess seed for build_hash_map_with_hash (clock, addresses and a
+ * counter, mixed). Not cryptographic; use a real entropy source if one exists.
+ */
+uint64_t hash_map_random_seed(void);
+
+/* Build a new, empty hash map with HASH_MAP_INITIAL_CAPACITY slots (stop-the-world rehash). */
 HashMap* build_hash_map(void);
 
+/* Same as build_hash_map(), but hashing with 'hash_kind' (HASH_MAP_HASH_*) and 'seed'. */
+HashMap* build_hash_map_with_hash(int hash_kind, uint64_t seed);
+
+/*
+ * Switch the map's hash function / seed. Every stored hash is recomputed and
+ * the table rebuilt (any pending migration is completed first): O(size).
+ * Unknown kinds fall back to HASH_MAP_HASH_MURMUR3.
+ */
+void hash_map_set_hash(HashMap* hash_map, int hash_kind, uint64_t seed);
+
+/* Same as build_hash_map(), but spilled keys come from a per-map arena (see Key arena above). */
+HashMap* build_arena_hash_map(void);
+
+/*
+ * Build an empty map (default hash) whose table already holds
+ * 'expected_entries' without growing (see hash_map_reserve()).
+ */
+HashMap* build_hash_map_with_capacity(size_t expected_entries);
+
+/*
+ * Grow the table once so that 'expected_entries' live entries fit without
+ * any further rehash. Never shrinks.
+ */
+void hash_map_reserve(HashMap* hash_map, size_t expected_entries);
+
+/*
+ * Build an empty map (default hash) whose slot / control-byte tables are
+ * obtained from 'allocator' (copied; its ctx must outlive the map).
+ * NULL or a hook with NULL functions means malloc/free.
+ */
+HashMap* build_hash_map_with_allocator(const HashMapAllocator* allocator);
+
+/*
+ * Select the rehash mode: HASH_MAP_REHASH_STOP_THE_WORLD or HASH_MAP_REHASH_INCREMENTAL.
+ * Switching to stop-the-world completes any pending migration immediately.
+ */
+void hash_map_set_rehash_mode(HashMap* hash_map, int rehash_mode);
+
+/*
+ * Migrate up to 'max_slots' old-table slots during an incremental rehash.
+ * Returns: 1 if a migration is still pending afterwards; 0 otherwise.
+ */
+int hash_map_rehash_step(HashMap* hash_map, size_t max_slots);
+
+/* Returns 1 while an incremental migration is in progress, 0 otherwise. */
+int hash_map_is_rehashing(const HashMap* hash_map);
+
 /* Destroy the entire map; optionally deep-free each item's data via callback. */
 void hash_map_destroy(HashMap* hash_map,
                       void (*deep_deallocate_hashmap_item_data)(void* node_data));
@@ -73,6 +300,7 @@ void hash_map_destroy(HashMap* hash_map,
  * Insert or update (upsert) an entry.
  * Returns: 1 if updated an existing key; 0 if inserted a new key.
  * Ownership: key is always deep-copied; data ownership follows the callback rule above.
+ * May grow (rehash) the table.
  */
 int hash_map_put(HashMap* hash_map,
                  const void* key,
@@ -94,16 +322,169 @@ int hash_map_remove(HashMap* hash_map,
 /*
  * Lookup an entry by key.
  * Returns: a const internal pointer to the stored HashMapItem, or NULL if not found.
- * IMPORTANT: do NOT modify or free the returned pointer; lifetime is managed by the map.
+ * IMPORTANT: do NOT modify or free the returned pointer; lifetime is managed by the map
+ *            and it is invalidated by the next put/remove/rehash_step on this map.
  */
 const HashMapItem* hash_map_get(HashMap* hash_map,
                                 const void* key,
                                 size_t key_size);
 
+/*
+ * Get-or-insert (emplace) in a single probe.
+ * Returns: a MUTABLE pointer to the stored item for 'key'. If the key was
+ * absent it is deep-copied into a new item with data = NULL, data_size = 0
+ * and *inserted is set to 1; otherwise the item is returned untouched and
+ * *inserted is 0 ('inserted' may be NULL).
+ * The caller may overwrite item->data / item->data_size in place (same
+ * ownership rules as hash_map_put: pass the callback to later remove/destroy
+ * calls for values the map should free); hash, key and key_size are read-only.
+ * The pointer is invalidated by the next put/remove/rehash_step on this map.
+ */
+HashMapItem* hash_map_get_or_insert(HashMap* hash_map,
+                                    const void* key,
+                                    size_t key_size,
+                                    int* inserted);
+
+/*
+ * Read-modify-write in a single probe: runs update(item, inserted, ctx) on
+ * the item found or inserted as by hash_map_get_or_insert() (a new item has
+ * data = NULL, data_size = 0). 'update' may change data / data_size in place
+ * and must not call back into the same map.
+ * Returns: 1 if the key already existed; 0 if it was inserted (as hash_map_put).
+ */
+int hash_map_upsert_with(HashMap* hash_map,
+                         const void* key,
+                         size_t key_size,
+                         void (*update)(HashMapItem* item, int inserted, void* ctx),
+                         void* ctx);
+
+/*
+ * Pre-hashed variants of put / remove / get, for callers that already hashed
+ * the key upstream (e.g. to route it): they skip hashing.
+ * 'hash' MUST equal hash_map_hash_key(hash_map, key, key_size) (generate_hash()
+ * for default maps); any other value makes the entry unreachable for the
+ * plain calls (and vice versa).
+ * Return values, ownership and pointer lifetime are those of the plain calls.
+ */
+int hash_map_put_prehashed(HashMap* hash_map,
+                           uint64_t hash,
+                           const void* key,
+                           size_t key_size,
+                           const void* data,
+                           size_t data_size,
+                           void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+int hash_map_remove_prehashed(HashMap* hash_map,
+                              uint64_t hash,
+                              const void* key,
+                              size_t key_size,
+                              void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+const HashMapItem* hash_map_get_prehashed(HashMap* hash_map,
+                                          uint64_t hash,
+                                          const void* key,
+                                          size_t key_size);
+
+/*
+ * Batch lookup: out_items[i] = hash_map_get(keys[i], key_sizes[i]) for i < count.
+ * Keys are hashed and their table lines prefetched a window at a time, so the
+ * cache misses of different keys overlap. Lookups never move items: all the
+ * returned pointers stay valid together until the next put/remove/rehash_step.
+ */
+void hash_map_get_batch(HashMap* hash_map,
+                        const void* const* keys,
+                        const size_t* key_sizes,
+                        size_t count,
+                        const HashMapItem** out_items);
+
+/*
+ * Batch upsert, equivalent to hash_map_put() on each key in order (later
+ * duplicates win). 'data' / 'data_sizes' may be NULL (NULL values, size 0).
+ * Returns: how many keys already existed (were updated).
+ */
+size_t hash_map_put_batch(HashMap* hash_map,
+                          const void* const* keys,
+                          const size_t* key_sizes,
+                          const void* const* data,
+                          const size_t* data_sizes,
+                          size_t count,
+                          void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Batch removal, equivalent to hash_map_remove() on each key in order.
+ * Returns: how many entries were removed.
+ */
+size_t hash_map_remove_batch(HashMap* hash_map,
+                             const void* const* keys,
+                             const size_t* key_sizes,
+                             size_t count,
+                             void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Bulk load 'count' entries: sizes the table once for all of them, hashes the
+ * keys in a tight loop and places them with prefetching. 'data' / 'data_sizes'
+ * may be NULL (NULL values, size 0).
+ * keys_are_unique != 0 is the CALLER'S PROMISE that no key repeats and none
+ * is already in the map: entries are then placed without any key comparison.
+ * Breaking it leaves duplicate entries (only one of them reachable).
+ * With keys_are_unique == 0 it behaves like hash_map_put_batch().
+ * Returns: how many keys already existed (always 0 with keys_are_unique).
+ */
+size_t hash_map_bulk_load(HashMap* hash_map,
+                          const void* const* keys,
+                          const size_t* key_sizes,
+                          const void* const* data,
+                          const size_t* data_sizes,
+                          size_t count,
+                          int keys_are_unique,
+                          void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/* Start iterating 'hash_map'. */
+void hash_map_iterator_init(HashMapIterator* it, const HashMap* hash_map);
+
+/*
+ * Next entry, or NULL when done. Also returns NULL once the map moved items
+ * since init (see hash_map_iterator_invalidated()).
+ */
+const HashMapItem* hash_map_iterator_next(HashMapIterator* it);
+
+/* Returns 1 if the iteration was cut short because the map moved items, 0 otherwise. */
+int hash_map_iterator_invalidated(const HashMapIterator* it);
+
+/* Call visit(item, ctx) on every entry; 'visit' must not modify the map. */
+void hash_map_for_each(const HashMap* hash_map,
+                       void (*visit)(const HashMapItem* item, void* ctx),
+                       void* ctx);
+
+/* Reset a cursor to the beginning of a new pass. */
+void hash_map_cursor_init(HashMapCursor* cursor);
+
+/*
+ * Resumable scan: visits the entries stored in the next 'max_slots' slots
+ * after the cursor, then returns. Call again with the same cursor to go on;
+ * the map may be modified between calls (not from inside 'visit').
+ * Entries present and unmoved for the whole pass are visited exactly once;
+ * entries added or removed meanwhile may or may not be. If items moved between
+ * slices, the pass starts over (cursor->restarts counts it).
+ * Returns: 1 while slots remain to be scanned; 0 when the pass is complete.
+ */
+int hash_map_scan(const HashMap* hash_map,
+                  HashMapCursor* cursor,
+                  size_t max_slots,
+                  void (*visit)(const HashMapItem* item, void* ctx),
+                  void* ctx);
+
+/*
+ * Fill 'stats' (see HashMapStats). Counts and byte totals are O(1) (kept by
+ * put/remove); the probe-length figures walk the table, O(capacity).
+ */
+void hash_map_stats(const HashMap* hash_map, HashMapStats* stats);
+
 /*
  * Allocate a HashMapItem on the heap and perform a SHALLOW struct copy of 'value'.
  * NOTE: This does NOT clone the key/data buffers; callers should ensure that 'value'
  *       already contains the desired (e.g., deep-copied) pointers.
+ *       Small keys travel with the struct: the copy's key is re-pointed to its own inline_key.
  * Return type is void* for convenient use with generic linked list APIs.
  */
 void* ll_alloc_HashMapItem(HashMapItem value);
@@ -0,0 +1,259 @@
+#ifndef HASHMAP_CTRL_H
+#define HASHMAP_CTRL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hashmap.h"
+
+/*
+ * ============================================================================
+ *  Control-byte primitives shared by the open-addressing maps
+ * ============================================================================
+ * Internal header: HashMap (hashmap.c), the typed maps (typed_hashmap.c) and
+ * HashSet (../hashset/hashset.c) share the same table layout: 'capacity'
+ * slots (power of two) plus capacity + HASH_MAP_GROUP_WIDTH control bytes,
+ * the tail mirroring the first group, scanned HASH_MAP_GROUP_WIDTH bytes at
+ * a time along a triangular probe sequence. Only the slot type differs, so everything that
+ * looks at control bytes alone lives here as static inline functions; the
+ * probe loops and the rehash, which also touch slots, are instantiated per
+ * slot type from hashmap_table_impl.h.
+ * ============================================================================
+ */
+
+/* SSE2 group scanning (x86-64 always has it); HASH_MAP_NO_SIMD forces the portable path */
+#if !defined(HASH_MAP_NO_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HASH_MAP_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define HASH_MAP_USE_SSE2 0
+#endif
+
+/* 'hash_kind' if it names a known HASH_MAP_HASH_* function, HASH_MAP_HASH_MURMUR3 otherwise. */
+static inline int hash_map_normalize_hash_kind(int hash_kind) {
+    return hash_kind == HASH_MAP_HASH_FAST64 || hash_kind == HASH_MAP_HASH_INT64
+         ? hash_kind : HASH_MAP_HASH_MURMUR3;
+}
+
+/* Maximum number of FULL + DELETED slots allowed for a given capacity (7/8). */
+static inline size_t hash_map_max_used(size_t capacity) {
+    return capacity / HASH_MAP_MAX_LOAD_DEN * HASH_MAP_MAX_LOAD_NUM;
+}
+
+/*
+ * Smallest power-of-two capacity (>= HASH_MAP_INITIAL_CAPACITY) holding
+ * 'entries' slots of 'slot_size' bytes under the load limit.
+ */
+static inline size_t hash_map_capacity_for(size_t entries, size_t slot_size) {
+    size_t capacity = HASH_MAP_INITIAL_CAPACITY;
+    while (hash_map_max_used(capacity) < entries) {
+        if (capacity > SIZE_MAX / 2 / slot_size) {
+            fprintf(stderr, "Hash table capacity overflow: cannot size a table for %zu entries\n", entries);
+            exit(HASHMAP_CAPACITY_OVERFLOW);
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/*
+ * Growth policy of every table: the capacity to rehash into when one more
+ * entry would push FULL + DELETED past the load limit. Doubles when the live
+ * entries alone would fill more than half the allowed load; otherwise keeps
+ * the size, and the rehash in place just flushes the tombstones.
+ */
+static inline size_t hash_map_grown_capacity(size_t capacity, size_t size) {
+    if (size + 1 <= hash_map_max_used(capacity) / 2) return capacity;
+    if (capacity > SIZE_MAX / 2) {
+        fprintf(stderr, "Hash table capacity overflow: cannot grow beyond %zu slots\n", capacity);
+        exit(HASHMAP_CAPACITY_OVERFLOW);
+    }
+    return capacity * 2;
+}
+
+/*
+ * Decides whether a new key may take 'insert_at' (the first EMPTY/DELETED
+ * slot met while probing, or 'capacity' if none). Reusing a tombstone never
+ * changes FULL + DELETED, so it is always allowed and consumes the tombstone
+ * (*tombstones is decremented); taking an EMPTY slot must stay under the load
+ * limit. Returns 1 if the slot can be used, 0 if the table must grow first.
+ */
+static inline int hash_map_table_claim(const uint8_t* ctrl, size_t capacity, size_t insert_at,
+                                       size_t size, size_t* tombstones) {
+    if (insert_at != capacity && ctrl[insert_at] == HASH_MAP_CTRL_DELETED) {
+        (*tombstones)--;
+        return 1;
+    }
+    return insert_at != capacity && size + *tombstones + 1 <= hash_map_max_used(capacity);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                      Control-byte groups (fingerprints)                    */
+/* ------------------------------------------------------------------------- */
+
+/* Index of the lowest set bit of a non-zero group mask. */
+static inline unsigned hash_map_ctz(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned n = 0;
+    while ((mask & 1u) == 0) { mask >>= 1; n++; }
+    return n;
+#endif
+}
+
+/* Number of leading zero bits of a group mask seen as HASH_MAP_GROUP_WIDTH bits wide. */
+static inline unsigned hash_map_group_clz(uint32_t mask) {
+    unsigned n = 0;
+    for (uint32_t bit = 1u << (HASH_MAP_GROUP_WIDTH - 1); bit != 0 && (mask & bit) == 0; bit >>= 1) {
+        n++;
+    }
+    return n;
+}
+
+#if HASH_MAP_USE_SSE2
+
+/* Bit i set <=> ctrl[i] == h2 (exact). */
+static inline uint32_t hash_map_group_match(const uint8_t* group, uint8_t h2) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)(const void*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+}
+
+/* Bit i set <=> ctrl[i] == EMPTY. */
+static inline uint32_t hash_map_group_match_empty(const uint8_t* group) {
+    return hash_map_group_match(group, HASH_MAP_CTRL_EMPTY);
+}
+
+/* Bit i set <=> ctrl[i] is EMPTY or DELETED (both have the high bit set). */
+static inline uint32_t hash_map_group_match_free(const uint8_t* group) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)(const void*)group);
+    return (uint32_t)_mm_movemask_epi8(ctrl);
+}
+
+#else /* portable SWAR: two 8-byte words per group */
+
+#define HASH_MAP_LSB 0x0101010101010101ULL
+#define HASH_MAP_MSB 0x8080808080808080ULL
+
+/* Packs the high bit of each byte of 'word' into an 8-bit mask (byte i → bit i). */
+static inline uint32_t hash_map_swar_pack(uint64_t word) {
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < 8; i++) {
+        mask |= (uint32_t)((word >> (i * 8 + 7)) & 1u) << i;
+    }
+    return mask;
+}
+
+/* Loads byte i of the group into byte i of the word, whatever the host endianness. */
+static inline uint64_t hash_map_swar_load(const uint8_t* bytes) {
+    uint64_t word = 0;
+    for (unsigned i = 0; i < 8; i++) {
+        word |= (uint64_t)bytes[i] << (i * 8);
+    }
+    return word;
+}
+
+/*
+ * Bit i set if ctrl[i] == h2. The classic zero-byte trick can report a false
+ * positive next to a true match; callers verify candidates anyway.
+ */
+static inline uint32_t hash_map_group_match(const uint8_t* group, uint8_t h2) {
+    uint32_t mask = 0;
+    for (unsigned half = 0; half < 2; half++) {
+        uint64_t x = hash_map_swar_load(group + half * 8) ^ (HASH_MAP_LSB * h2);
+        mask |= hash_map_swar_pack((x - HASH_MAP_LSB) & ~x & HASH_MAP_MSB) << (half * 8);
+    }
+    return mask;
+}
+
+/* Bit i set <=> ctrl[i] == EMPTY (0x80: high bit set, bit 1 clear; DELETED has bit 1 set). */
+static inline uint32_t hash_map_group_match_empty(const uint8_t* group) {
+    uint32_t mask = 0;
+    for (unsigned half = 0; half < 2; half++) {
+        uint64_t w = hash_map_swar_load(group + half * 8);
+        mask |= hash_map_swar_pack(w & ~(w << 6) & HASH_MAP_MSB) << (half * 8);
+    }
+    return mask;
+}
+
+/* Bit i set <=> ctrl[i] is EMPTY or DELETED. */
+static inline uint32_t hash_map_group_match_free(const uint8_t* group) {
+    uint32_t mask = 0;
+    for (unsigned half = 0; half < 2; half++) {
+        mask |= hash_map_swar_pack(hash_map_swar_load(group + half * 8) & HASH_MAP_MSB) << (half * 8);
+    }
+    return mask;
+}
+
+#endif /* HASH_MAP_USE_SSE2 */
+
+/* Bit i set <=> ctrl[i] is FULL (both implementations). */
+static inline uint32_t hash_map_group_match_full(const uint8_t* group) {
+    return ~hash_map_group_match_free(group) & ((1u << HASH_MAP_GROUP_WIDTH) - 1u);
+}
+
+/*
+ * Writes control byte 'value' for slot 'index', keeping the mirrored copy of
+ * the first HASH_MAP_GROUP_WIDTH bytes (stored after the end) in sync.
+ */
+static inline void hash_map_set_ctrl(uint8_t* ctrl, size_t capacity, size_t index, uint8_t value) {
+    ctrl[index] = value;
+    if (index < HASH_MAP_GROUP_WIDTH) {
+        ctrl[capacity + index] = value;
+    }
+}
+
+/*
+ * Returns the first EMPTY or DELETED slot on the probe sequence of 'h64'.
+ * Only valid for keys known to be absent from the table (rehash/migration).
+ */
+static inline size_t hash_map_table_free_slot(const uint8_t* ctrl, size_t capacity, uint64_t h64) {
+    const size_t mask = capacity - 1;
+    size_t pos = (size_t)h64 & mask;
+
+    for (size_t probe = 1; ; probe++) {
+        uint32_t free_mask = hash_map_group_match_free(ctrl + pos);
+        if (free_mask != 0) {
+            return (pos + hash_map_ctz(free_mask)) & mask;
+        }
+        pos = (pos + probe * HASH_MAP_GROUP_WIDTH) & mask;
+    }
+}
+
+/*
+ * Frees slot 'index' of a table. It can go straight back to EMPTY when every
+ * group-sized window containing it still holds an EMPTY byte: then no probe
+ * sequence ever walked past it, and nothing stored later depends on it.
+ * Otherwise it becomes a tombstone (DELETED) so farther keys stay reachable.
+ * Returns 1 if a tombstone was left, 0 otherwise.
+ */
+static inline int hash_map_table_vacate(uint8_t* ctrl, size_t capacity, size_t index) {
+    const size_t index_before = (index - HASH_MAP_GROUP_WIDTH) & (capacity - 1);
+    uint32_t empty_after  = hash_map_group_match_empty(ctrl + index);
+    uint32_t empty_before = hash_map_group_match_empty(ctrl + index_before);
+
+    int was_never_full = empty_before != 0 && empty_after != 0 &&
+        hash_map_ctz(empty_after) + hash_map_group_clz(empty_before) < HASH_MAP_GROUP_WIDTH;
+
+    hash_map_set_ctrl(ctrl, capacity, index, was_never_full ? HASH_MAP_CTRL_EMPTY : HASH_MAP_CTRL_DELETED);
+    return was_never_full ? 0 : 1;
+}
+
+/*
+ * Index of the first FULL slot of 'ctrl' at or after 'from' (< capacity),
+ * or 'capacity' if none. Tables are power-of-two sized and at least one
+ * group wide, so groups starting at multiples of the width never straddle.
+ */
+static inline size_t hash_map_next_full(const uint8_t* ctrl, size_t capacity, size_t from) {
+    while (from < capacity) {
+        size_t base = from & ~(size_t)(HASH_MAP_GROUP_WIDTH - 1);
+        uint32_t full = hash_map_group_match_full(ctrl + base) & (~0u << (from - base));
+        if (full != 0) return base + hash_map_ctz(full);
+        from = base + HASH_MAP_GROUP_WIDTH;
+    }
+    return capacity;
+}
+
+#endif /* HASHMAP_CTRL_H */
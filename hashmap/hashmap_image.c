@@ -0,0 +1,334 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  /* mmap & co. under -std=c11 */
+#endif
+
+#include "hashmap_image.h"
+#include "hashmap_ctrl.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* ------------------------------------------------------------------------- */
+/*                              Internal helpers                             */
+/* ------------------------------------------------------------------------- */
+
+static inline uint64_t hash_map_image_align8(uint64_t n) {
+    return (n + 7u) & ~(uint64_t)7u;
+}
+
+/* Smallest power-of-two capacity (>= HASH_MAP_GROUP_WIDTH) keeping the load at or below 1/2. */
+static size_t hash_map_image_capacity_for(size_t entries) {
+    size_t capacity = HASH_MAP_GROUP_WIDTH;
+    while (capacity / 2 < entries) {
+        if (capacity > SIZE_MAX / 2) {
+            fprintf(stderr, "Hash map image: capacity overflow for %zu entries\n", entries);
+            exit(HASHMAP_CAPACITY_OVERFLOW);
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/* Writes 'size' bytes (or zero padding when bytes == NULL). Returns 0 on success. */
+static int hash_map_image_write(FILE* file, const void* bytes, size_t size) {
+    static const unsigned char zeros[8] = { 0 };
+    if (size == 0) return 0;
+    if (bytes == NULL) return fwrite(zeros, 1, size, file) == size ? 0 : HASH_MAP_IMAGE_IO_ERROR;
+    return fwrite(bytes, 1, size, file) == size ? 0 : HASH_MAP_IMAGE_IO_ERROR;
+}
+
+/* Pads the file with zeros up to the next multiple of 8 given its current 'offset'. */
+static int hash_map_image_pad(FILE* file, uint64_t offset) {
+    return hash_map_image_write(file, NULL, (size_t)(hash_map_image_align8(offset) - offset));
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                    Save                                   */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Two passes over the live map (iterator, no copy of the entries):
+ *   1) lay out records + blob offsets and place each record in the new table;
+ *   2) stream header, ctrl, index, records and then the blob to the file.
+ */
+int hash_map_save(const HashMap* hash_map, const char* path) {
+    if (hash_map == NULL) {
+        fprintf(stderr, "hash_map_save called on a NULL hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+    if (hash_map->size > UINT32_MAX) return HASH_MAP_IMAGE_TOO_LARGE;
+
+    const size_t entries  = hash_map->size;
+    const size_t capacity = hash_map_image_capacity_for(entries);
+    const size_t mask     = capacity - 1;
+
+    uint8_t*            ctrl    = malloc(capacity);
+    uint32_t*           index   = calloc(capacity, sizeof(uint32_t));
+    HashMapImageRecord* records = malloc((entries ? entries : 1) * sizeof(HashMapImageRecord));
+    if (ctrl == NULL || index == NULL || records == NULL) {
+        fprintf(stderr, "Failed malloc while trying to lay out a hash map image\n");
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+    memset(ctrl, HASH_MAP_IMAGE_CTRL_EMPTY, capacity);
+
+    /* pass 1: records, blob layout, table placement */
+    HashMapIterator it;
+    uint64_t blob_size = 0;
+    size_t n = 0;
+    int rc = 0;
+    hash_map_iterator_init(&it, hash_map);
+    for (const HashMapItem* item = hash_map_iterator_next(&it); item != NULL; item = hash_map_iterator_next(&it), n++) {
+        if (item->data == NULL && item->data_size > 0) rc = HASH_MAP_IMAGE_BAD_VALUE;
+
+        HashMapImageRecord* r = &records[n];
+        r->hash        = item->hash;
+        r->key_offset  = blob_size;
+        r->key_size    = item->key_size;
+        blob_size      = hash_map_image_align8(blob_size + item->key_size);
+        r->data_offset = blob_size;
+        r->data_size   = item->data_size;
+        blob_size      = hash_map_image_align8(blob_size + item->data_size);
+
+        size_t slot = (size_t)item->hash & mask;
+        while (ctrl[slot] != HASH_MAP_IMAGE_CTRL_EMPTY) slot = (slot + 1) & mask;
+        ctrl[slot]  = HASH_MAP_H2(item->hash);
+        index[slot] = (uint32_t)n;
+    }
+
+    FILE* file = NULL;
+    if (rc == 0) {
+        file = fopen(path, "wb");
+        if (file == NULL) {
+            fprintf(stderr, "hash_map_save: cannot open '%s' for writing\n", path);
+            rc = HASH_MAP_IMAGE_IO_ERROR;
+        }
+    }
+
+    if (rc == 0) {
+        HashMapImageHeader header;
+        memset(&header, 0, sizeof header);
+        memcpy(header.magic, HASH_MAP_IMAGE_MAGIC, sizeof header.magic);
+        header.byte_order     = HASH_MAP_IMAGE_BYTE_ORDER;
+        header.version        = HASH_MAP_IMAGE_VERSION;
+        header.hash_kind      = (uint32_t)hash_map->hash_kind;
+        header.hash_seed      = hash_map->hash_seed;
+        header.capacity       = capacity;
+        header.entries        = entries;
+        header.ctrl_offset    = hash_map_image_align8(sizeof header);
+        header.index_offset   = hash_map_image_align8(header.ctrl_offset + capacity);
+        header.records_offset = hash_map_image_align8(header.index_offset + capacity * sizeof(uint32_t));
+        header.blob_offset    = hash_map_image_align8(header.records_offset + entries * sizeof(HashMapImageRecord));
+        header.blob_size      = blob_size;
+
+        /* pass 2: stream everything (the sizes above are already multiples of 8 but pad anyway) */
+        rc = hash_map_image_write(file, &header, sizeof header);
+        if (rc == 0) rc = hash_map_image_pad(file, sizeof header);
+        if (rc == 0) rc = hash_map_image_write(file, ctrl, capacity);
+        if (rc == 0) rc = hash_map_image_pad(file, header.ctrl_offset + capacity);
+        if (rc == 0) rc = hash_map_image_write(file, index, capacity * sizeof(uint32_t));
+        if (rc == 0) rc = hash_map_image_pad(file, header.index_offset + capacity * sizeof(uint32_t));
+        if (rc == 0) rc = hash_map_image_write(file, records, entries * sizeof(HashMapImageRecord));
+        if (rc == 0) rc = hash_map_image_pad(file, header.records_offset + entries * sizeof(HashMapImageRecord));
+
+        hash_map_iterator_init(&it, hash_map);
+        for (const HashMapItem* item = hash_map_iterator_next(&it); rc == 0 && item != NULL; item = hash_map_iterator_next(&it)) {
+            rc = hash_map_image_write(file, item->key, item->key_size);
+            if (rc == 0) rc = hash_map_image_pad(file, item->key_size);
+            if (rc == 0) rc = hash_map_image_write(file, item->data, item->data_size);
+            if (rc == 0) rc = hash_map_image_pad(file, item->data_size);
+        }
+
+        if (fclose(file) != 0 && rc == 0) rc = HASH_MAP_IMAGE_IO_ERROR;
+        if (rc != 0) fprintf(stderr, "hash_map_save: failed writing '%s'\n", path);
+    }
+
+    free(ctrl);
+    free(index);
+    free(records);
+    return rc;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                Open / close                               */
+/* ------------------------------------------------------------------------- */
+
+/* 1 if 'count' elements of 'elem_size' bytes at 'offset' lie inside 'length' bytes (no wrap-around). */
+static int hash_map_image_section_fits(uint64_t offset, uint64_t count, uint64_t elem_size, size_t length) {
+    if (offset > length) return 0;
+    return count <= ((uint64_t)length - offset) / elem_size;
+}
+
+/* Checks the header and that every section lies inside the file. Returns 1 if usable. */
+static int hash_map_image_validate(const unsigned char* base, size_t length) {
+    if (length < sizeof(HashMapImageHeader)) return 0;
+
+    const HashMapImageHeader* h = (const HashMapImageHeader*)(const void*)base;
+    if (memcmp(h->magic, HASH_MAP_IMAGE_MAGIC, sizeof h->magic) != 0) return 0;
+    if (h->byte_order != HASH_MAP_IMAGE_BYTE_ORDER) return 0;
+    if (h->version != HASH_MAP_IMAGE_VERSION) return 0;
+    if (h->hash_kind > INT_MAX || hash_map_normalize_hash_kind((int)h->hash_kind) != (int)h->hash_kind) return 0;
+
+    uint64_t capacity = h->capacity;
+    if (capacity < HASH_MAP_GROUP_WIDTH || (capacity & (capacity - 1)) != 0 || capacity > length) return 0;
+    if (h->entries > capacity / 2) return 0;
+
+    if (h->ctrl_offset % 8 || h->index_offset % 8 || h->records_offset % 8 || h->blob_offset % 8) return 0;
+    if (h->ctrl_offset < sizeof(HashMapImageHeader)) return 0;
+
+    /* each section is checked against the file on its own: header fields are untrusted, sums could wrap */
+    if (!hash_map_image_section_fits(h->ctrl_offset, capacity, 1, length)) return 0;
+    if (!hash_map_image_section_fits(h->index_offset, capacity, sizeof(uint32_t), length)) return 0;
+    if (!hash_map_image_section_fits(h->records_offset, h->entries, sizeof(HashMapImageRecord), length)) return 0;
+    if (!hash_map_image_section_fits(h->blob_offset, h->blob_size, 1, length)) return 0;
+
+    /* sections are in file order and disjoint (every sum below is <= length now) */
+    if (h->index_offset < h->ctrl_offset + capacity) return 0;
+    if (h->records_offset < h->index_offset + capacity * sizeof(uint32_t)) return 0;
+    if (h->blob_offset < h->records_offset + h->entries * sizeof(HashMapImageRecord)) return 0;
+    return 1;
+}
+
+MappedHashMap* hash_map_open_mmap(const char* path) {
+    if (path == NULL) return NULL;
+
+    MappedHashMap* map = malloc(sizeof(MappedHashMap));
+    if (map == NULL) {
+        fprintf(stderr, "Failed malloc while trying to open a mapped hash map\n");
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "hash_map_open_mmap: cannot open '%s'\n", path);
+        free(map);
+        return NULL;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0 ||
+        (unsigned long long)file_size.QuadPart > (unsigned long long)SIZE_MAX) {
+        fprintf(stderr, "hash_map_open_mmap: '%s' is empty or too large\n", path);
+        CloseHandle(file);
+        free(map);
+        return NULL;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* base = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (base == NULL) {
+        fprintf(stderr, "hash_map_open_mmap: cannot map '%s'\n", path);
+        if (mapping != NULL) CloseHandle(mapping);
+        CloseHandle(file);
+        free(map);
+        return NULL;
+    }
+    map->file_handle    = file;
+    map->mapping_handle = mapping;
+    map->length         = (size_t)file_size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "hash_map_open_mmap: cannot open '%s'\n", path);
+        free(map);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || (unsigned long long)st.st_size > (unsigned long long)SIZE_MAX) {
+        fprintf(stderr, "hash_map_open_mmap: '%s' is empty or too large\n", path);
+        close(fd);
+        free(map);
+        return NULL;
+    }
+    void* base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  /* the mapping keeps the file alive */
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "hash_map_open_mmap: cannot map '%s'\n", path);
+        free(map);
+        return NULL;
+    }
+    map->length = (size_t)st.st_size;
+#endif
+
+    map->base = (const unsigned char*)base;
+    if (!hash_map_image_validate(map->base, map->length)) {
+        fprintf(stderr, "hash_map_open_mmap: '%s' is not a valid hash map image for this host\n", path);
+        hash_map_close_mmap(map);
+        return NULL;
+    }
+
+    map->header  = (const HashMapImageHeader*)(const void*)map->base;
+    map->ctrl    = map->base + map->header->ctrl_offset;
+    map->index   = (const uint32_t*)(const void*)(map->base + map->header->index_offset);
+    map->records = (const HashMapImageRecord*)(const void*)(map->base + map->header->records_offset);
+    map->blob    = map->base + map->header->blob_offset;
+    map->mask    = (size_t)map->header->capacity - 1;
+    return map;
+}
+
+void hash_map_close_mmap(MappedHashMap* map) {
+    if (map == NULL) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile((LPCVOID)map->base);
+    CloseHandle((HANDLE)map->mapping_handle);
+    CloseHandle((HANDLE)map->file_handle);
+#else
+    munmap((void*)map->base, map->length);
+#endif
+    free(map);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                   Lookup                                  */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Linear probe over the control bytes: only slots carrying the key's
+ * fingerprint reach the record (and the blob), and an EMPTY byte ends the
+ * search. Record contents are bounds-checked against the blob, so a damaged
+ * image cannot make a lookup read outside the mapping.
+ */
+int mapped_hash_map_get(const MappedHashMap* map,
+                        const void* key,
+                        size_t key_size,
+                        const void** out_data,
+                        size_t* out_data_size) {
+    if (map == NULL) return 0;
+
+    const uint64_t h64 = hash_map_hash_bytes((int)map->header->hash_kind, map->header->hash_seed, key, key_size);
+    const uint8_t  h2  = HASH_MAP_H2(h64);
+    const uint64_t blob_size = map->header->blob_size;
+    size_t slot = (size_t)h64 & map->mask;
+
+    for (size_t probed = 0; probed <= map->mask; probed++, slot = (slot + 1) & map->mask) {
+        uint8_t c = map->ctrl[slot];
+        if (c == HASH_MAP_IMAGE_CTRL_EMPTY) return 0;
+        if (c != h2) continue;
+
+        uint32_t n = map->index[slot];
+        if (n >= map->header->entries) return 0;
+        const HashMapImageRecord* r = &map->records[n];
+        if (r->hash != h64 || r->key_size != key_size) continue;
+        if (r->key_offset > blob_size || r->key_size > blob_size - r->key_offset) return 0;
+        if (key_size != 0 && memcmp(map->blob + r->key_offset, key, key_size) != 0) continue;
+        if (r->data_offset > blob_size || r->data_size > blob_size - r->data_offset) return 0;
+
+        if (out_data != NULL) *out_data = map->blob + r->data_offset;
+        if (out_data_size != NULL) *out_data_size = (size_t)r->data_size;
+        return 1;
+    }
+    return 0;
+}
+
+size_t mapped_hash_map_size(const MappedHashMap* map) {
+    return map != NULL ? (size_t)map->header->entries : 0;
+}
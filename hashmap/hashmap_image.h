@@ -0,0 +1,126 @@
+#ifndef HASHMAP_IMAGE_H
+#define HASHMAP_IMAGE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "hashmap.h"
+
+#define HASH_MAP_IMAGE_MAGIC "CLHMIMG1"  /* 8 bytes, no terminator stored */
+#define HASH_MAP_IMAGE_VERSION 2
+#define HASH_MAP_IMAGE_BYTE_ORDER 0x01020304u
+#define HASH_MAP_IMAGE_CTRL_EMPTY 0x80  /* slot unused (FULL slots hold the 7-bit fingerprint) */
+#define HASH_MAP_IMAGE_IO_ERROR -87
+#define HASH_MAP_IMAGE_BAD_VALUE -86   /* an entry has data_size > 0 but data == NULL */
+#define HASH_MAP_IMAGE_TOO_LARGE -85   /* more entries than a uint32 record index can address */
+
+/*
+ * ============================================================================
+ *  HashMap images — save once, mmap and query with zero parsing
+ * ============================================================================
+ * hash_map_save() writes a read-only, position-independent image of a map;
+ * hash_map_open_mmap() maps it and mapped_hash_map_get() answers lookups
+ * straight from the mapping: opening costs one header check, and every page
+ * is only touched (faulted in) when a lookup needs it.
+ *
+ * File layout (every section 8-byte aligned, all offsets from the file start
+ * except key/data offsets, which are relative to the blob):
+ *
+ *   HashMapImageHeader
+ *   ctrl    [capacity]  uint8   EMPTY (0x80) or the 7-bit fingerprint HASH_MAP_H2(hash)
+ *   index   [capacity]  uint32  record number of a FULL slot
+ *   records [entries]   HashMapImageRecord
+ *   blob                key bytes and value bytes
+ *
+ * The table is rebuilt compactly at save time (no tombstones, load <= 1/2,
+ * linear probing from hash & (capacity - 1)), whatever the live map looked like.
+ *
+ * Values: data_size bytes are copied from each item's data pointer; values
+ * are thus saved by content and read back as (pointer into the mapping, size).
+ *
+ * Portability: integers are stored in the saving host's byte order and the
+ * hash is the saved map's (kind and seed recorded in the header): images are
+ * meant to be read on the same kind of host with the same build.
+ * hash_map_open_mmap() rejects a foreign byte order or an unknown hash kind.
+ * ============================================================================
+ */
+
+typedef struct HashMapImageHeader {
+    char     magic[8];       /* HASH_MAP_IMAGE_MAGIC */
+    uint32_t byte_order;     /* HASH_MAP_IMAGE_BYTE_ORDER as seen by the writer */
+    uint32_t version;        /* HASH_MAP_IMAGE_VERSION */
+    uint32_t hash_kind;      /* HASH_MAP_HASH_* of the saved map */
+    uint32_t reserved;       /* zero */
+    uint64_t hash_seed;      /* the saved map's hash seed */
+    uint64_t capacity;       /* table slots, power of two */
+    uint64_t entries;        /* number of records */
+    uint64_t ctrl_offset;
+    uint64_t index_offset;
+    uint64_t records_offset;
+    uint64_t blob_offset;
+    uint64_t blob_size;
+} HashMapImageHeader;
+
+typedef struct HashMapImageRecord {
+    uint64_t hash;
+    uint64_t key_offset;     /* into the blob */
+    uint64_t key_size;
+    uint64_t data_offset;    /* into the blob */
+    uint64_t data_size;
+} HashMapImageRecord;
+
+/* A read-only map served from a mapped image file. */
+typedef struct MappedHashMap {
+    const unsigned char*      base;     /* start of the mapping */
+    size_t                    length;   /* mapped bytes (file size) */
+    const HashMapImageHeader* header;
+    const uint8_t*            ctrl;
+    const uint32_t*           index;
+    const HashMapImageRecord* records;
+    const unsigned char*      blob;
+    size_t                    mask;     /* capacity - 1 */
+#if defined(_WIN32)
+    void*                     file_handle;
+    void*                     mapping_handle;
+#endif
+} MappedHashMap;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Write an image of 'hash_map' to 'path' (overwritten).
+ * Returns: 0 on success; HASH_MAP_IMAGE_IO_ERROR, HASH_MAP_IMAGE_BAD_VALUE or HASH_MAP_IMAGE_TOO_LARGE
+ *          (the file may then be partially written).
+ */
+int hash_map_save(const HashMap* hash_map, const char* path);
+
+/*
+ * Map an image written by hash_map_save() read-only.
+ * Returns: the mapped map, or NULL (with a message on stderr) if the file
+ *          cannot be mapped or is not a valid image for this host.
+ */
+MappedHashMap* hash_map_open_mmap(const char* path);
+
+/* Unmap the image and free the handle. */
+void hash_map_close_mmap(MappedHashMap* map);
+
+/*
+ * Lookup straight from the mapping.
+ * Returns: 1 if found (and fills *out_data / *out_data_size when non-NULL;
+ *          *out_data points INTO the mapping and lives until hash_map_close_mmap);
+ *          0 otherwise.
+ */
+int mapped_hash_map_get(const MappedHashMap* map,
+                        const void* key,
+                        size_t key_size,
+                        const void** out_data,
+                        size_t* out_data_size);
+
+/* Number of entries in the image. */
+size_t mapped_hash_map_size(const MappedHashMap* map);
+
+#endif /* HASHMAP_IMAGE_H */
@@ -0,0 +1,192 @@
+/*
+ * ============================================================================
+ *  Open-addressing table engine template (no include guard on purpose)
+ * ============================================================================
+ * The probe loops, the insert path (tombstone reuse + growth policy) and the
+ * rehash of the control-byte tables, written once for every slot type:
+ * HashMap (hashmap.c), the typed maps (typed_hashmap_impl.h) and HashSet
+ * (../hashset/hashset.c) all instantiate it. Include after hashmap_ctrl.h.
+ *
+ * Slot layer, always generated. Define:
+ *   HASH_TABLE_PREFIX              function prefix, e.g. hash_set
+ *   HASH_TABLE_SLOT                slot type
+ *   HASH_TABLE_KEY_PARAMS          lookup key parameters, e.g. const void* key, size_t key_size
+ *   HASH_TABLE_KEY_ARGS            the same names as arguments, e.g. key, key_size
+ *   HASH_TABLE_MATCHES(slot, h64)  1 if *slot holds the lookup key (whose hash is h64)
+ * giving PREFIX_table_find and PREFIX_table_probe.
+ *
+ * Container layer, for single-table containers with 'slots', 'ctrl',
+ * 'capacity', 'size' and 'tombstones' members. Also define:
+ *   HASH_TABLE_CONTAINER           container type, e.g. HashSet
+ *   HASH_TABLE_SLOT_HASH(c, slot)  64-bit hash of a stored slot
+ *   HASH_TABLE_SLOT_MOVED(slot)    fix-up after a slot was copied (may be empty)
+ *   HASH_TABLE_LABEL               "Hash set", ... for fatal error messages
+ * giving PREFIX_alloc_table, PREFIX_rehash, PREFIX_reserve, PREFIX_insert_slot
+ * and PREFIX_erase_slot.
+ *
+ * Every parameter is #undef'd at the end, so the file can be included again
+ * for the next slot type.
+ * ============================================================================
+ */
+
+#define HTI_CAT_(a, b) a##b
+#define HTI_CAT(a, b) HTI_CAT_(a, b)
+#define HTI_FN(suffix) HTI_CAT(HASH_TABLE_PREFIX, suffix)
+#define HTI_SLOT HASH_TABLE_SLOT
+
+/*
+ * Looks for the key along its probe sequence in one table.
+ * Returns the slot index holding it, or 'capacity' if absent.
+ * Only slots whose control byte equals the key's fingerprint are compared.
+ * The loop visits each group at most once (capacity / HASH_MAP_GROUP_WIDTH
+ * probes): the load limit guarantees an EMPTY byte well before that, but we
+ * never rely on it for termination.
+ */
+static inline size_t HTI_FN(_table_find)(const HTI_SLOT* slots, const uint8_t* ctrl, size_t capacity,
+                                         uint64_t h64, HASH_TABLE_KEY_PARAMS) {
+    const size_t  mask = capacity - 1;
+    const uint8_t h2   = HASH_MAP_H2(h64);
+    size_t pos = (size_t)h64 & mask;
+
+    for (size_t probe = 1; probe <= capacity / HASH_MAP_GROUP_WIDTH; probe++) {
+        const uint8_t* group = ctrl + pos;
+
+        for (uint32_t match = hash_map_group_match(group, h2); match != 0; match &= match - 1) {
+            size_t index = (pos + hash_map_ctz(match)) & mask;
+            if (HASH_TABLE_MATCHES(&slots[index], h64)) return index;
+        }
+        if (hash_map_group_match_empty(group) != 0) return capacity;
+
+        pos = (pos + probe * HASH_MAP_GROUP_WIDTH) & mask;
+    }
+    return capacity;
+}
+
+/*
+ * Same walk as _table_find, also remembering in *insert_at the first EMPTY or
+ * DELETED slot met ('capacity' if none), so a new key reuses a tombstone
+ * instead of lengthening the chain.
+ * Returns the slot index holding the key, or 'capacity' if absent.
+ */
+static inline size_t HTI_FN(_table_probe)(const HTI_SLOT* slots, const uint8_t* ctrl, size_t capacity,
+                                          uint64_t h64, HASH_TABLE_KEY_PARAMS, size_t* insert_at) {
+    const size_t  mask = capacity - 1;
+    const uint8_t h2   = HASH_MAP_H2(h64);
+    size_t pos = (size_t)h64 & mask;
+    *insert_at = capacity;
+
+    for (size_t probe = 1; probe <= capacity / HASH_MAP_GROUP_WIDTH; probe++) {
+        const uint8_t* group = ctrl + pos;
+
+        for (uint32_t match = hash_map_group_match(group, h2); match != 0; match &= match - 1) {
+            size_t index = (pos + hash_map_ctz(match)) & mask;
+            if (HASH_TABLE_MATCHES(&slots[index], h64)) return index;
+        }
+        if (*insert_at == capacity) {
+            uint32_t free_mask = hash_map_group_match_free(group);
+            if (free_mask != 0) *insert_at = (pos + hash_map_ctz(free_mask)) & mask;
+        }
+        if (hash_map_group_match_empty(group) != 0) break;
+
+        pos = (pos + probe * HASH_MAP_GROUP_WIDTH) & mask;
+    }
+    return capacity;
+}
+
+#if defined(HASH_TABLE_CONTAINER)
+
+#define HTI_CONT HASH_TABLE_CONTAINER
+
+/* Allocates 'capacity' slots and their control bytes, all EMPTY (see hash_map_alloc_table). */
+static void HTI_FN(_alloc_table)(size_t capacity, HTI_SLOT** slots, uint8_t** ctrl) {
+    if (capacity > SIZE_MAX / sizeof(HTI_SLOT)) {
+        fprintf(stderr, HASH_TABLE_LABEL " capacity overflow: cannot allocate %zu slots\n", capacity);
+        exit(HASHMAP_CAPACITY_OVERFLOW);
+    }
+
+    *slots = malloc(capacity * sizeof(HTI_SLOT));
+    *ctrl  = malloc(capacity + HASH_MAP_GROUP_WIDTH);
+    if (*slots == NULL || *ctrl == NULL) {
+        fprintf(stderr, "Failed malloc while trying to allocate " HASH_TABLE_LABEL " table (%zu slots)\n", capacity);
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+    memset(*ctrl, HASH_MAP_CTRL_EMPTY, capacity + HASH_MAP_GROUP_WIDTH);
+}
+
+/* Moves every slot into a fresh table of 'new_capacity' slots (struct copies), dropping tombstones. */
+static void HTI_FN(_rehash)(HTI_CONT* c, size_t new_capacity) {
+    HTI_SLOT* new_slots;
+    uint8_t*  new_ctrl;
+    HTI_FN(_alloc_table)(new_capacity, &new_slots, &new_ctrl);
+
+    for (size_t i = hash_map_next_full(c->ctrl, c->capacity, 0); i < c->capacity;
+         i = hash_map_next_full(c->ctrl, c->capacity, i + 1)) {
+        uint64_t h64 = HASH_TABLE_SLOT_HASH(c, &c->slots[i]);
+        size_t index = hash_map_table_free_slot(new_ctrl, new_capacity, h64);
+        new_slots[index] = c->slots[i];
+        HASH_TABLE_SLOT_MOVED(&new_slots[index]);
+        hash_map_set_ctrl(new_ctrl, new_capacity, index, HASH_MAP_H2(h64));
+    }
+
+    free(c->slots);
+    free(c->ctrl);
+    c->slots      = new_slots;
+    c->ctrl       = new_ctrl;
+    c->capacity   = new_capacity;
+    c->tombstones = 0;
+}
+
+/* Grows (once) so that 'entries' keys fit under the load limit without further rehashing. */
+static inline void HTI_FN(_reserve)(HTI_CONT* c, size_t entries) {
+    size_t capacity = hash_map_capacity_for(entries, sizeof(HTI_SLOT));
+    if (capacity > c->capacity) HTI_FN(_rehash)(c, capacity);
+}
+
+/*
+ * Finds the key, or makes room for it (HashMap policy: reuse the first
+ * tombstone on its path, else take an EMPTY slot under the load limit, else
+ * grow or rehash in place). A new slot is marked FULL and counted in 'size';
+ * the caller fills in its key and payload.
+ * Returns the slot index; *found tells which case happened.
+ */
+static inline size_t HTI_FN(_insert_slot)(HTI_CONT* c, uint64_t h64, HASH_TABLE_KEY_PARAMS, int* found) {
+    size_t insert_at;
+    size_t index = HTI_FN(_table_probe)(c->slots, c->ctrl, c->capacity, h64, HASH_TABLE_KEY_ARGS, &insert_at);
+    if (index != c->capacity) {
+        *found = 1;
+        return index;
+    }
+
+    if (!hash_map_table_claim(c->ctrl, c->capacity, insert_at, c->size, &c->tombstones)) {
+        HTI_FN(_rehash)(c, hash_map_grown_capacity(c->capacity, c->size));
+        insert_at = hash_map_table_free_slot(c->ctrl, c->capacity, h64);
+    }
+
+    hash_map_set_ctrl(c->ctrl, c->capacity, insert_at, HASH_MAP_H2(h64));
+    c->size++;
+    *found = 0;
+    return insert_at;
+}
+
+/* Frees slot 'index' (EMPTY or tombstone, see hash_map_table_vacate); the caller released its payload. */
+static inline void HTI_FN(_erase_slot)(HTI_CONT* c, size_t index) {
+    c->size--;
+    c->tombstones += (size_t)hash_map_table_vacate(c->ctrl, c->capacity, index);
+}
+
+#undef HTI_CONT
+#endif /* HASH_TABLE_CONTAINER */
+
+#undef HTI_CAT_
+#undef HTI_CAT
+#undef HTI_FN
+#undef HTI_SLOT
+#undef HASH_TABLE_PREFIX
+#undef HASH_TABLE_SLOT
+#undef HASH_TABLE_KEY_PARAMS
+#undef HASH_TABLE_KEY_ARGS
+#undef HASH_TABLE_MATCHES
+#undef HASH_TABLE_CONTAINER
+#undef HASH_TABLE_SLOT_HASH
+#undef HASH_TABLE_SLOT_MOVED
+#undef HASH_TABLE_LABEL
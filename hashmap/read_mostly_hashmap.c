@@ -0,0 +1,451 @@
+#include "read_mostly_hashmap.h"
+
+/*
+ * ============================================================================
+ *  ReadMostlyHashMap — How readers stay wait-free
+ * ============================================================================
+ * Publication:
+ *   - writers fully build an entry (or a table) before storing its pointer
+ *     with release semantics; readers load pointers with acquire semantics,
+ *     so whatever a reader reaches through a pointer is already initialized.
+ *   - a slot only ever changes by swapping one pointer for another
+ *     (entry -> new entry, entry -> tombstone/NULL, NULL/tombstone -> entry),
+ *     so a reader sees either the old or the new state, never a torn one.
+ *
+ * Reclamation (epoch based):
+ *   - read_lock copies the global epoch into the reader's own slot and issues
+ *     a full fence; read_unlock stores 0.
+ *   - a writer unlinks an object, fences, and tags it with the global epoch G
+ *     while bumping the global epoch to G+1.
+ *   - the object can be freed once every active reader announced an epoch > G:
+ *     such a reader read the epoch after the bump, hence after the unlink,
+ *     so it cannot reach the object. Readers with epoch 0 hold nothing.
+ *
+ * Probing: linear, over a power-of-two table that is never more than 3/4 used
+ * (entries + tombstones), so every lookup ends on an empty slot quickly and is
+ * bounded by 'capacity' steps even while writers keep mutating the table.
+ * ============================================================================
+ */
+
+/* Tombstone marker: a unique address that is never dereferenced. */
+static const uint64_t read_mostly_hash_map_tombstone_storage[4];
+#define READ_MOSTLY_HASH_MAP_TOMBSTONE ((ReadMostlyHashMapEntry*)(void*)read_mostly_hash_map_tombstone_storage)
+
+/* ------------------------------------------------------------------------- */
+/*                              Internal helpers                             */
+/* ------------------------------------------------------------------------- */
+
+static ReadMostlyHashMapTable* read_mostly_hash_map_alloc_table(size_t capacity) {
+    if (capacity > (SIZE_MAX - sizeof(ReadMostlyHashMapTable)) / sizeof(ReadMostlyHashMapEntry*)) {
+        fprintf(stderr, "ReadMostlyHashMap: capacity overflow while growing to %zu slots\n", capacity);
+        exit(HASHMAP_CAPACITY_OVERFLOW);
+    }
+
+    ReadMostlyHashMapTable* table =
+        malloc(sizeof(ReadMostlyHashMapTable) + capacity * sizeof(ReadMostlyHashMapEntry*));
+    if (table == NULL) {
+        fprintf(stderr, "Failed malloc while trying to allocate a read-mostly hash map table\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_ALLOCATION);
+    }
+
+    table->capacity = capacity;
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&table->slots[i], NULL);
+    }
+    return table;
+}
+
+static ReadMostlyHashMapEntry* read_mostly_hash_map_new_entry(uint64_t h64,
+                                                              const void* key, size_t key_size,
+                                                              const void* data, size_t data_size) {
+    if (key_size > SIZE_MAX - sizeof(ReadMostlyHashMapEntry)) {
+        fprintf(stderr, "ReadMostlyHashMap: key too long\n");
+        exit(TOO_LONG_HASHMAP_KEY);
+    }
+
+    ReadMostlyHashMapEntry* entry = malloc(sizeof(ReadMostlyHashMapEntry) + key_size);
+    if (entry == NULL) {
+        fprintf(stderr, "Failed malloc while trying to allocate a read-mostly hash map entry\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_ALLOCATION);
+    }
+
+    entry->hash      = h64;
+    entry->data      = (void*)data;
+    entry->data_size = data_size;
+    entry->key_size  = key_size;
+    if (key_size > 0) memcpy(entry->key, key, key_size);
+    return entry;
+}
+
+static int read_mostly_hash_map_entry_matches(const ReadMostlyHashMapEntry* entry, uint64_t h64,
+                                              const void* key, size_t key_size) {
+    return entry->hash == h64 &&
+           entry->key_size == key_size &&
+           (key_size == 0 || memcmp(entry->key, key, key_size) == 0);
+}
+
+static void read_mostly_hash_map_lock(ReadMostlyHashMap* map) {
+    if (pthread_mutex_lock(&map->writer_lock) != 0) {
+        fprintf(stderr, "ReadMostlyHashMap: failed to acquire writer lock\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_LOCK);
+    }
+}
+
+static void read_mostly_hash_map_unlock(ReadMostlyHashMap* map) {
+    if (pthread_mutex_unlock(&map->writer_lock) != 0) {
+        fprintf(stderr, "ReadMostlyHashMap: failed to release writer lock\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_LOCK);
+    }
+}
+
+/* Free one retired object (entry + optionally owned data, or a table). */
+static void read_mostly_hash_map_free_retired(ReadMostlyHashMapRetired* r) {
+    if (r->entry != NULL) {
+        if (r->entry->data != NULL && r->deep_deallocate_data != NULL) {
+            r->deep_deallocate_data(r->entry->data);
+        }
+        free(r->entry);
+    }
+    free(r->table);
+    free(r);
+}
+
+/* Free retired objects no reader can reach anymore. Caller holds writer_lock. */
+static void read_mostly_hash_map_reclaim_locked(ReadMostlyHashMap* map) {
+    if (map->retired == NULL) return;
+
+    uint64_t min_active = UINT64_MAX;
+    for (ReadMostlyHashMapReader* r = map->readers; r != NULL; r = r->next) {
+        uint64_t e = atomic_load_explicit(&r->epoch, memory_order_acquire);
+        if (e != 0 && e < min_active) min_active = e;
+    }
+
+    /* list is newest first: epochs only decrease along it */
+    ReadMostlyHashMapRetired** link = &map->retired;
+    while (*link != NULL && (*link)->epoch >= min_active) {
+        link = &(*link)->next;
+    }
+
+    ReadMostlyHashMapRetired* victim = *link;
+    *link = NULL;
+    while (victim != NULL) {
+        ReadMostlyHashMapRetired* next = victim->next;
+        read_mostly_hash_map_free_retired(victim);
+        map->retired_count--;
+        victim = next;
+    }
+}
+
+/*
+ * Queue an unlinked entry (with its data deallocator) or table for reclamation.
+ * Caller holds writer_lock and has already replaced every pointer to it.
+ */
+static void read_mostly_hash_map_retire(ReadMostlyHashMap* map,
+                                        ReadMostlyHashMapEntry* entry,
+                                        ReadMostlyHashMapTable* table,
+                                        void (*deep_deallocate_data)(void* node_data)) {
+    ReadMostlyHashMapRetired* r = malloc(sizeof(ReadMostlyHashMapRetired));
+    if (r == NULL) {
+        fprintf(stderr, "Failed malloc while trying to retire a read-mostly hash map object\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_ALLOCATION);
+    }
+
+    /* order the unlink before reading the readers' epochs (pairs with read_lock's fence) */
+    atomic_thread_fence(memory_order_seq_cst);
+    r->epoch = atomic_fetch_add_explicit(&map->epoch, 1, memory_order_acq_rel);
+    r->entry = entry;
+    r->table = table;
+    r->deep_deallocate_data = deep_deallocate_data;
+    r->next = map->retired;
+    map->retired = r;
+    map->retired_count++;
+}
+
+/* Index of 'key' in 'table', or SIZE_MAX. Caller holds writer_lock. */
+static size_t read_mostly_hash_map_find_locked(ReadMostlyHashMapTable* table, uint64_t h64,
+                                               const void* key, size_t key_size) {
+    size_t mask = table->capacity - 1;
+    size_t i = (size_t)h64 & mask;
+    for (size_t n = 0; n < table->capacity; n++, i = (i + 1) & mask) {
+        ReadMostlyHashMapEntry* e = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+        if (e == NULL) return SIZE_MAX;
+        if (e != READ_MOSTLY_HASH_MAP_TOMBSTONE && read_mostly_hash_map_entry_matches(e, h64, key, key_size)) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+/* First tombstone or empty slot on h64's probe sequence. Caller holds writer_lock. */
+static size_t read_mostly_hash_map_free_slot_locked(ReadMostlyHashMapTable* table, uint64_t h64) {
+    size_t mask = table->capacity - 1;
+    size_t i = (size_t)h64 & mask;
+    for (;;) {
+        ReadMostlyHashMapEntry* e = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+        if (e == NULL || e == READ_MOSTLY_HASH_MAP_TOMBSTONE) return i;
+        i = (i + 1) & mask;
+    }
+}
+
+/*
+ * Make room for one more entry: when entries + tombstones would exceed 3/4 of
+ * the capacity, build a fresh table (doubling unless most of the pressure is
+ * tombstones), publish it and retire the old one. Entries are shared, not copied.
+ */
+static void read_mostly_hash_map_grow_locked(ReadMostlyHashMap* map) {
+    ReadMostlyHashMapTable* old = atomic_load_explicit(&map->table, memory_order_relaxed);
+    size_t size = atomic_load_explicit(&map->size, memory_order_relaxed);
+
+    if ((size + map->tombstones + 1) * READ_MOSTLY_HASH_MAP_MAX_LOAD_DEN <=
+        old->capacity * READ_MOSTLY_HASH_MAP_MAX_LOAD_NUM) {
+        return;
+    }
+
+    size_t capacity = old->capacity;
+    while ((size + 1) * 2 > capacity) {
+        if (capacity > SIZE_MAX / 2) {
+            fprintf(stderr, "ReadMostlyHashMap: capacity overflow\n");
+            exit(HASHMAP_CAPACITY_OVERFLOW);
+        }
+        capacity *= 2;
+    }
+
+    ReadMostlyHashMapTable* fresh = read_mostly_hash_map_alloc_table(capacity);
+    for (size_t i = 0; i < old->capacity; i++) {
+        ReadMostlyHashMapEntry* e = atomic_load_explicit(&old->slots[i], memory_order_relaxed);
+        if (e == NULL || e == READ_MOSTLY_HASH_MAP_TOMBSTONE) continue;
+        size_t dst = read_mostly_hash_map_free_slot_locked(fresh, e->hash);
+        atomic_store_explicit(&fresh->slots[dst], e, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&map->table, fresh, memory_order_release);
+    map->tombstones = 0;
+    read_mostly_hash_map_retire(map, NULL, old, NULL);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                 Public API                                */
+/* ------------------------------------------------------------------------- */
+
+ReadMostlyHashMap* build_read_mostly_hash_map(void) {
+    ReadMostlyHashMap* map = malloc(sizeof(ReadMostlyHashMap));
+    if (map == NULL) {
+        fprintf(stderr, "Failed malloc while trying to build a new read-mostly hash map\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_ALLOCATION);
+    }
+
+    if (pthread_mutex_init(&map->writer_lock, NULL) != 0) {
+        fprintf(stderr, "ReadMostlyHashMap: failed to initialize writer lock\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_LOCK);
+    }
+
+    atomic_init(&map->table, read_mostly_hash_map_alloc_table(READ_MOSTLY_HASH_MAP_INITIAL_CAPACITY));
+    atomic_init(&map->epoch, 1);
+    atomic_init(&map->size, 0);
+    map->tombstones    = 0;
+    map->readers       = NULL;
+    map->retired       = NULL;
+    map->retired_count = 0;
+    return map;
+}
+
+void read_mostly_hash_map_destroy(ReadMostlyHashMap* map,
+                                  void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You tried to destroy a NULL read-mostly hash map, this is a no-op\n");
+        return;
+    }
+
+    if (map->readers != NULL) {
+        fprintf(stderr, "ReadMostlyHashMap: destroying a map with registered readers; handles are freed too\n");
+        while (map->readers != NULL) {
+            ReadMostlyHashMapReader* next = map->readers->next;
+            free(map->readers);
+            map->readers = next;
+        }
+    }
+
+    /* nobody can read anymore: every retired object can go */
+    while (map->retired != NULL) {
+        ReadMostlyHashMapRetired* next = map->retired->next;
+        read_mostly_hash_map_free_retired(map->retired);
+        map->retired = next;
+    }
+
+    ReadMostlyHashMapTable* table = atomic_load_explicit(&map->table, memory_order_relaxed);
+    for (size_t i = 0; i < table->capacity; i++) {
+        ReadMostlyHashMapEntry* e = atomic_load_explicit(&table->slots[i], memory_order_relaxed);
+        if (e == NULL || e == READ_MOSTLY_HASH_MAP_TOMBSTONE) continue;
+        if (e->data != NULL && deep_deallocate_hashmap_item_data != NULL) {
+            deep_deallocate_hashmap_item_data(e->data);
+        }
+        free(e);
+    }
+    free(table);
+
+    pthread_mutex_destroy(&map->writer_lock);
+    free(map);
+}
+
+ReadMostlyHashMapReader* read_mostly_hash_map_register_reader(ReadMostlyHashMap* map) {
+    if (map == NULL) {
+        fprintf(stderr, "You are trying to register a reader on a NULL read-mostly hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    ReadMostlyHashMapReader* reader = malloc(sizeof(ReadMostlyHashMapReader));
+    if (reader == NULL) {
+        fprintf(stderr, "Failed malloc while trying to register a read-mostly hash map reader\n");
+        exit(FAILED_READ_MOSTLY_HASH_MAP_ALLOCATION);
+    }
+    atomic_init(&reader->epoch, 0);
+
+    read_mostly_hash_map_lock(map);
+    reader->next = map->readers;
+    map->readers = reader;
+    read_mostly_hash_map_unlock(map);
+    return reader;
+}
+
+void read_mostly_hash_map_unregister_reader(ReadMostlyHashMap* map, ReadMostlyHashMapReader* reader) {
+    if (map == NULL || reader == NULL) return;
+
+    read_mostly_hash_map_lock(map);
+    for (ReadMostlyHashMapReader** link = &map->readers; *link != NULL; link = &(*link)->next) {
+        if (*link == reader) {
+            *link = reader->next;
+            break;
+        }
+    }
+    /* this reader may have been the one holding objects back */
+    read_mostly_hash_map_reclaim_locked(map);
+    read_mostly_hash_map_unlock(map);
+
+    free(reader);
+}
+
+void read_mostly_hash_map_read_lock(ReadMostlyHashMap* map, ReadMostlyHashMapReader* reader) {
+    uint64_t e = atomic_load_explicit(&map->epoch, memory_order_acquire);
+    atomic_store_explicit(&reader->epoch, e, memory_order_relaxed);
+    /* announce before loading any pointer (pairs with the fence in retire) */
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+void read_mostly_hash_map_read_unlock(ReadMostlyHashMapReader* reader) {
+    atomic_store_explicit(&reader->epoch, 0, memory_order_release);
+}
+
+const ReadMostlyHashMapEntry* read_mostly_hash_map_get(ReadMostlyHashMap* map,
+                                                       const void* key,
+                                                       size_t key_size) {
+    if (map == NULL) return NULL;
+
+    uint64_t h64 = generate_hash(key, key_size);
+    ReadMostlyHashMapTable* table = atomic_load_explicit(&map->table, memory_order_acquire);
+    size_t mask = table->capacity - 1;
+    size_t i = (size_t)h64 & mask;
+
+    for (size_t n = 0; n < table->capacity; n++, i = (i + 1) & mask) {
+        ReadMostlyHashMapEntry* e = atomic_load_explicit(&table->slots[i], memory_order_acquire);
+        if (e == NULL) return NULL;
+        if (e != READ_MOSTLY_HASH_MAP_TOMBSTONE && read_mostly_hash_map_entry_matches(e, h64, key, key_size)) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+int read_mostly_hash_map_put(ReadMostlyHashMap* map,
+                             const void* key,
+                             size_t key_size,
+                             const void* data,
+                             size_t data_size,
+                             void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You are trying to put data in a NULL read-mostly hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    uint64_t h64 = generate_hash(key, key_size);
+    ReadMostlyHashMapEntry* entry = read_mostly_hash_map_new_entry(h64, key, key_size, data, data_size);
+    int updated = 0;
+
+    read_mostly_hash_map_lock(map);
+
+    ReadMostlyHashMapTable* table = atomic_load_explicit(&map->table, memory_order_relaxed);
+    size_t at = read_mostly_hash_map_find_locked(table, h64, key, key_size);
+    if (at != SIZE_MAX) {
+        ReadMostlyHashMapEntry* old = atomic_load_explicit(&table->slots[at], memory_order_relaxed);
+        atomic_store_explicit(&table->slots[at], entry, memory_order_release);
+        /* the old value is freed with its entry, and only if it is not the value just stored */
+        read_mostly_hash_map_retire(map, old, NULL,
+                                    old->data != data ? deep_deallocate_hashmap_item_data : NULL);
+        updated = 1;
+    } else {
+        read_mostly_hash_map_grow_locked(map);
+        table = atomic_load_explicit(&map->table, memory_order_relaxed);
+        at = read_mostly_hash_map_free_slot_locked(table, h64);
+        if (atomic_load_explicit(&table->slots[at], memory_order_relaxed) == READ_MOSTLY_HASH_MAP_TOMBSTONE) {
+            map->tombstones--;
+        }
+        atomic_store_explicit(&table->slots[at], entry, memory_order_release);
+        atomic_fetch_add_explicit(&map->size, 1, memory_order_relaxed);
+    }
+
+    read_mostly_hash_map_reclaim_locked(map);
+    read_mostly_hash_map_unlock(map);
+    return updated;
+}
+
+int read_mostly_hash_map_remove(ReadMostlyHashMap* map,
+                                const void* key,
+                                size_t key_size,
+                                void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "read_mostly_hash_map_remove called on a NULL read-mostly hash map\n");
+        return 0;
+    }
+
+    uint64_t h64 = generate_hash(key, key_size);
+
+    read_mostly_hash_map_lock(map);
+
+    ReadMostlyHashMapTable* table = atomic_load_explicit(&map->table, memory_order_relaxed);
+    size_t at = read_mostly_hash_map_find_locked(table, h64, key, key_size);
+    if (at == SIZE_MAX) {
+        read_mostly_hash_map_unlock(map);
+        return 0;
+    }
+
+    ReadMostlyHashMapEntry* old = atomic_load_explicit(&table->slots[at], memory_order_relaxed);
+
+    /* if the next slot is empty no probe sequence runs through this one: it can become empty too */
+    size_t next = (at + 1) & (table->capacity - 1);
+    if (atomic_load_explicit(&table->slots[next], memory_order_relaxed) == NULL) {
+        atomic_store_explicit(&table->slots[at], NULL, memory_order_release);
+    } else {
+        atomic_store_explicit(&table->slots[at], READ_MOSTLY_HASH_MAP_TOMBSTONE, memory_order_release);
+        map->tombstones++;
+    }
+    atomic_fetch_sub_explicit(&map->size, 1, memory_order_relaxed);
+
+    read_mostly_hash_map_retire(map, old, NULL, deep_deallocate_hashmap_item_data);
+    read_mostly_hash_map_reclaim_locked(map);
+    read_mostly_hash_map_unlock(map);
+    return 1;
+}
+
+size_t read_mostly_hash_map_reclaim(ReadMostlyHashMap* map) {
+    if (map == NULL) return 0;
+
+    read_mostly_hash_map_lock(map);
+    read_mostly_hash_map_reclaim_locked(map);
+    size_t pending = map->retired_count;
+    read_mostly_hash_map_unlock(map);
+    return pending;
+}
+
+size_t read_mostly_hash_map_size(ReadMostlyHashMap* map) {
+    if (map == NULL) return 0;
+    return atomic_load_explicit(&map->size, memory_order_relaxed);
+}
@@ -0,0 +1,163 @@
+#ifndef READ_MOSTLY_HASHMAP_H
+#define READ_MOSTLY_HASHMAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "hashmap.h"
+
+#define READ_MOSTLY_HASH_MAP_INITIAL_CAPACITY 16  /* slots in a freshly built table (power of two) */
+#define READ_MOSTLY_HASH_MAP_MAX_LOAD_NUM 3       /* max load factor = NUM / DEN (entries + tombstones) */
+#define READ_MOSTLY_HASH_MAP_MAX_LOAD_DEN 4
+#define READ_MOSTLY_HASH_MAP_CACHE_LINE 64        /* readers' epoch slots are padded to this */
+#define FAILED_READ_MOSTLY_HASH_MAP_ALLOCATION -89
+#define FAILED_READ_MOSTLY_HASH_MAP_LOCK       -88
+
+/*
+ * ============================================================================
+ *  ReadMostlyHashMap — Contracts & Ownership
+ * ============================================================================
+ * A concurrent map tuned for workloads dominated by lookups.
+ *
+ * - Readers never lock and never write shared memory: a lookup loads the
+ *   published table, probes at most 'capacity' slots and returns. It is
+ *   wait-free and does not slow down other readers or writers.
+ *
+ * - Writers (put/remove) serialize on one mutex. Entries are immutable: an
+ *   update publishes a new entry into the slot, a removal publishes a
+ *   tombstone, growth publishes a whole new table. Replaced entries and
+ *   tables are "retired" and freed later.
+ *
+ * - Reclamation is epoch based. Every reading thread registers once
+ *   (read_mostly_hash_map_register_reader) and brackets its lookups with
+ *   read_mostly_hash_map_read_lock/unlock, which only store to the reader's
+ *   own cache line. A retired object is freed once every reader that could
+ *   have seen it has left its read section. Writers reclaim opportunistically;
+ *   read_mostly_hash_map_reclaim() does it on demand.
+ *
+ * - Entry pointers: an entry returned by read_mostly_hash_map_get() stays
+ *   valid (and unchanged) until the caller's read_mostly_hash_map_read_unlock(),
+ *   even if another thread removes or overwrites the key meanwhile.
+ *
+ * Ownership policy (same as HashMap):
+ * - Keys: ALWAYS deep-copied and owned by the map.
+ * - Data: owned by the map only when a deallocator callback is passed to put/remove;
+ *   owned data is freed when its entry is reclaimed (not at the time of the call).
+ *
+ * - Thread-safety: put/remove/get/reclaim/size and reader (un)registration are
+ *   thread-safe. build/destroy must not race with any other call; destroy also
+ *   requires every reader to be unregistered.
+ * ============================================================================
+ */
+
+/* Immutable entry: key bytes follow the struct in the same allocation. */
+typedef struct ReadMostlyHashMapEntry {
+    uint64_t      hash;      /* 64-bit hash of the key */
+    void*         data;      /* value pointer (ownership depends on callback presence) */
+    size_t        data_size; /* value length in bytes */
+    size_t        key_size;  /* key length in bytes */
+    unsigned char key[];     /* key bytes (owned by the map) */
+} ReadMostlyHashMapEntry;
+
+/* Linear-probing table of entry pointers: NULL = empty, otherwise an entry or the tombstone. */
+typedef struct ReadMostlyHashMapTable {
+    size_t capacity;                           /* power of two */
+    _Atomic(ReadMostlyHashMapEntry*) slots[];
+} ReadMostlyHashMapTable;
+
+/* Per-thread reader handle. epoch == 0 means "not inside a read section". */
+typedef struct ReadMostlyHashMapReader {
+    _Atomic uint64_t                epoch;
+    struct ReadMostlyHashMapReader* next;  /* registration list (writer-side only) */
+    char pad[READ_MOSTLY_HASH_MAP_CACHE_LINE];     /* keeps other handles' epochs off this line */
+} ReadMostlyHashMapReader;
+
+/* Object waiting for readers to move on (an entry with its data, or a table). */
+typedef struct ReadMostlyHashMapRetired {
+    uint64_t                         epoch;  /* global epoch when it was unlinked */
+    ReadMostlyHashMapEntry*          entry;  /* or NULL */
+    ReadMostlyHashMapTable*          table;  /* or NULL */
+    void (*deep_deallocate_data)(void* node_data);
+    struct ReadMostlyHashMapRetired* next;
+} ReadMostlyHashMapRetired;
+
+typedef struct ReadMostlyHashMap {
+    _Atomic(ReadMostlyHashMapTable*) table;   /* published table (readers load it) */
+    _Atomic uint64_t                 epoch;   /* global epoch, starts at 1 */
+    _Atomic size_t                   size;    /* live entries */
+    size_t                           tombstones;
+
+    pthread_mutex_t                  writer_lock; /* guards everything below and all writes */
+    ReadMostlyHashMapReader*         readers;     /* registered reader handles */
+    ReadMostlyHashMapRetired*        retired;     /* limbo list, newest first */
+    size_t                           retired_count;
+} ReadMostlyHashMap;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/* Build a new, empty map with READ_MOSTLY_HASH_MAP_INITIAL_CAPACITY slots. */
+ReadMostlyHashMap* build_read_mostly_hash_map(void);
+
+/*
+ * Destroy the map, every entry and every retired object; optionally deep-free
+ * data via callback. No reader may be registered and no call may run concurrently.
+ */
+void read_mostly_hash_map_destroy(ReadMostlyHashMap* map,
+                                  void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/* Register the calling thread as a reader. The handle must be used by one thread at a time. */
+ReadMostlyHashMapReader* read_mostly_hash_map_register_reader(ReadMostlyHashMap* map);
+
+/* Unregister and free a reader handle (must be outside a read section). */
+void read_mostly_hash_map_unregister_reader(ReadMostlyHashMap* map, ReadMostlyHashMapReader* reader);
+
+/* Enter a read section: entries and tables seen from now on are not freed until unlock. */
+void read_mostly_hash_map_read_lock(ReadMostlyHashMap* map, ReadMostlyHashMapReader* reader);
+
+/* Leave the read section. */
+void read_mostly_hash_map_read_unlock(ReadMostlyHashMapReader* reader);
+
+/*
+ * Wait-free lookup; MUST be called inside a read section.
+ * Returns: the stored entry (valid until read_unlock), or NULL if not found.
+ */
+const ReadMostlyHashMapEntry* read_mostly_hash_map_get(ReadMostlyHashMap* map,
+                                                       const void* key,
+                                                       size_t key_size);
+
+/*
+ * Insert or update (upsert) an entry; serializes with other writers.
+ * Returns: 1 if updated an existing key; 0 if inserted a new key.
+ */
+int read_mostly_hash_map_put(ReadMostlyHashMap* map,
+                             const void* key,
+                             size_t key_size,
+                             const void* data,
+                             size_t data_size,
+                             void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Remove an entry by key; serializes with other writers.
+ * Returns: 1 if a matching entry was removed; 0 if not found.
+ */
+int read_mostly_hash_map_remove(ReadMostlyHashMap* map,
+                                const void* key,
+                                size_t key_size,
+                                void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Free every retired object no reader can still see.
+ * Returns: number of retired objects still pending.
+ */
+size_t read_mostly_hash_map_reclaim(ReadMostlyHashMap* map);
+
+/* Number of live entries (a snapshot when writers run concurrently). */
+size_t read_mostly_hash_map_size(ReadMostlyHashMap* map);
+
+#endif /* READ_MOSTLY_HASHMAP_H */
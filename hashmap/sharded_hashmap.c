@@ -0,0 +1,333 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* syscall(), MAP_ANONYMOUS, CPU_SET & co. under -std=c11 */
+#endif
+
+#include "sharded_hashmap.h"
+
+#if defined(SHARDED_HASH_MAP_LIBNUMA)
+#include <numa.h>
+#include <sched.h>
+#elif defined(__linux__)
+#include <limits.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * ============================================================================
+ *  ShardedHashMap — NUMA-homed shards over a ConcurrentHashMap
+ * ============================================================================
+ * Locking, routing and the per-shard HashMaps are the ConcurrentHashMap's;
+ * this file only supplies the allocator hook each segment's HashMap is built
+ * with (build_concurrent_hash_map_with_allocators), plus the node / affinity
+ * helpers at the bottom.
+ * ============================================================================
+ */
+
+#define SHARDED_HASH_MAP_MPOL_PREFERRED 1  /* <numaif.h> MPOL_PREFERRED */
+
+/* ------------------------------------------------------------------------- */
+/*                        Node-placed table memory                           */
+/* ------------------------------------------------------------------------- */
+
+/* 1 if a table of 'size' bytes for 'shard' should try the node-placed path. */
+static inline int sharded_hash_map_wants_node(const ShardedHashMapShard* shard, size_t size) {
+    return shard->node != SHARDED_HASH_MAP_NODE_ANY && size >= SHARDED_HASH_MAP_NUMA_MIN_BYTES;
+}
+
+/* Record index holding 'ptr' (NULL: a free record), or SHARDED_HASH_MAP_PLACED_BLOCKS. */
+static size_t sharded_hash_map_find_record(const ShardedHashMapShard* shard, const void* ptr) {
+    size_t i = 0;
+    while (i < SHARDED_HASH_MAP_PLACED_BLOCKS && shard->placed[i] != ptr) i++;
+    return i;
+}
+
+#if defined(SHARDED_HASH_MAP_LIBNUMA)
+
+static void* sharded_hash_map_node_alloc(ShardedHashMapShard* shard, size_t size) {
+    return numa_alloc_onnode(size, shard->node);
+}
+
+static void sharded_hash_map_node_free(void* ptr, size_t size) {
+    numa_free(ptr, size);
+}
+
+#elif defined(__linux__)
+
+/* Anonymous pages with a preferred-node policy; mbind failures keep default placement. */
+static void* sharded_hash_map_node_alloc(ShardedHashMapShard* shard, size_t size) {
+    void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) return NULL;
+
+#if defined(SYS_mbind)
+    if (shard->node < (int)(sizeof(unsigned long) * CHAR_BIT)) {
+        unsigned long nodemask = 1UL << shard->node;
+        (void)syscall(SYS_mbind, ptr, size, SHARDED_HASH_MAP_MPOL_PREFERRED,
+                      &nodemask, sizeof(nodemask) * CHAR_BIT + 1, 0);
+    }
+#endif
+    return ptr;
+}
+
+static void sharded_hash_map_node_free(void* ptr, size_t size) {
+    munmap(ptr, size);
+}
+
+#else
+
+static void* sharded_hash_map_node_alloc(ShardedHashMapShard* shard, size_t size) {
+    (void)shard;
+    return malloc(size);
+}
+
+static void sharded_hash_map_node_free(void* ptr, size_t size) {
+    (void)size;
+    free(ptr);
+}
+
+#endif
+
+/*
+ * HashMapAllocator hooks; ctx is the shard (called under its segment's write
+ * lock, or at build/destroy). Node-placed blocks are recorded, so release
+ * frees every block with the call that produced it; a failed node allocation
+ * (or no free record) falls back to malloc.
+ */
+static void* sharded_hash_map_table_alloc(size_t size, void* ctx) {
+    ShardedHashMapShard* shard = ctx;
+    if (sharded_hash_map_wants_node(shard, size)) {
+        size_t record = sharded_hash_map_find_record(shard, NULL);
+        void* ptr = record < SHARDED_HASH_MAP_PLACED_BLOCKS ? sharded_hash_map_node_alloc(shard, size) : NULL;
+        if (ptr != NULL) {
+            shard->placed[record] = ptr;
+            shard->placed_bytes += size;
+            return ptr;
+        }
+    }
+    return malloc(size);
+}
+
+static void sharded_hash_map_table_release(void* ptr, size_t size, void* ctx) {
+    ShardedHashMapShard* shard = ctx;
+    size_t record = ptr != NULL ? sharded_hash_map_find_record(shard, ptr) : SHARDED_HASH_MAP_PLACED_BLOCKS;
+    if (record == SHARDED_HASH_MAP_PLACED_BLOCKS) {
+        free(ptr);
+        return;
+    }
+    sharded_hash_map_node_free(ptr, size);
+    shard->placed[record] = NULL;
+    shard->placed_bytes -= size;
+}
+
+/* ConcurrentHashMapAllocatorFactory: segment i tables come from shard i. */
+static void sharded_hash_map_segment_allocator(size_t segment, size_t segment_count,
+                                               HashMapAllocator* allocator, void* ctx) {
+    (void)segment_count;
+    ShardedHashMap* map = ctx;
+    allocator->allocate = sharded_hash_map_table_alloc;
+    allocator->release  = sharded_hash_map_table_release;
+    allocator->ctx      = &map->shards[segment];
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               Public API                                  */
+/* ------------------------------------------------------------------------- */
+
+/* Rounds a requested shard count the way build_concurrent_hash_map does. */
+static size_t sharded_hash_map_round_count(size_t shard_count) {
+    if (shard_count == 0) shard_count = SHARDED_HASH_MAP_DEFAULT_SHARDS;
+    if (shard_count > SHARDED_HASH_MAP_MAX_SHARDS) shard_count = SHARDED_HASH_MAP_MAX_SHARDS;
+
+    size_t count = 1;
+    while (count < shard_count) count <<= 1;
+    return count;
+}
+
+/*
+ * Builds the map: assigns a home node to every shard, then builds the
+ * ConcurrentHashMap whose segment i allocates its tables through shard i.
+ */
+ShardedHashMap* build_sharded_hash_map(size_t shard_count, const int* shard_nodes, size_t node_list_len) {
+    const size_t count = sharded_hash_map_round_count(shard_count);
+
+    ShardedHashMap* map = malloc(sizeof(ShardedHashMap));
+    if (map == NULL) {
+        fprintf(stderr, "Failed malloc while trying to build a new sharded hash map\n");
+        exit(FAILED_SHARDED_HASH_MAP_ALLOCATION);
+    }
+
+    map->shards = calloc(count, sizeof(ShardedHashMapShard));
+    if (map->shards == NULL) {
+        fprintf(stderr, "Failed malloc while trying to allocate sharded hash map shards\n");
+        free(map);
+        exit(FAILED_SHARDED_HASH_MAP_ALLOCATION);
+    }
+
+    map->shard_count = count;
+    map->node_count  = sharded_hash_map_node_count();
+
+#if defined(SHARDED_HASH_MAP_LIBNUMA)
+    const int numa_usable = numa_available() >= 0;
+#else
+    const int numa_usable = 1;
+#endif
+
+    for (size_t i = 0; i < count; i++) {
+        int node = (shard_nodes != NULL && node_list_len > 0) ? shard_nodes[i % node_list_len]
+                                                               : (int)(i % (size_t)map->node_count);
+        if (node < 0 || !numa_usable) node = SHARDED_HASH_MAP_NODE_ANY;
+        else node %= map->node_count;
+        map->shards[i].node = node;
+    }
+
+    map->map = build_concurrent_hash_map_with_allocators(count, sharded_hash_map_segment_allocator, map);
+    return map;
+}
+
+/*
+ * Destroys the shards (items + optional data via callback) and the map.
+ * The caller guarantees no other thread is using the map.
+ */
+void sharded_hash_map_destroy(ShardedHashMap* map,
+                              void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You tried to destroy a NULL sharded hash map, this is a no-op\n");
+        return;
+    }
+
+    concurrent_hash_map_destroy(map->map, deep_deallocate_hashmap_item_data);  /* tables go back to the shards */
+    free(map->shards);
+    free(map);
+}
+
+int sharded_hash_map_put(ShardedHashMap* map,
+                         const void* key,
+                         size_t key_size,
+                         const void* data,
+                         size_t data_size,
+                         void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You are trying to put data in a NULL sharded hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+    return concurrent_hash_map_put(map->map, key, key_size, data, data_size, deep_deallocate_hashmap_item_data);
+}
+
+int sharded_hash_map_remove(ShardedHashMap* map,
+                            const void* key,
+                            size_t key_size,
+                            void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "sharded_hash_map_remove called on a NULL sharded hash map\n");
+        return 0;
+    }
+    return concurrent_hash_map_remove(map->map, key, key_size, deep_deallocate_hashmap_item_data);
+}
+
+int sharded_hash_map_get(ShardedHashMap* map,
+                         const void* key,
+                         size_t key_size,
+                         void** out_data,
+                         size_t* out_data_size) {
+    if (map == NULL) return 0;
+    return concurrent_hash_map_get(map->map, key, key_size, out_data, out_data_size);
+}
+
+size_t sharded_hash_map_size(ShardedHashMap* map) {
+    if (map == NULL) return 0;
+    return concurrent_hash_map_size(map->map);
+}
+
+int sharded_hash_map_node_of(const ShardedHashMap* map, const void* key, size_t key_size) {
+    if (map == NULL) return SHARDED_HASH_MAP_NODE_ANY;
+    return map->shards[concurrent_hash_map_segment_index(map->map, key, key_size)].node;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                         Node / affinity helpers                           */
+/* ------------------------------------------------------------------------- */
+
+#if defined(__linux__) && !defined(SHARDED_HASH_MAP_LIBNUMA)
+/*
+ * Parses a sysfs id list ("0-3,8,10-11"), calling visit(id) for each id.
+ * Returns: the number of ids visited, or -1 if the file cannot be read.
+ */
+static int sharded_hash_map_read_id_list(const char* path, void (*visit)(unsigned id, void* ctx), void* ctx) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return -1;
+
+    int visited = 0;
+    unsigned first, last;
+    char sep;
+    while (fscanf(file, "%u", &first) == 1) {
+        last = first;
+        sep = (char)fgetc(file);
+        if (sep == '-') {
+            if (fscanf(file, "%u", &last) != 1) break;
+            sep = (char)fgetc(file);
+        }
+        for (unsigned id = first; id <= last; id++) {
+            visit(id, ctx);
+            visited++;
+        }
+        if (sep != ',') break;
+    }
+    fclose(file);
+    return visited;
+}
+
+static void sharded_hash_map_track_max(unsigned id, void* ctx) {
+    unsigned* max_id = ctx;
+    if (id > *max_id) *max_id = id;
+}
+
+static void sharded_hash_map_add_cpu(unsigned id, void* ctx) {
+    if (id < CPU_SETSIZE) CPU_SET(id, (cpu_set_t*)ctx);
+}
+#endif
+
+int sharded_hash_map_node_count(void) {
+#if defined(SHARDED_HASH_MAP_LIBNUMA)
+    return numa_available() >= 0 ? numa_max_node() + 1 : 1;
+#elif defined(__linux__)
+    unsigned max_id = 0;
+    if (sharded_hash_map_read_id_list("/sys/devices/system/node/online", sharded_hash_map_track_max, &max_id) <= 0) {
+        return 1;
+    }
+    return (int)max_id + 1;
+#else
+    return 1;
+#endif
+}
+
+int sharded_hash_map_current_node(void) {
+#if defined(SHARDED_HASH_MAP_LIBNUMA)
+    int cpu = sched_getcpu();
+    int node = cpu >= 0 ? numa_node_of_cpu(cpu) : -1;
+    return node >= 0 ? node : 0;
+#elif defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) return 0;
+    return (int)node;
+#else
+    return 0;
+#endif
+}
+
+int sharded_hash_map_bind_thread_to_node(int node) {
+    if (node < 0) return -1;
+#if defined(SHARDED_HASH_MAP_LIBNUMA)
+    return numa_available() >= 0 && numa_run_on_node(node) == 0 ? 0 : -1;
+#elif defined(__linux__)
+    char path[64];
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    snprintf(path, sizeof path, "/sys/devices/system/node/node%d/cpulist", node);
+    if (sharded_hash_map_read_id_list(path, sharded_hash_map_add_cpu, &cpus) <= 0) return -1;
+    return sched_setaffinity(0, sizeof cpus, &cpus) == 0 ? 0 : -1;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,141 @@
+#ifndef SHARDED_HASHMAP_H
+#define SHARDED_HASHMAP_H
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  /* pthread_rwlock_t (concurrent_hashmap.h) under -std=c11 */
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hashmap.h"
+#include "concurrent_hashmap.h"
+
+#define SHARDED_HASH_MAP_DEFAULT_SHARDS   CONCURRENT_HASH_MAP_DEFAULT_SEGMENTS /* used when 0 shards are requested */
+#define SHARDED_HASH_MAP_MAX_SHARDS       CONCURRENT_HASH_MAP_MAX_SEGMENTS
+#define SHARDED_HASH_MAP_NODE_ANY         (-1)        /* shard memory follows the default policy */
+#define SHARDED_HASH_MAP_NUMA_MIN_BYTES   (64 * 1024) /* smaller tables are plain malloc'd */
+#define SHARDED_HASH_MAP_PLACED_BLOCKS    8           /* node-placed blocks tracked per shard (a HashMap holds <= 4) */
+#define FAILED_SHARDED_HASH_MAP_ALLOCATION -81
+
+/*
+ * ============================================================================
+ *  ShardedHashMap — Contracts & Ownership
+ * ============================================================================
+ * - Sharding: a ConcurrentHashMap underneath (its segments are the shards:
+ *   one HashMap + rwlock each, picked by the hash bits right below the 7-bit
+ *   fingerprint). This layer only adds where each shard's tables live.
+ *
+ * - NUMA placement: every shard is homed on a node (round-robin over the
+ *   online nodes by default, or as listed at build time). Its tables of at
+ *   least SHARDED_HASH_MAP_NUMA_MIN_BYTES come from the HashMap allocator
+ *   hook, which places them on that node:
+ *     * built with -DSHARDED_HASH_MAP_LIBNUMA (link -lnuma): numa_alloc_onnode;
+ *     * other Linux builds: mmap + mbind(MPOL_PREFERRED) through syscall();
+ *     * elsewhere, or when the kernel refuses the policy: ordinary memory
+ *       (first-touch placement). The map works the same either way.
+ *   A node allocation that fails falls back to malloc; each block is
+ *   released through the call that produced it.
+ *   Node ids beyond the online node count wrap around (node % count).
+ *   Keys longer than HASH_MAP_INLINE_KEY_SIZE and values are NOT placed.
+ *
+ * - Affinity-aware routing: the shard (hence node) of a key is a pure
+ *   function of its hash. sharded_hash_map_node_of() tells callers which
+ *   node owns a key, sharded_hash_map_current_node() which node the calling
+ *   thread runs on and sharded_hash_map_bind_thread_to_node() pins a worker
+ *   to a node, so requests can be handed to a worker local to their shard.
+ *
+ * - Ownership: same rules as HashMap / ConcurrentHashMap.
+ *     * Keys are ALWAYS deep-copied and owned by the map.
+ *     * Data is owned by the map only when a deallocator callback is passed.
+ *
+ * - Thread-safety: all functions are thread-safe, except build/destroy,
+ *   which must not race with any other call on the same map.
+ * ============================================================================
+ */
+
+/*
+ * Placement state of one shard (segment i of the ConcurrentHashMap); its
+ * allocator hook runs under that segment's write lock.
+ */
+typedef struct ShardedHashMapShard {
+    int    node;          /* home node, or SHARDED_HASH_MAP_NODE_ANY */
+    size_t placed_bytes;  /* live table bytes obtained through the node-placement path */
+    void*  placed[SHARDED_HASH_MAP_PLACED_BLOCKS]; /* those blocks (NULL = free record) */
+} ShardedHashMapShard;
+
+typedef struct ShardedHashMap {
+    ConcurrentHashMap*   map;         /* locking, routing and the per-shard HashMaps */
+    ShardedHashMapShard* shards;      /* one per segment of 'map' */
+    size_t               shard_count; /* power of two (= map->segment_count) */
+    int                  node_count;  /* online nodes seen at build time (>= 1) */
+} ShardedHashMap;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Build a map with 'shard_count' shards (rounded up to a power of two, clamped
+ * to SHARDED_HASH_MAP_MAX_SHARDS; 0 → SHARDED_HASH_MAP_DEFAULT_SHARDS).
+ * 'shard_nodes' (may be NULL = round-robin over the online nodes) holds
+ * 'node_list_len' node ids, repeated cyclically over the shards;
+ * SHARDED_HASH_MAP_NODE_ANY entries leave a shard unplaced.
+ */
+ShardedHashMap* build_sharded_hash_map(size_t shard_count, const int* shard_nodes, size_t node_list_len);
+
+/* Destroy the map; optionally deep-free each item's data via callback. Not thread-safe. */
+void sharded_hash_map_destroy(ShardedHashMap* map,
+                              void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Insert or update (upsert) under the shard's write lock.
+ * Returns: 1 if updated an existing key; 0 if inserted a new key.
+ */
+int sharded_hash_map_put(ShardedHashMap* map,
+                         const void* key,
+                         size_t key_size,
+                         const void* data,
+                         size_t data_size,
+                         void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Remove under the shard's write lock.
+ * Returns: 1 if a matching entry was removed; 0 if not found (or map is NULL).
+ */
+int sharded_hash_map_remove(ShardedHashMap* map,
+                            const void* key,
+                            size_t key_size,
+                            void (*deep_deallocate_hashmap_item_data)(void* node_data));
+
+/*
+ * Lookup under the shard's read lock.
+ * Returns: 1 if found (and fills *out_data / *out_data_size when non-NULL); 0 otherwise.
+ * Same caveat as concurrent_hash_map_get() about owned values removed concurrently.
+ */
+int sharded_hash_map_get(ShardedHashMap* map,
+                         const void* key,
+                         size_t key_size,
+                         void** out_data,
+                         size_t* out_data_size);
+
+/* Number of live entries (sum over shards, each read under its lock). */
+size_t sharded_hash_map_size(ShardedHashMap* map);
+
+/* Home node of the shard owning 'key' (SHARDED_HASH_MAP_NODE_ANY if unplaced). */
+int sharded_hash_map_node_of(const ShardedHashMap* map, const void* key, size_t key_size);
+
+/* Online NUMA nodes on this machine (1 when unknown or not NUMA). */
+int sharded_hash_map_node_count(void);
+
+/* Node of the CPU the calling thread runs on right now (0 when unknown). */
+int sharded_hash_map_current_node(void);
+
+/*
+ * Restrict the calling thread to the CPUs of 'node'.
+ * Returns: 0 on success; -1 if unsupported here or refused by the OS.
+ */
+int sharded_hash_map_bind_thread_to_node(int node);
+
+#endif /* SHARDED_HASHMAP_H */
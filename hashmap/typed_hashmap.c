@@ -0,0 +1,15 @@
+#include "typed_hashmap.h"
+
+/* HashMapU64: the key itself is the integer to mix. */
+#define TYPED_HASH_MAP_NAME   HashMapU64
+#define TYPED_HASH_MAP_PREFIX hash_map_u64
+#define TYPED_HASH_MAP_KEY    uint64_t
+#define TYPED_HASH_MAP_HASH(key, seed) fast_hash_u64((key), (seed))
+#include "typed_hashmap_impl.h"
+
+/* HashMapU32: widened to 64 bits, then mixed the same way. */
+#define TYPED_HASH_MAP_NAME   HashMapU32
+#define TYPED_HASH_MAP_PREFIX hash_map_u32
+#define TYPED_HASH_MAP_KEY    uint32_t
+#define TYPED_HASH_MAP_HASH(key, seed) fast_hash_u64((uint64_t)(key), (seed))
+#include "typed_hashmap_impl.h"
@@ -0,0 +1,78 @@
+#ifndef TYPED_HASHMAP_H
+#define TYPED_HASHMAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "hashmap.h"
+
+#define TYPED_HASH_MAP_DEFAULT_SEED 0  /* seed of build_<prefix>(); use _with_seed + hash_map_random_seed() against HashDoS */
+
+/*
+ * ============================================================================
+ *  Typed HashMaps — fixed-width integer keys (HashMapU64, HashMapU32)
+ * ============================================================================
+ * Same table as HashMap (control-byte groups, triangular probing, 7/8 load,
+ * see hashmap_ctrl.h), specialized for one integer key type:
+ *   - the key lives in the slot as a plain integer: no key copy, no key_size,
+ *     and a match is one integer compare;
+ *   - the hash is fast_hash_u64(key, seed) and is NOT stored: recomputing it
+ *     on rehash is cheaper than the 8 bytes per slot it would take.
+ * Growth is always stop-the-world; there is no arena (nothing to allocate per key).
+ *
+ * TYPED_HASH_MAP_DECLARE(Name, prefix, KeyType) declares, for a map type Name:
+ *   typedef struct NameItem { KeyType key; void* data; size_t data_size; } NameItem;
+ *   Name*           build_<prefix>(void);
+ *   Name*           build_<prefix>_with_seed(uint64_t seed);
+ *   void            <prefix>_destroy(Name*, dealloc);
+ *   int             <prefix>_put(Name*, KeyType, data, data_size, dealloc);  1 updated, 0 inserted
+ *   int             <prefix>_remove(Name*, KeyType, dealloc);                1 removed, 0 not found
+ *   const NameItem* <prefix>_get(const Name*, KeyType);                      NULL if absent
+ *   void            <prefix>_for_each(const Name*, visit, ctx);
+ * The definitions come from typed_hashmap_impl.h (see typed_hashmap.c).
+ *
+ * Semantics are those of HashMap: put is an upsert, data ownership follows
+ * the callback (non-NULL = the map frees data on update, remove and destroy),
+ * item pointers die at the next put/remove. NOT thread-safe.
+ * ============================================================================
+ */
+
+#define TYPED_HASH_MAP_DECLARE(Name, prefix, KeyType)                                          \
+    typedef struct Name##Item {                                                                \
+        KeyType key;                                                                           \
+        void*   data;       /* value pointer (ownership depends on callback presence) */       \
+        size_t  data_size;                                                                     \
+    } Name##Item;                                                                              \
+                                                                                               \
+    typedef struct Name {                                                                      \
+        Name##Item* slots;      /* meaningful only where ctrl[i] is FULL */                    \
+        uint8_t*    ctrl;       /* capacity + HASH_MAP_GROUP_WIDTH control bytes */            \
+        size_t      capacity;   /* power of two */                                             \
+        size_t      size;                                                                      \
+        size_t      tombstones;                                                                \
+        uint64_t    hash_seed;                                                                 \
+    } Name;                                                                                    \
+                                                                                               \
+    Name* build_##prefix(void);                                                                \
+    Name* build_##prefix##_with_seed(uint64_t seed);                                           \
+    void prefix##_destroy(Name* map, void (*deep_deallocate_hashmap_item_data)(void* node_data)); \
+    int prefix##_put(Name* map, KeyType key, const void* data, size_t data_size,               \
+                     void (*deep_deallocate_hashmap_item_data)(void* node_data));              \
+    int prefix##_remove(Name* map, KeyType key,                                                \
+                        void (*deep_deallocate_hashmap_item_data)(void* node_data));           \
+    const Name##Item* prefix##_get(const Name* map, KeyType key);                              \
+    void prefix##_for_each(const Name* map, void (*visit)(const Name##Item* item, void* ctx), void* ctx);
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/* HashMapU64: 64-bit keys (ids, handles, pointers cast to uint64_t). */
+TYPED_HASH_MAP_DECLARE(HashMapU64, hash_map_u64, uint64_t)
+
+/* HashMapU32: 32-bit keys. */
+TYPED_HASH_MAP_DECLARE(HashMapU32, hash_map_u32, uint32_t)
+
+#endif /* TYPED_HASHMAP_H */
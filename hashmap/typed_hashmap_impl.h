@@ -0,0 +1,142 @@
+/*
+ * ============================================================================
+ *  Typed HashMap implementation template (no include guard on purpose)
+ * ============================================================================
+ * Defines the functions declared by TYPED_HASH_MAP_DECLARE for one key type.
+ * Before including, define:
+ *   TYPED_HASH_MAP_NAME             map type, e.g. HashMapU64
+ *   TYPED_HASH_MAP_PREFIX           function prefix, e.g. hash_map_u64
+ *   TYPED_HASH_MAP_KEY              key type, e.g. uint64_t
+ *   TYPED_HASH_MAP_HASH(key, seed)  64-bit hash of a key
+ * Every parameter is #undef'd at the end, so the file can be included again
+ * for the next type. Include it from exactly one .c file per type.
+ * ============================================================================
+ */
+
+#include "hashmap_ctrl.h"
+
+#define THM_CAT_(a, b) a##b
+#define THM_CAT(a, b) THM_CAT_(a, b)
+#define THM_FN(suffix) THM_CAT(TYPED_HASH_MAP_PREFIX, suffix)
+#define THM_MAP  TYPED_HASH_MAP_NAME
+#define THM_ITEM THM_CAT(TYPED_HASH_MAP_NAME, Item)
+#define THM_KEY  TYPED_HASH_MAP_KEY
+
+/* Table engine over THM_ITEM slots; hashes are not stored, the rehash recomputes them. */
+#define HASH_TABLE_PREFIX               TYPED_HASH_MAP_PREFIX
+#define HASH_TABLE_SLOT                 THM_ITEM
+#define HASH_TABLE_KEY_PARAMS           THM_KEY key
+#define HASH_TABLE_KEY_ARGS             key
+#define HASH_TABLE_MATCHES(slot, h64)   ((void)(h64), (slot)->key == key)
+#define HASH_TABLE_CONTAINER            THM_MAP
+#define HASH_TABLE_SLOT_HASH(c, slot)   TYPED_HASH_MAP_HASH((slot)->key, (c)->hash_seed)
+#define HASH_TABLE_SLOT_MOVED(slot)     ((void)(slot))
+#define HASH_TABLE_LABEL                "Typed hash map"
+#include "hashmap_table_impl.h"
+
+/* Slot index holding 'key' (whose hash is h64), or map->capacity if absent. */
+static inline size_t THM_FN(_find)(const THM_MAP* map, THM_KEY key, uint64_t h64) {
+    return THM_FN(_table_find)(map->slots, map->ctrl, map->capacity, h64, key);
+}
+
+THM_MAP* THM_CAT(build_, TYPED_HASH_MAP_PREFIX)(void) {
+    return THM_CAT(THM_CAT(build_, TYPED_HASH_MAP_PREFIX), _with_seed)(TYPED_HASH_MAP_DEFAULT_SEED);
+}
+
+THM_MAP* THM_CAT(THM_CAT(build_, TYPED_HASH_MAP_PREFIX), _with_seed)(uint64_t seed) {
+    THM_MAP* map = malloc(sizeof(THM_MAP));
+    if (map == NULL) {
+        fprintf(stderr, "Failed malloc while trying to build a new typed hash map\n");
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+
+    THM_FN(_alloc_table)(HASH_MAP_INITIAL_CAPACITY, &map->slots, &map->ctrl);
+    map->capacity   = HASH_MAP_INITIAL_CAPACITY;
+    map->size       = 0;
+    map->tombstones = 0;
+    map->hash_seed  = seed;
+    return map;
+}
+
+void THM_FN(_destroy)(THM_MAP* map, void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You tried to destroy a NULL typed hash map, this is a no-op\n");
+        return;
+    }
+
+    if (deep_deallocate_hashmap_item_data != NULL) {
+        for (size_t i = 0; i < map->capacity; i++) {
+            if (HASH_MAP_CTRL_IS_FULL(map->ctrl[i]) && map->slots[i].data != NULL) {
+                deep_deallocate_hashmap_item_data(map->slots[i].data);
+            }
+        }
+    }
+
+    free(map->slots);
+    free(map->ctrl);
+    free(map);
+}
+
+/* Upsert; same growth policy as hash_map_put (see hash_map_grown_capacity). */
+int THM_FN(_put)(THM_MAP* map, THM_KEY key, const void* data, size_t data_size,
+                 void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) {
+        fprintf(stderr, "You are trying to put data in a NULL typed hash map\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    int found;
+    size_t index = THM_FN(_insert_slot)(map, TYPED_HASH_MAP_HASH(key, map->hash_seed), key, &found);
+    THM_ITEM* item = &map->slots[index];
+    if (found && item->data != NULL && deep_deallocate_hashmap_item_data != NULL) {
+        deep_deallocate_hashmap_item_data(item->data);
+    }
+    item->key       = key;
+    item->data      = (void*)data;
+    item->data_size = data_size;
+    return found ? 1 : 0; /* 1 = updated existing, 0 = inserted new */
+}
+
+int THM_FN(_remove)(THM_MAP* map, THM_KEY key,
+                    void (*deep_deallocate_hashmap_item_data)(void* node_data)) {
+    if (map == NULL) return 0;
+
+    size_t index = THM_FN(_find)(map, key, TYPED_HASH_MAP_HASH(key, map->hash_seed));
+    if (index == map->capacity) return 0;
+
+    THM_ITEM* item = &map->slots[index];
+    if (item->data != NULL && deep_deallocate_hashmap_item_data != NULL) {
+        deep_deallocate_hashmap_item_data(item->data);
+    }
+    item->data = NULL;
+    THM_FN(_erase_slot)(map, index);
+    return 1;
+}
+
+const THM_ITEM* THM_FN(_get)(const THM_MAP* map, THM_KEY key) {
+    if (map == NULL) return NULL;
+
+    size_t index = THM_FN(_find)(map, key, TYPED_HASH_MAP_HASH(key, map->hash_seed));
+    return index == map->capacity ? NULL : &map->slots[index];
+}
+
+void THM_FN(_for_each)(const THM_MAP* map, void (*visit)(const THM_ITEM* item, void* ctx), void* ctx) {
+    if (map == NULL || visit == NULL) return;
+
+    for (size_t base = 0; base < map->capacity; base += HASH_MAP_GROUP_WIDTH) {
+        for (uint32_t full = hash_map_group_match_full(map->ctrl + base); full != 0; full &= full - 1) {
+            visit(&map->slots[base + hash_map_ctz(full)], ctx);
+        }
+    }
+}
+
+#undef THM_CAT_
+#undef THM_CAT
+#undef THM_FN
+#undef THM_MAP
+#undef THM_ITEM
+#undef THM_KEY
+#undef TYPED_HASH_MAP_NAME
+#undef TYPED_HASH_MAP_PREFIX
+#undef TYPED_HASH_MAP_KEY
+#undef TYPED_HASH_MAP_HASH
@@ -0,0 +1,211 @@
+#include "hashset.h"
+#include "../hashmap/hashmap_ctrl.h"
+
+/* ------------------------------------------------------------------------- */
+/*                              Internal helpers                             */
+/* ------------------------------------------------------------------------- */
+
+static inline uint64_t hash_set_hash_key(const HashSet* set, const void* key, size_t key_size) {
+    return hash_map_hash_bytes(set->hash_kind, set->hash_seed, key, key_size);
+}
+
+/* 1 if both sets would store the same hash for any key (same function and seed). */
+static inline int hash_set_same_hashing(const HashSet* a, const HashSet* b) {
+    return a->hash_kind == b->hash_kind && a->hash_seed == b->hash_seed;
+}
+
+static inline int hash_set_entry_matches(const HashSetEntry* entry, uint64_t h64,
+                                         const void* key, size_t key_size) {
+    if (entry->hash != h64 || entry->key_size != key_size) return 0;
+    return key_size == 0 || memcmp(entry->key, key, key_size) == 0;
+}
+
+/* Inline keys point into their own slot: re-aim them after a struct copy. */
+static inline void hash_set_entry_moved(HashSetEntry* entry) {
+    if (entry->key_size <= HASH_MAP_INLINE_KEY_SIZE) entry->key = entry->inline_key;
+}
+
+/* Table engine over HashSetEntry slots (hash_set_table_find, hash_set_insert_slot, ...). */
+#define HASH_TABLE_PREFIX               hash_set
+#define HASH_TABLE_SLOT                 HashSetEntry
+#define HASH_TABLE_KEY_PARAMS           const void* key, size_t key_size
+#define HASH_TABLE_KEY_ARGS             key, key_size
+#define HASH_TABLE_MATCHES(slot, h64)   hash_set_entry_matches((slot), (h64), key, key_size)
+#define HASH_TABLE_CONTAINER            HashSet
+#define HASH_TABLE_SLOT_HASH(c, slot)   ((slot)->hash)
+#define HASH_TABLE_SLOT_MOVED(slot)     hash_set_entry_moved(slot)
+#define HASH_TABLE_LABEL                "Hash set"
+#include "../hashmap/hashmap_table_impl.h"
+
+/* Slot index holding 'key', or set->capacity if absent. */
+static inline size_t hash_set_find(const HashSet* set, uint64_t h64, const void* key, size_t key_size) {
+    return hash_set_table_find(set->slots, set->ctrl, set->capacity, h64, key, key_size);
+}
+
+/* Insert with a hash computed by the caller (MUST be hash_set_hash_key(set, key, key_size)). */
+static int hash_set_insert_hashed(HashSet* set, uint64_t h64, const void* key, size_t key_size) {
+    int found;
+    size_t index = hash_set_insert_slot(set, h64, key, key_size, &found);
+    if (found) return 0; /* already present */
+
+    HashSetEntry* entry = &set->slots[index];
+    entry->hash     = h64;
+    entry->key_size = key_size;
+    if (key_size <= HASH_MAP_INLINE_KEY_SIZE) {
+        if (key_size != 0) memcpy(entry->inline_key, key, key_size);
+        entry->key = entry->inline_key;
+    } else {
+        entry->key = malloc(key_size);
+        if (entry->key == NULL) {
+            fprintf(stderr, "Failed hash set insert operation while copying key\n");
+            exit(FAILED_HASH_MAP_ALLOCATION);
+        }
+        memcpy(entry->key, key, key_size);
+    }
+    return 1;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               Public API                                  */
+/* ------------------------------------------------------------------------- */
+
+HashSet* build_hash_set(void) {
+    return build_hash_set_with_hash(HASH_MAP_HASH_MURMUR3, MUR_MUR_3_SEED);
+}
+
+HashSet* build_hash_set_with_hash(int hash_kind, uint64_t seed) {
+    HashSet* set = malloc(sizeof(HashSet));
+    if (set == NULL) {
+        fprintf(stderr, "Failed malloc while trying to build a new hash set\n");
+        exit(FAILED_HASH_MAP_ALLOCATION);
+    }
+
+    hash_set_alloc_table(HASH_MAP_INITIAL_CAPACITY, &set->slots, &set->ctrl);
+    set->capacity   = HASH_MAP_INITIAL_CAPACITY;
+    set->size       = 0;
+    set->tombstones = 0;
+    set->hash_kind  = hash_map_normalize_hash_kind(hash_kind);
+    set->hash_seed  = seed;
+    return set;
+}
+
+void hash_set_destroy(HashSet* set) {
+    if (set == NULL) {
+        fprintf(stderr, "You tried to destroy a NULL hash set, this is a no-op\n");
+        return;
+    }
+
+    for (size_t i = hash_map_next_full(set->ctrl, set->capacity, 0); i < set->capacity;
+         i = hash_map_next_full(set->ctrl, set->capacity, i + 1)) {
+        if (set->slots[i].key_size > HASH_MAP_INLINE_KEY_SIZE) free(set->slots[i].key);
+    }
+
+    free(set->slots);
+    free(set->ctrl);
+    free(set);
+}
+
+int hash_set_insert(HashSet* set, const void* key, size_t key_size) {
+    if (set == NULL) {
+        fprintf(stderr, "You are trying to insert into a NULL hash set; did you call build_hash_set(void)?\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+    return hash_set_insert_hashed(set, hash_set_hash_key(set, key, key_size), key, key_size);
+}
+
+int hash_set_contains(const HashSet* set, const void* key, size_t key_size) {
+    if (set == NULL) return 0;
+    return hash_set_find(set, hash_set_hash_key(set, key, key_size), key, key_size) != set->capacity;
+}
+
+int hash_set_remove(HashSet* set, const void* key, size_t key_size) {
+    if (set == NULL) return 0;
+
+    size_t index = hash_set_find(set, hash_set_hash_key(set, key, key_size), key, key_size);
+    if (index == set->capacity) return 0;
+
+    if (set->slots[index].key_size > HASH_MAP_INLINE_KEY_SIZE) free(set->slots[index].key);
+    set->slots[index].key = NULL;
+    hash_set_erase_slot(set, index);
+    return 1;
+}
+
+void hash_set_iterator_init(HashSetIterator* it, const HashSet* set) {
+    if (it == NULL) return;
+    it->set      = set;
+    it->position = 0;
+}
+
+const HashSetEntry* hash_set_iterator_next(HashSetIterator* it) {
+    if (it == NULL || it->set == NULL) return NULL;
+
+    size_t index = hash_map_next_full(it->set->ctrl, it->set->capacity, it->position);
+    if (index == it->set->capacity) {
+        it->position = index;
+        return NULL;
+    }
+    it->position = index + 1;
+    return &it->set->slots[index];
+}
+
+void hash_set_for_each(const HashSet* set, void (*visit)(const HashSetEntry* entry, void* ctx), void* ctx) {
+    if (set == NULL || visit == NULL) return;
+
+    for (size_t i = hash_map_next_full(set->ctrl, set->capacity, 0); i < set->capacity;
+         i = hash_map_next_full(set->ctrl, set->capacity, i + 1)) {
+        visit(&set->slots[i], ctx);
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/*                              Set algebra                                  */
+/* ------------------------------------------------------------------------- */
+
+/* Adds every key of 'from' to 'into', reusing stored hashes when both hash alike. */
+static void hash_set_insert_all(HashSet* into, const HashSet* from) {
+    const int reuse = hash_set_same_hashing(into, from);
+    for (size_t i = hash_map_next_full(from->ctrl, from->capacity, 0); i < from->capacity;
+         i = hash_map_next_full(from->ctrl, from->capacity, i + 1)) {
+        const HashSetEntry* e = &from->slots[i];
+        uint64_t h64 = reuse ? e->hash : hash_set_hash_key(into, e->key, e->key_size);
+        (void)hash_set_insert_hashed(into, h64, e->key, e->key_size);
+    }
+}
+
+HashSet* hash_set_union(const HashSet* a, const HashSet* b) {
+    if (a == NULL || b == NULL) {
+        fprintf(stderr, "hash_set_union called with a NULL hash set\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    HashSet* result = build_hash_set_with_hash(a->hash_kind, a->hash_seed);
+    hash_set_reserve(result, a->size + b->size);
+    hash_set_insert_all(result, a);
+    hash_set_insert_all(result, b);
+    return result;
+}
+
+HashSet* hash_set_intersection(const HashSet* a, const HashSet* b) {
+    if (a == NULL || b == NULL) {
+        fprintf(stderr, "hash_set_intersection called with a NULL hash set\n");
+        exit(ATTEMPTED_ACCESS_TO_NULL_HASHMAP);
+    }
+
+    const HashSet* small = a->size <= b->size ? a : b;
+    const HashSet* large = a->size <= b->size ? b : a;
+    HashSet* result = build_hash_set_with_hash(a->hash_kind, a->hash_seed);
+    hash_set_reserve(result, small->size);
+
+    const int reuse_large  = hash_set_same_hashing(large, small);
+    const int reuse_result = hash_set_same_hashing(result, small);
+    for (size_t i = hash_map_next_full(small->ctrl, small->capacity, 0); i < small->capacity;
+         i = hash_map_next_full(small->ctrl, small->capacity, i + 1)) {
+        const HashSetEntry* e = &small->slots[i];
+        uint64_t h_large = reuse_large ? e->hash : hash_set_hash_key(large, e->key, e->key_size);
+        if (hash_set_find(large, h_large, e->key, e->key_size) == large->capacity) continue;
+
+        uint64_t h_result = reuse_result ? e->hash : hash_set_hash_key(result, e->key, e->key_size);
+        (void)hash_set_insert_hashed(result, h_result, e->key, e->key_size);
+    }
+    return result;
+}
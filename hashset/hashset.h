@@ -0,0 +1,100 @@
+#ifndef HASHSET_H
+#define HASHSET_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../hashmap/hashmap.h"
+
+/*
+ * ============================================================================
+ *  HashSet — Contracts & Ownership
+ * ============================================================================
+ * - Table: the HashMap engine (control-byte groups, triangular probing, 7/8
+ *   load, tombstones, see hashmap_table_impl.h) over HashSetEntry slots, which
+ *   carry no data / data_size: 40 bytes per slot instead of 56.
+ *
+ * - Keys: arbitrary bytes, ALWAYS deep-copied and owned by the set. Keys of
+ *   at most HASH_MAP_INLINE_KEY_SIZE bytes live inside the entry; longer ones
+ *   get a heap copy.
+ *
+ * - Hashing: same choices as HashMap (HASH_MAP_HASH_* kind + seed, see
+ *   build_hash_set_with_hash); build_hash_set() hashes like build_hash_map().
+ *
+ * - Union / intersection build a NEW set (using the first operand's hash
+ *   kind and seed) and leave both operands untouched. When both operands
+ *   hash the same way, stored hashes are reused and no key is rehashed.
+ *
+ * - Entry pointers (iteration) are valid until the next insert/remove.
+ *   Growth is stop-the-world.
+ *
+ * - Thread-safety: NOT thread-safe.
+ * ============================================================================
+ */
+
+/* One key of the set. Invariant: key_size <= HASH_MAP_INLINE_KEY_SIZE <=> key == inline_key. */
+typedef struct HashSetEntry {
+    uint64_t hash;
+    void*    key;       /* inline_key or a heap copy (owned by the set) */
+    size_t   key_size;
+    unsigned char inline_key[HASH_MAP_INLINE_KEY_SIZE];
+} HashSetEntry;
+
+typedef struct HashSet {
+    HashSetEntry* slots;      /* meaningful only where ctrl[i] is FULL */
+    uint8_t*      ctrl;       /* capacity + HASH_MAP_GROUP_WIDTH control bytes */
+    size_t        capacity;   /* power of two */
+    size_t        size;
+    size_t        tombstones;
+    int           hash_kind;  /* HASH_MAP_HASH_* */
+    uint64_t      hash_seed;
+} HashSet;
+
+/* Allocation-free iterator (memory order; stop using it after an insert). */
+typedef struct HashSetIterator {
+    const HashSet* set;
+    size_t         position;
+} HashSetIterator;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/* Build an empty set hashing like build_hash_map() (Murmur3, MUR_MUR_3_SEED). */
+HashSet* build_hash_set(void);
+
+/* Build an empty set hashing with 'hash_kind' (HASH_MAP_HASH_*) and 'seed'. */
+HashSet* build_hash_set_with_hash(int hash_kind, uint64_t seed);
+
+/* Destroy the set and every key copy it owns. */
+void hash_set_destroy(HashSet* set);
+
+/*
+ * Add 'key' (deep-copied).
+ * Returns: 1 if the key was added, 0 if it was already present.
+ */
+int hash_set_insert(HashSet* set, const void* key, size_t key_size);
+
+/* Returns: 1 if 'key' is in the set, 0 otherwise. */
+int hash_set_contains(const HashSet* set, const void* key, size_t key_size);
+
+/* Returns: 1 if 'key' was removed, 0 if it was not in the set. */
+int hash_set_remove(HashSet* set, const void* key, size_t key_size);
+
+void hash_set_iterator_init(HashSetIterator* it, const HashSet* set);
+
+/* Next entry, or NULL when every key has been visited. */
+const HashSetEntry* hash_set_iterator_next(HashSetIterator* it);
+
+/* Calls visit(entry, ctx) once per key. 'visit' must not modify the set. */
+void hash_set_for_each(const HashSet* set, void (*visit)(const HashSetEntry* entry, void* ctx), void* ctx);
+
+/* New set holding every key of 'a' or 'b'. */
+HashSet* hash_set_union(const HashSet* a, const HashSet* b);
+
+/* New set holding every key of both 'a' and 'b' (probes the larger with the smaller). */
+HashSet* hash_set_intersection(const HashSet* a, const HashSet* b);
+
+#endif /* HASHSET_H */
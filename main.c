@@ -1,9 +1,22 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L  /* pthread_rwlock_t in the concurrent map headers under -std=c11 */
+#endif
+
 #include <stdio.h>
 #include "tests/linked_list_tests.h"
 #include "tests/murmur3_tests.h"
+#include "tests/fast_hash_tests.h"
 #include "tests/hashing_utils_tests.h"
 #include "tests/linked_list_tests.h"
 #include "tests/hashmap_tests.h"
+#include "tests/concurrent_hashmap_tests.h"
+#include "tests/sharded_hashmap_tests.h"
+#include "tests/read_mostly_hashmap_tests.h"
+#include "tests/hashmap_image_tests.h"
+#include "tests/frozen_hashmap_tests.h"
+#include "tests/typed_hashmap_tests.h"
+#include "tests/hashset_tests.h"
+#include "tests/lru_cache_tests.h"
 #include "tests/bst_tests.h"
 #include "tests/matrix_tests.h"
 
@@ -12,7 +25,16 @@ int run_tests(){
     run_all_bst_tests();
     run_all_linked_list_tests();
     run_all_hashmap_tests();
+    run_all_concurrent_hashmap_tests();
+    run_all_sharded_hashmap_tests();
+    run_all_read_mostly_hashmap_tests();
+    run_all_hashmap_image_tests();
+    run_all_frozen_hashmap_tests();
+    run_all_typed_hashmap_tests();
+    run_all_hashset_tests();
+    run_all_lru_cache_tests();
     test_murmur3();
+    run_all_fast_hash_tests();
     return 0;
 }
 
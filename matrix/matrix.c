@@ -213,11 +213,170 @@ static void mm_muladd_ld(void *acc, const void *a, const void *b) {
 }
 static const MatrixOps MM_OPS_LD = { sizeof(long double), mm_zero_ld, mm_muladd_ld };
 
+/*  Type-specialized kernels  */
+
+/*
+ * The generic kernels below pay one indirect ops->muladd call per multiply-add,
+ * which blocks inlining and vectorization. For the built-in types the GEMM
+ * runs instead on kernels generated by MM_DEFINE_TYPED_KERNELS: same i-k-j
+ * loop order, but the inner loop is a plain typed axpy over restrict rows
+ * (C[i][j..] += A[i][k] * B[k][j..]) the compiler can vectorize.
+ * Custom MatrixOps tables supplied by the user keep the generic path.
+ */
+typedef void (*mm_naive_kernel_fn)(const void *A, const void *B, void *C,
+                                   size_t m, size_t p, size_t n);
+typedef void (*mm_blocked_kernel_fn)(const void *A, const void *B, void *C,
+                                     size_t m, size_t p, size_t n, size_t BS);
+/*
+ * C = alpha * A * B + beta * C on strided operands: element (i,k) of A is
+ * A[i*rsa + k*csa], (k,j) of B is B[k*rsb + j*csb], (i,j) of C is C[i*ldc + j].
+ * alpha/beta point to one element of the type.
+ */
+typedef void (*mm_into_kernel_fn)(const void *A, size_t rsa, size_t csa,
+                                  const void *B, size_t rsb, size_t csb,
+                                  void *C, size_t ldc,
+                                  size_t m, size_t p, size_t n,
+                                  const void *alpha, const void *beta);
+
+#define MM_DEFINE_TYPED_KERNELS(suffix, T)                                          \
+    /* c[0..len) += a * b[0..len); unrolled by 4 so -O2 can vectorize it too */   \
+    static inline void mm_axpy_##suffix(T *restrict c, T a,                         \
+                                        const T *restrict b, size_t len) {          \
+        size_t j = 0;                                                               \
+        for (; j + 4 <= len; j += 4) {                                              \
+            c[j]     += a * b[j];                                                   \
+            c[j + 1] += a * b[j + 1];                                               \
+            c[j + 2] += a * b[j + 2];                                               \
+            c[j + 3] += a * b[j + 3];                                               \
+        }                                                                           \
+        for (; j < len; ++j) c[j] += a * b[j];                                      \
+    }                                                                               \
+                                                                                    \
+    /* same with b[] strided (transposed B views) */                                \
+    static inline void mm_axpy_strided_##suffix(T *restrict c, T a,                 \
+                                                const T *restrict b, size_t stride, \
+                                                size_t len) {                       \
+        for (size_t j = 0; j < len; ++j) c[j] += a * b[j * stride];                 \
+    }                                                                               \
+                                                                                    \
+    /* c[0..len) = a * b[0..len * stride): first k-step when C is not read */      \
+    static inline void mm_axset_##suffix(T *restrict c, T a,                        \
+                                         const T *restrict b, size_t stride,        \
+                                         size_t len) {                              \
+        if (stride == 1) { for (size_t j = 0; j < len; ++j) c[j] = a * b[j]; }      \
+        else             { for (size_t j = 0; j < len; ++j) c[j] = a * b[j * stride]; } \
+    }                                                                               \
+                                                                                    \
+    static void mm_gemm_naive_##suffix(const void *A, const void *B, void *C,       \
+                                       size_t m, size_t p, size_t n) {              \
+        const T *a = (const T*)A;                                                   \
+        const T *b = (const T*)B;                                                   \
+        T       *c = (T*)C;                                                         \
+        if (p == 0) { for (size_t idx = 0; idx < m * n; ++idx) c[idx] = (T)0; return; } \
+        for (size_t i = 0; i < m; ++i) {                                            \
+            mm_axset_##suffix(c + i * n, a[i * p], b, 1, n);                        \
+            for (size_t k = 1; k < p; ++k) {                                        \
+                mm_axpy_##suffix(c + i * n, a[i * p + k], b + k * n, n);            \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    /* C = alpha * A * B + beta * C (strided, see mm_into_kernel_fn); beta == 0   \
+       overwrites C without reading it: the k == 0 step stores instead of adding */ \
+    static void mm_gemm_scaled_##suffix(const T *a, size_t rsa, size_t csa,         \
+                                        const T *b, size_t rsb, size_t csb,         \
+                                        T *c, size_t ldc,                           \
+                                        size_t m, size_t p, size_t n, size_t BS,    \
+                                        T alpha, T beta) {                          \
+        const int store_first = (beta == (T)0 && p > 0);                            \
+        if (beta != (T)1 && !store_first) {                                         \
+            for (size_t i = 0; i < m; ++i) {                                        \
+                T *ci = c + i * ldc;                                                \
+                if (beta == (T)0) { for (size_t j = 0; j < n; ++j) ci[j] = (T)0; }  \
+                else              { for (size_t j = 0; j < n; ++j) ci[j] *= beta; } \
+            }                                                                       \
+        }                                                                           \
+        for (size_t ii = 0; ii < m; ii += BS) {                                     \
+            const size_t i_max = (ii + BS < m) ? ii + BS : m;                       \
+            for (size_t kk = 0; kk < p; kk += BS) {                                 \
+                const size_t k_max = (kk + BS < p) ? kk + BS : p;                   \
+                for (size_t jj = 0; jj < n; jj += BS) {                             \
+                    const size_t j_len = ((jj + BS < n) ? jj + BS : n) - jj;        \
+                    for (size_t i = ii; i < i_max; ++i) {                           \
+                        for (size_t k = kk; k < k_max; ++k) {                       \
+                            const T aik = alpha * a[i * rsa + k * csa];             \
+                            const T *bk = b + k * rsb + jj * csb;                   \
+                            T *cij = c + i * ldc + jj;                              \
+                            if (k == 0 && store_first) mm_axset_##suffix(cij, aik, bk, csb, j_len); \
+                            else if (csb == 1) mm_axpy_##suffix(cij, aik, bk, j_len);   \
+                            else mm_axpy_strided_##suffix(cij, aik, bk, csb, j_len);    \
+                        }                                                           \
+                    }                                                               \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    static void mm_gemm_blocked_##suffix(const void *A, const void *B, void *C,     \
+                                         size_t m, size_t p, size_t n, size_t BS) { \
+        mm_gemm_scaled_##suffix((const T*)A, p, 1, (const T*)B, n, 1, (T*)C, n,     \
+                                m, p, n, BS, (T)1, (T)0);                           \
+    }                                                                               \
+                                                                                    \
+    static void mm_gemm_into_##suffix(const void *A, size_t rsa, size_t csa,        \
+                                      const void *B, size_t rsb, size_t csb,        \
+                                      void *C, size_t ldc,                          \
+                                      size_t m, size_t p, size_t n,                 \
+                                      const void *alpha, const void *beta) {        \
+        mm_gemm_scaled_##suffix((const T*)A, rsa, csa, (const T*)B, rsb, csb,       \
+                                (T*)C, ldc, m, p, n, MATRIX_INTO_BLOCK_SIZE,        \
+                                *(const T*)alpha, *(const T*)beta);                 \
+    }
+
+MM_DEFINE_TYPED_KERNELS(f64, double)
+MM_DEFINE_TYPED_KERNELS(f32, float)
+MM_DEFINE_TYPED_KERNELS(i32, int32_t)
+MM_DEFINE_TYPED_KERNELS(i64, int64_t)
+MM_DEFINE_TYPED_KERNELS(u32, uint32_t)
+MM_DEFINE_TYPED_KERNELS(st, size_t)
+MM_DEFINE_TYPED_KERNELS(ld, long double)
+
+/* Built-in ops table -> its typed kernels. */
+typedef struct MatrixTypedKernels {
+    const MatrixOps      *ops;
+    mm_naive_kernel_fn    naive;
+    mm_blocked_kernel_fn  blocked;
+    mm_into_kernel_fn     into;
+} MatrixTypedKernels;
+
+static const MatrixTypedKernels MM_TYPED_KERNELS[] = {
+    { &MM_OPS_F64, mm_gemm_naive_f64, mm_gemm_blocked_f64, mm_gemm_into_f64 },
+    { &MM_OPS_F32, mm_gemm_naive_f32, mm_gemm_blocked_f32, mm_gemm_into_f32 },
+    { &MM_OPS_I32, mm_gemm_naive_i32, mm_gemm_blocked_i32, mm_gemm_into_i32 },
+    { &MM_OPS_I64, mm_gemm_naive_i64, mm_gemm_blocked_i64, mm_gemm_into_i64 },
+    { &MM_OPS_U32, mm_gemm_naive_u32, mm_gemm_blocked_u32, mm_gemm_into_u32 },
+    { &MM_OPS_ST,  mm_gemm_naive_st,  mm_gemm_blocked_st,  mm_gemm_into_st  },
+    { &MM_OPS_LD,  mm_gemm_naive_ld,  mm_gemm_blocked_ld,  mm_gemm_into_ld  },
+};
+
+/* Typed kernels for a built-in table; NULL for user tables (generic path). */
+static const MatrixTypedKernels* mm_find_typed_kernels(const MatrixOps *ops) {
+    for (size_t i = 0; i < sizeof(MM_TYPED_KERNELS) / sizeof(MM_TYPED_KERNELS[0]); ++i) {
+        if (MM_TYPED_KERNELS[i].ops == ops) return &MM_TYPED_KERNELS[i];
+    }
+    return NULL;
+}
+
 /*  Internal helpers  */
 
 /* Return minimum of two size_t values. */
 static inline size_t mm_min_size(size_t a, size_t b) { return (a < b) ? a : b; }
 
+/* Facade heuristic: product large enough for the blocked/packed kernels. */
+static inline int mm_prefers_blocked(size_t m, size_t p, size_t n) {
+    return (m >= 64 && p >= 64 && n >= 64) || (m * n >= 4096) || (p >= 64);
+}
+
 /* Element-wise zeroing: safer than memset(0) for exotic types. */
 static void mm_zero_buffer_elemwise(void *data, size_t elem_count, const MatrixOps *ops) {
     char *ptr = (char*)data;
@@ -283,6 +442,7 @@ static const MatrixOps* mm_pick_builtin_ops_by_size(size_t elem_size) {
 /*
  * NAIVE GENERIC GEMM (row-major)
  * Computes C = A * B with triple-nested loops.
+ * Built-in tables run their typed kernel; user tables go through ops->muladd.
  * Order i-k-j improves reuse of B's rows in cache.
  * Complexity: O(m*p*n)
  */
@@ -302,6 +462,12 @@ static Matrix* matrix_multiply_ex_naive(const Matrix *A, const Matrix *B, const
         destroy_matrix(C);
         return NULL;
     }
+
+    const MatrixTypedKernels *typed = mm_find_typed_kernels(ops);
+    if (typed) {
+        typed->naive(A->data, B->data, C->data, m, p, n);
+        return C;
+    }
     mm_zero_buffer_elemwise(C->data, total_bytes / ops->elem_size, ops);
 
     const size_t as = A->cols;  // p
@@ -332,6 +498,7 @@ static Matrix* matrix_multiply_ex_naive(const Matrix *A, const Matrix *B, const
  * BLOCKED (tiled) GENERIC GEMM
  * Processes submatrices (tiles) of size BS to improve cache locality.
  * BS is expressed in elements (e.g., 32, 64, 128). Tune to your CPU.
+ * Built-in tables run their typed kernel; user tables go through ops->muladd.
  */
 static Matrix* matrix_multiply_ex_blocked(const Matrix *A, const Matrix *B,
                                           const MatrixOps *ops, size_t BS) {
@@ -351,6 +518,12 @@ static Matrix* matrix_multiply_ex_blocked(const Matrix *A, const Matrix *B,
         destroy_matrix(C);
         return NULL;
     }
+
+    const MatrixTypedKernels *typed = mm_find_typed_kernels(ops);
+    if (typed) {
+        typed->blocked(A->data, B->data, C->data, m, p, n, BS);
+        return C;
+    }
     mm_zero_buffer_elemwise(C->data, total_bytes / ops->elem_size, ops);
 
     const size_t as = A->cols;  // p
@@ -387,11 +560,621 @@ static Matrix* matrix_multiply_ex_blocked(const Matrix *A, const Matrix *B,
     return C;
 }
 
+/*  Packed GEMM (f32 / f64)  */
+
+/*
+ * GotoBLAS/BLIS-style path for the floating types:
+ *   - loops over NC-wide column panels of B, KC-deep slices of the inner
+ *     dimension and MC-tall row panels of A (sizes in matrix.h);
+ *   - each B slice / A panel is copied ("packed") into a contiguous buffer laid
+ *     out in NR-wide / MR-tall slivers, so the innermost loop streams both
+ *     operands linearly and the packed B slice stays in L2/L3;
+ *   - an MR x NR micro-kernel keeps its whole C tile in registers over the KC
+ *     loop (f64: 4x8, f32: 6x16 — 8 and 12 AVX2 accumulators).
+ * The micro-kernel is picked at run time: AVX2+FMA when the CPU has it (x86
+ * with GCC/Clang), else a portable scalar kernel with the same tile shape.
+ * Defining MATRIX_NO_SIMD forces the scalar kernel. Edge tiles are computed
+ * into a local MR x NR buffer (packing zero-pads) and merged into C.
+ * Windows builds (MinGW) use the scalar kernel: GCC there does not realign
+ * the stack for 32-byte __m256 spills (GCC PR 54412), so the AVX2 kernels
+ * could fault on aligned loads/stores, most visibly at -O0.
+ */
+#if !defined(MATRIX_NO_SIMD) && !defined(_WIN32) && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define MM_HAVE_AVX2_KERNELS 1
+#include <immintrin.h>
+#else
+#define MM_HAVE_AVX2_KERNELS 0
+#endif
+
+#define MM_F64_MR 4
+#define MM_F64_NR 8
+#define MM_F32_MR 6
+#define MM_F32_NR 16
+
+/* MR x NR tile of C (row stride ldc) = alpha * A_sliver * B_sliver + beta * C; beta == 0 never reads C. */
+typedef void (*mm_ukernel_f64_fn)(size_t kc, const double *a, const double *b,
+                                  double *c, size_t ldc, double alpha, double beta);
+typedef void (*mm_ukernel_f32_fn)(size_t kc, const float *a, const float *b,
+                                  float *c, size_t ldc, float alpha, float beta);
+
+#define MM_DEFINE_SCALAR_UKERNEL(suffix, T, MR, NR)                                 \
+    static void mm_ukernel_scalar_##suffix(size_t kc, const T *a, const T *b,       \
+                                           T *c, size_t ldc, T alpha, T beta) {     \
+        T ab[(MR) * (NR)] = { 0 };                                                  \
+        for (size_t p = 0; p < kc; ++p, a += (MR), b += (NR)) {                     \
+            for (size_t r = 0; r < (MR); ++r) {                                     \
+                const T ar = a[r];                                                  \
+                for (size_t j = 0; j < (NR); ++j) ab[r * (NR) + j] += ar * b[j];    \
+            }                                                                       \
+        }                                                                           \
+        for (size_t r = 0; r < (MR); ++r) {                                         \
+            for (size_t j = 0; j < (NR); ++j) {                                     \
+                const T v = alpha * ab[r * (NR) + j];                               \
+                c[r * ldc + j] = (beta == (T)0) ? v : v + beta * c[r * ldc + j];    \
+            }                                                                       \
+        }                                                                           \
+    }
+
+MM_DEFINE_SCALAR_UKERNEL(f64, double, MM_F64_MR, MM_F64_NR)
+MM_DEFINE_SCALAR_UKERNEL(f32, float,  MM_F32_MR, MM_F32_NR)
+
+#if MM_HAVE_AVX2_KERNELS
+static int mm_cpu_has_avx2_fma(void) {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+__attribute__((target("avx2,fma")))
+static void mm_ukernel_avx2_f64(size_t kc, const double *a, const double *b,
+                                double *c, size_t ldc, double alpha, double beta) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for (size_t p = 0; p < kc; ++p, a += MM_F64_MR, b += MM_F64_NR) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d ar;
+        ar = _mm256_broadcast_sd(a + 0); c00 = _mm256_fmadd_pd(ar, b0, c00); c01 = _mm256_fmadd_pd(ar, b1, c01);
+        ar = _mm256_broadcast_sd(a + 1); c10 = _mm256_fmadd_pd(ar, b0, c10); c11 = _mm256_fmadd_pd(ar, b1, c11);
+        ar = _mm256_broadcast_sd(a + 2); c20 = _mm256_fmadd_pd(ar, b0, c20); c21 = _mm256_fmadd_pd(ar, b1, c21);
+        ar = _mm256_broadcast_sd(a + 3); c30 = _mm256_fmadd_pd(ar, b0, c30); c31 = _mm256_fmadd_pd(ar, b1, c31);
+    }
+
+    __m256d acc[MM_F64_MR][2] = { { c00, c01 }, { c10, c11 }, { c20, c21 }, { c30, c31 } };
+    if (alpha != 1.0) {
+        const __m256d va = _mm256_set1_pd(alpha);
+        for (size_t r = 0; r < MM_F64_MR; ++r) {
+            acc[r][0] = _mm256_mul_pd(va, acc[r][0]);
+            acc[r][1] = _mm256_mul_pd(va, acc[r][1]);
+        }
+    }
+    if (beta == 0.0) {
+        for (size_t r = 0; r < MM_F64_MR; ++r) {
+            _mm256_storeu_pd(c + r * ldc,     acc[r][0]);
+            _mm256_storeu_pd(c + r * ldc + 4, acc[r][1]);
+        }
+    } else {
+        const __m256d vb = _mm256_set1_pd(beta);
+        for (size_t r = 0; r < MM_F64_MR; ++r) {
+            _mm256_storeu_pd(c + r * ldc,     _mm256_fmadd_pd(vb, _mm256_loadu_pd(c + r * ldc),     acc[r][0]));
+            _mm256_storeu_pd(c + r * ldc + 4, _mm256_fmadd_pd(vb, _mm256_loadu_pd(c + r * ldc + 4), acc[r][1]));
+        }
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void mm_ukernel_avx2_f32(size_t kc, const float *a, const float *b,
+                                float *c, size_t ldc, float alpha, float beta) {
+    __m256 acc[MM_F32_MR][2];
+    for (size_t r = 0; r < MM_F32_MR; ++r) acc[r][0] = acc[r][1] = _mm256_setzero_ps();
+
+    for (size_t p = 0; p < kc; ++p, a += MM_F32_MR, b += MM_F32_NR) {
+        const __m256 b0 = _mm256_loadu_ps(b);
+        const __m256 b1 = _mm256_loadu_ps(b + 8);
+        for (size_t r = 0; r < MM_F32_MR; ++r) {   /* fully unrolled by the compiler: 12 accumulators */
+            const __m256 ar = _mm256_broadcast_ss(a + r);
+            acc[r][0] = _mm256_fmadd_ps(ar, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_ps(ar, b1, acc[r][1]);
+        }
+    }
+
+    if (alpha != 1.0f) {
+        const __m256 va = _mm256_set1_ps(alpha);
+        for (size_t r = 0; r < MM_F32_MR; ++r) {
+            acc[r][0] = _mm256_mul_ps(va, acc[r][0]);
+            acc[r][1] = _mm256_mul_ps(va, acc[r][1]);
+        }
+    }
+
+    if (beta == 0.0f) {
+        for (size_t r = 0; r < MM_F32_MR; ++r) {
+            _mm256_storeu_ps(c + r * ldc,     acc[r][0]);
+            _mm256_storeu_ps(c + r * ldc + 8, acc[r][1]);
+        }
+    } else {
+        const __m256 vb = _mm256_set1_ps(beta);
+        for (size_t r = 0; r < MM_F32_MR; ++r) {
+            _mm256_storeu_ps(c + r * ldc,     _mm256_fmadd_ps(vb, _mm256_loadu_ps(c + r * ldc),     acc[r][0]));
+            _mm256_storeu_ps(c + r * ldc + 8, _mm256_fmadd_ps(vb, _mm256_loadu_ps(c + r * ldc + 8), acc[r][1]));
+        }
+    }
+}
+#endif /* MM_HAVE_AVX2_KERNELS */
+
+static mm_ukernel_f64_fn mm_select_ukernel_f64(void) {
+#if MM_HAVE_AVX2_KERNELS
+    if (mm_cpu_has_avx2_fma()) return mm_ukernel_avx2_f64;
+#endif
+    return mm_ukernel_scalar_f64;
+}
+
+static mm_ukernel_f32_fn mm_select_ukernel_f32(void) {
+#if MM_HAVE_AVX2_KERNELS
+    if (mm_cpu_has_avx2_fma()) return mm_ukernel_avx2_f32;
+#endif
+    return mm_ukernel_scalar_f32;
+}
+
+/* 64-byte aligned scratch buffer; *raw receives the pointer to free(). */
+static void* mm_alloc_aligned(size_t bytes, void **raw) {
+    *raw = malloc(bytes + 64);
+    if (!*raw) return NULL;
+    return (void*)(((uintptr_t)*raw + 63) & ~(uintptr_t)63);
+}
+
+/* Packing buffer sizes (elements) for an m x k block of A / a k x n block of B. */
+static size_t mm_pack_a_elems(size_t m, size_t k, size_t mr) {
+    const size_t mc = mm_min_size(MATRIX_GEMM_MC, m);
+    return mm_min_size(MATRIX_GEMM_KC, k) * ((mc + mr - 1) / mr) * mr;
+}
+static size_t mm_pack_b_elems(size_t n, size_t k, size_t nr) {
+    const size_t nc = mm_min_size(MATRIX_GEMM_NC, n);
+    return mm_min_size(MATRIX_GEMM_KC, k) * ((nc + nr - 1) / nr) * nr;
+}
+
+/*
+ * MM_DEFINE_PACKED_GEMM generates, for one floating type:
+ *   mm_pack_a_*  : mc x kc block of A -> MR-tall slivers (p-major, zero-padded)
+ *   mm_pack_b_*  : kc x nc block of B -> NR-wide slivers (p-major, zero-padded)
+ *   mm_gemm_packed_ws_* : C (m x n, row stride ldc) = alpha * A (m x k) * B (k x n)
+ *                         with A, B strided as in mm_into_kernel_fn (packing
+ *                         absorbs transposed views at no extra cost)
+ *                         + beta * C on caller-provided packing buffers
+ *                         (beta == 0 overwrites C without reading it);
+ *   mm_gemm_packed_*    : same, allocating the buffers. Returns 1 on success,
+ *                         0 if the packing buffers cannot be allocated.
+ */
+#define MM_DEFINE_PACKED_GEMM(suffix, T, MR, NR)                                    \
+    static void mm_pack_a_##suffix(size_t mc, size_t kc, const T *A,                \
+                                   size_t rsa, size_t csa, T *dst) {                \
+        for (size_t ir = 0; ir < mc; ir += (MR)) {                                  \
+            const size_t mr = mm_min_size((MR), mc - ir);                           \
+            for (size_t p = 0; p < kc; ++p) {                                       \
+                for (size_t r = 0; r < mr; ++r) dst[r] = A[(ir + r) * rsa + p * csa]; \
+                for (size_t r = mr; r < (MR); ++r) dst[r] = (T)0;                   \
+                dst += (MR);                                                        \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    static void mm_pack_b_##suffix(size_t kc, size_t nc, const T *B,                \
+                                   size_t rsb, size_t csb, T *dst) {                \
+        for (size_t jr = 0; jr < nc; jr += (NR)) {                                  \
+            const size_t nr = mm_min_size((NR), nc - jr);                           \
+            for (size_t p = 0; p < kc; ++p) {                                       \
+                const T *bp = B + p * rsb + jr * csb;                               \
+                if (csb == 1) memcpy(dst, bp, nr * sizeof(T));                      \
+                else for (size_t j = 0; j < nr; ++j) dst[j] = bp[j * csb];          \
+                for (size_t j = nr; j < (NR); ++j) dst[j] = (T)0;                   \
+                dst += (NR);                                                        \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    /* Driver on caller-provided packing buffers (sizes: mm_pack_*_elems). */      \
+    static void mm_gemm_packed_ws_##suffix(size_t m, size_t n, size_t k,            \
+                                           const T *A, size_t rsa, size_t csa,      \
+                                           const T *B, size_t rsb, size_t csb,      \
+                                           T *C, size_t ldc, T alpha, T beta,       \
+                                           T *a_pack, T *b_pack) {                  \
+        if (k == 0) {                                                               \
+            for (size_t i = 0; i < m; ++i)                                          \
+                for (size_t j = 0; j < n; ++j)                                      \
+                    C[i * ldc + j] = (beta == (T)0) ? (T)0 : beta * C[i * ldc + j]; \
+            return;                                                                 \
+        }                                                                           \
+        const mm_ukernel_##suffix##_fn kernel = mm_select_ukernel_##suffix();       \
+        T tile[(MR) * (NR)];                                                        \
+                                                                                    \
+        for (size_t jc = 0; jc < n; jc += MATRIX_GEMM_NC) {                         \
+            const size_t nc = mm_min_size(MATRIX_GEMM_NC, n - jc);                  \
+            for (size_t pc = 0; pc < k; pc += MATRIX_GEMM_KC) {                     \
+                const size_t kc = mm_min_size(MATRIX_GEMM_KC, k - pc);              \
+                const T beta_k = (pc == 0) ? beta : (T)1;  /* later slices accumulate */ \
+                mm_pack_b_##suffix(kc, nc, B + pc * rsb + jc * csb, rsb, csb, b_pack); \
+                for (size_t ic = 0; ic < m; ic += MATRIX_GEMM_MC) {                 \
+                    const size_t mc = mm_min_size(MATRIX_GEMM_MC, m - ic);          \
+                    mm_pack_a_##suffix(mc, kc, A + ic * rsa + pc * csa, rsa, csa, a_pack); \
+                    for (size_t jr = 0; jr < nc; jr += (NR)) {                      \
+                        const size_t nr = mm_min_size((NR), nc - jr);               \
+                        const T *b_sliver = b_pack + jr * kc;                       \
+                        for (size_t ir = 0; ir < mc; ir += (MR)) {                  \
+                            const size_t mr = mm_min_size((MR), mc - ir);           \
+                            const T *a_sliver = a_pack + ir * kc;                   \
+                            T *c_tile = C + (ic + ir) * ldc + jc + jr;              \
+                            if (mr == (MR) && nr == (NR)) {                         \
+                                kernel(kc, a_sliver, b_sliver, c_tile, ldc,         \
+                                       alpha, beta_k);                              \
+                                continue;                                           \
+                            }                                                       \
+                            kernel(kc, a_sliver, b_sliver, tile, (NR), alpha, (T)0); \
+                            for (size_t r = 0; r < mr; ++r) {                       \
+                                for (size_t j = 0; j < nr; ++j) {                   \
+                                    T *cij = c_tile + r * ldc + j;                  \
+                                    *cij = (beta_k == (T)0) ? tile[r * (NR) + j]    \
+                                                  : tile[r * (NR) + j] + beta_k * *cij; \
+                                }                                                   \
+                            }                                                       \
+                        }                                                           \
+                    }                                                               \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    static int mm_gemm_packed_##suffix(size_t m, size_t n, size_t k,                \
+                                       const T *A, size_t rsa, size_t csa,          \
+                                       const T *B, size_t rsb, size_t csb,          \
+                                       T *C, size_t ldc, T alpha, T beta) {         \
+        void *a_raw, *b_raw;                                                        \
+        T *a_pack = (T*)mm_alloc_aligned(mm_pack_a_elems(m, k, (MR)) * sizeof(T), &a_raw); \
+        T *b_pack = (T*)mm_alloc_aligned(mm_pack_b_elems(n, k, (NR)) * sizeof(T), &b_raw); \
+        if (!a_pack || !b_pack) {                                                   \
+            free(a_raw); free(b_raw);                                               \
+            return 0;                                                               \
+        }                                                                           \
+        mm_gemm_packed_ws_##suffix(m, n, k, A, rsa, csa, B, rsb, csb, C, ldc,       \
+                                   alpha, beta,                                     \
+                                   a_pack, b_pack);                                 \
+        free(a_raw);                                                                \
+        free(b_raw);                                                                \
+        return 1;                                                                   \
+    }
+
+MM_DEFINE_PACKED_GEMM(f64, double, MM_F64_MR, MM_F64_NR)
+MM_DEFINE_PACKED_GEMM(f32, float,  MM_F32_MR, MM_F32_NR)
+
+/*
+ * PACKED GEMM front-end: validates like the other variants, allocates C and
+ * runs the packed kernel of the built-in floating table 'ops'.
+ */
+static Matrix* matrix_multiply_ex_packed(const Matrix *A, const Matrix *B, const MatrixOps *ops) {
+    size_t m, p, n;
+    if (!mm_check_preconditions_generic(A, B, ops, &m, &p, &n)) return NULL;
+
+    Matrix *C = new_matrix(m, n, ops->elem_size);
+    if (!C) {
+        fprintf(stderr, "matrix_multiply: failed to allocate result matrix\n");
+        return NULL;
+    }
+
+    int ok = (ops == &MM_OPS_F32)
+        ? mm_gemm_packed_f32(m, n, p, (const float*)A->data, p, 1, (const float*)B->data, n, 1, (float*)C->data, n, 1.0f, 0.0f)
+        : mm_gemm_packed_f64(m, n, p, (const double*)A->data, p, 1, (const double*)B->data, n, 1, (double*)C->data, n, 1.0, 0.0);
+    if (!ok) {
+        fprintf(stderr, "matrix_multiply: failed to allocate packing buffers\n");
+        destroy_matrix(C);
+        return NULL;
+    }
+    return C;
+}
+
+/*  Parallel GEMM  */
+
+/*
+ * C is cut into tiles that a MatrixThreadPool hands out (with work stealing);
+ * tiles cover disjoint parts of C, so they need no synchronization:
+ *   - f32/f64: MATRIX_GEMM_MC x MATRIX_PARALLEL_TILE_N tiles, each a packed
+ *     GEMM of A's row panel by B's column panel, on packing buffers owned by
+ *     the worker (allocated once per call, not per tile);
+ *   - other built-in types: bands of MATRIX_PARALLEL_TILE_ROWS rows, each a
+ *     typed blocked kernel over those rows of A and the whole of B.
+ */
+typedef struct MatrixParallelJob {
+    const MatrixOps          *ops;
+    const MatrixTypedKernels *typed;
+    const char *a;
+    const char *b;
+    char       *c;
+    size_t m, p, n;
+    size_t tile_rows, tile_cols, tiles_per_row;
+    char  *scratch;         /* f32/f64 only: per-worker A then B packing buffers */
+    size_t scratch_stride;  /* bytes per worker */
+    size_t a_pack_bytes;
+} MatrixParallelJob;
+
+static size_t mm_round_up_64(size_t bytes) { return (bytes + 63) & ~(size_t)63; }
+
+static void mm_parallel_tile(size_t task, unsigned worker, void *ctx) {
+    const MatrixParallelJob *job = (const MatrixParallelJob*)ctx;
+    const size_t i0   = (task / job->tiles_per_row) * job->tile_rows;
+    const size_t j0   = (task % job->tiles_per_row) * job->tile_cols;
+    const size_t rows = mm_min_size(job->tile_rows, job->m - i0);
+    const size_t cols = mm_min_size(job->tile_cols, job->n - j0);
+    const size_t p = job->p, n = job->n;
+
+    if (job->ops == &MM_OPS_F64) {
+        double *a_pack = (double*)(job->scratch + worker * job->scratch_stride);
+        double *b_pack = (double*)((char*)a_pack + job->a_pack_bytes);
+        mm_gemm_packed_ws_f64(rows, cols, p, (const double*)job->a + i0 * p, p, 1,
+                              (const double*)job->b + j0, n, 1,
+                              (double*)job->c + i0 * n + j0, n, 1.0, 0.0, a_pack, b_pack);
+    } else if (job->ops == &MM_OPS_F32) {
+        float *a_pack = (float*)(job->scratch + worker * job->scratch_stride);
+        float *b_pack = (float*)((char*)a_pack + job->a_pack_bytes);
+        mm_gemm_packed_ws_f32(rows, cols, p, (const float*)job->a + i0 * p, p, 1,
+                              (const float*)job->b + j0, n, 1,
+                              (float*)job->c + i0 * n + j0, n, 1.0f, 0.0f, a_pack, b_pack);
+    } else {
+        const size_t es = job->ops->elem_size;
+        job->typed->blocked(job->a + i0 * p * es, job->b, job->c + i0 * n * es, rows, p, n, 64);
+    }
+}
+
+/*
+ * PARALLEL GEMM front-end: validates, allocates C, tiles it and runs the
+ * tiles on 'pool'. A NULL or single-worker pool runs the serial kernel of the
+ * type; user ops tables have no typed kernel to tile and run the
+ * single-threaded blocked path.
+ */
+static Matrix* matrix_multiply_ex_parallel(MatrixThreadPool *pool, const Matrix *A, const Matrix *B,
+                                           const MatrixOps *ops) {
+    size_t m, p, n;
+    if (!mm_check_preconditions_generic(A, B, ops, &m, &p, &n)) return NULL;
+
+    MatrixParallelJob job;
+    memset(&job, 0, sizeof job);
+    job.ops = ops;
+    job.typed = mm_find_typed_kernels(ops);
+    if (!job.typed) return matrix_multiply_ex_blocked(A, B, ops, /*BS=*/64);
+    if (matrix_thread_pool_size(pool) == 1) {
+        /* one worker: the untiled kernel packs each panel once instead of once per tile */
+        return (ops == &MM_OPS_F64 || ops == &MM_OPS_F32) ? matrix_multiply_ex_packed(A, B, ops)
+                                                          : matrix_multiply_ex_blocked(A, B, ops, /*BS=*/64);
+    }
+
+    Matrix *C = new_matrix(m, n, ops->elem_size);
+    if (!C) {
+        fprintf(stderr, "matrix_multiply: failed to allocate result matrix\n");
+        return NULL;
+    }
+    job.a = (const char*)A->data;
+    job.b = (const char*)B->data;
+    job.c = (char*)C->data;
+    job.m = m; job.p = p; job.n = n;
+
+    void *scratch_raw = NULL;
+    if (ops == &MM_OPS_F64 || ops == &MM_OPS_F32) {
+        const size_t mr = (ops == &MM_OPS_F64) ? MM_F64_MR : MM_F32_MR;
+        const size_t nr = (ops == &MM_OPS_F64) ? MM_F64_NR : MM_F32_NR;
+        job.tile_rows = MATRIX_GEMM_MC;
+        job.tile_cols = MATRIX_PARALLEL_TILE_N;
+        job.a_pack_bytes = mm_round_up_64(mm_pack_a_elems(m, p, mr) * ops->elem_size);
+        job.scratch_stride = job.a_pack_bytes +
+            mm_round_up_64(mm_pack_b_elems(mm_min_size(MATRIX_PARALLEL_TILE_N, n), p, nr) * ops->elem_size);
+        job.scratch = (char*)mm_alloc_aligned(job.scratch_stride * matrix_thread_pool_size(pool), &scratch_raw);
+        if (!job.scratch) {
+            fprintf(stderr, "matrix_multiply: failed to allocate packing buffers\n");
+            free(scratch_raw);
+            destroy_matrix(C);
+            return NULL;
+        }
+    } else {
+        job.tile_rows = MATRIX_PARALLEL_TILE_ROWS;
+        job.tile_cols = n;
+    }
+    job.tiles_per_row = (n + job.tile_cols - 1) / job.tile_cols;
+
+    const size_t tiles = ((m + job.tile_rows - 1) / job.tile_rows) * job.tiles_per_row;
+    matrix_thread_pool_run(pool, tiles, mm_parallel_tile, &job);
+
+    free(scratch_raw);
+    return C;
+}
+
+/*  Views  */
+
+/*
+ * A MatrixView addresses a rows x cols window of row-major storage with a
+ * leading dimension (row_stride, in elements); 'transposed' swaps the roles
+ * of rows and columns without moving data. Internally a view is a pair of
+ * element strides: (i,j) lives at data + (i*rs + j*cs) * size_of_element.
+ */
+static size_t mm_view_rs(const MatrixView *v) { return v->transposed ? 1 : v->row_stride; }
+static size_t mm_view_cs(const MatrixView *v) { return v->transposed ? v->row_stride : 1; }
+
+static MatrixView mm_null_view(void) {
+    MatrixView v;
+    memset(&v, 0, sizeof v);
+    return v;
+}
+
+MatrixView matrix_view_of(const Matrix *M) {
+    if (!M || !M->data) {
+        fprintf(stderr, "matrix_view_of: NULL matrix\n");
+        return mm_null_view();
+    }
+    MatrixView v;
+    v.data = M->data;
+    v.rows = M->rows;
+    v.cols = M->cols;
+    v.row_stride = M->cols;
+    v.size_of_element = M->size_of_element;
+    v.transposed = 0;
+    return v;
+}
+
+MatrixView matrix_view_sub(const MatrixView *v, size_t r0, size_t c0, size_t rows, size_t cols) {
+    if (!v || !v->data) {
+        fprintf(stderr, "matrix_view_sub: NULL view\n");
+        return mm_null_view();
+    }
+    if (rows == 0 || cols == 0 || r0 > v->rows || rows > v->rows - r0 || c0 > v->cols || cols > v->cols - c0) {
+        fprintf(stderr, "matrix_view_sub: window [%zu+%zu, %zu+%zu] out of a %zux%zu view\n",
+                r0, rows, c0, cols, v->rows, v->cols);
+        return mm_null_view();
+    }
+    MatrixView sub = *v;
+    sub.data = (char*)v->data + (r0 * mm_view_rs(v) + c0 * mm_view_cs(v)) * v->size_of_element;
+    sub.rows = rows;
+    sub.cols = cols;
+    return sub;
+}
+
+MatrixView matrix_view_rows(const MatrixView *v, size_t r0, size_t count) {
+    return matrix_view_sub(v, r0, 0, count, v ? v->cols : 0);
+}
+
+MatrixView matrix_view_transpose(const MatrixView *v) {
+    if (!v || !v->data) return mm_null_view();
+    MatrixView t = *v;
+    t.rows = v->cols;
+    t.cols = v->rows;
+    t.transposed = !v->transposed;
+    return t;
+}
+
+void* matrix_view_at(const MatrixView *v, size_t i, size_t j) {
+    if (!v || !v->data || i >= v->rows || j >= v->cols) return NULL;
+    return (char*)v->data + (i * mm_view_rs(v) + j * mm_view_cs(v)) * v->size_of_element;
+}
+
+/* Well-formed view: data, non-zero shape, stride covering a stored row. */
+static int mm_view_valid(const MatrixView *v, const char *name) {
+    if (!v || !v->data || v->rows == 0 || v->cols == 0 || v->size_of_element == 0) {
+        fprintf(stderr, "matrix_multiply_view: NULL or empty view %s\n", name);
+        return 0;
+    }
+    const size_t stored_cols = v->transposed ? v->rows : v->cols;
+    if (v->row_stride < stored_cols) {
+        fprintf(stderr, "matrix_multiply_view: row_stride %zu of %s is shorter than a row (%zu)\n",
+                v->row_stride, name, stored_cols);
+        return 0;
+    }
+    return 1;
+}
+
+/* 1 if the byte ranges spanned by the two views intersect (conservative). */
+static int mm_views_overlap(const MatrixView *x, const MatrixView *y) {
+    const char *x_lo = (const char*)x->data;
+    const char *y_lo = (const char*)y->data;
+    const char *x_hi = x_lo + ((x->rows - 1) * mm_view_rs(x) + (x->cols - 1) * mm_view_cs(x) + 1) * x->size_of_element;
+    const char *y_hi = y_lo + ((y->rows - 1) * mm_view_rs(y) + (y->cols - 1) * mm_view_cs(y) + 1) * y->size_of_element;
+    return x_lo < y_hi && y_lo < x_hi;
+}
+
+/*
+ * Strided core shared by the Matrix and view entry points (operands already
+ * validated, C disjoint from A and B). A transposed C is computed as
+ * C^T = B^T * A^T so that C's rows are always contiguous.
+ */
+static int mm_gemm_view_core(const MatrixOps *ops, const MatrixView *Cv, const MatrixView *Av,
+                             const MatrixView *Bv, const void *alpha, const void *beta) {
+    MatrixView c = *Cv, a = *Av, b = *Bv;
+    if (c.transposed) {
+        c = matrix_view_transpose(Cv);
+        a = matrix_view_transpose(Bv);
+        b = matrix_view_transpose(Av);
+    }
+    const size_t m = c.rows, p = a.cols, n = c.cols;
+
+    int ok = 1;
+    if (mm_prefers_blocked(m, p, n) && ops == &MM_OPS_F64) {
+        ok = mm_gemm_packed_f64(m, n, p, (const double*)a.data, mm_view_rs(&a), mm_view_cs(&a),
+                                (const double*)b.data, mm_view_rs(&b), mm_view_cs(&b),
+                                (double*)c.data, c.row_stride, *(const double*)alpha, *(const double*)beta);
+    } else if (mm_prefers_blocked(m, p, n) && ops == &MM_OPS_F32) {
+        ok = mm_gemm_packed_f32(m, n, p, (const float*)a.data, mm_view_rs(&a), mm_view_cs(&a),
+                                (const float*)b.data, mm_view_rs(&b), mm_view_cs(&b),
+                                (float*)c.data, c.row_stride, *(const float*)alpha, *(const float*)beta);
+    } else {
+        mm_find_typed_kernels(ops)->into(a.data, mm_view_rs(&a), mm_view_cs(&a),
+                                         b.data, mm_view_rs(&b), mm_view_cs(&b),
+                                         c.data, c.row_stride, m, p, n, alpha, beta);
+    }
+    if (!ok) fprintf(stderr, "matrix_multiply_into: failed to allocate packing buffers\n");
+    return ok;
+}
+
+/* Validate C, A, B views against each other and the ops table. */
+static int mm_check_views(const MatrixView *C, const MatrixView *A, const MatrixView *B, const MatrixOps *ops) {
+    if (!mm_view_valid(A, "A") || !mm_view_valid(B, "B") || !mm_view_valid(C, "C")) return 0;
+    if (!ops) {
+        fprintf(stderr, "matrix_multiply_view: missing MatrixOps table\n");
+        return 0;
+    }
+    if (A->cols != B->rows || C->rows != A->rows || C->cols != B->cols) {
+        fprintf(stderr, "matrix_multiply_view: dimension mismatch (%zux%zu * %zux%zu into %zux%zu)\n",
+                A->rows, A->cols, B->rows, B->cols, C->rows, C->cols);
+        return 0;
+    }
+    if (A->size_of_element != ops->elem_size || B->size_of_element != ops->elem_size ||
+        C->size_of_element != ops->elem_size) {
+        fprintf(stderr, "matrix_multiply_view: element size/type mismatch (A=%zu, B=%zu, C=%zu, ops=%zu bytes)\n",
+                A->size_of_element, B->size_of_element, C->size_of_element, ops->elem_size);
+        return 0;
+    }
+    if (mm_views_overlap(C, A) || mm_views_overlap(C, B)) {
+        fprintf(stderr, "matrix_multiply_view: C must not overlap the memory of A or B\n");
+        return 0;
+    }
+    return 1;
+}
+
+static int matrix_multiply_ex_view_into(const MatrixView *C, const MatrixView *A, const MatrixView *B,
+                                        const MatrixOps *ops, const void *alpha, const void *beta) {
+    if (!mm_check_views(C, A, B, ops)) return 0;
+    return mm_gemm_view_core(ops, C, A, B, alpha, beta);
+}
+
+/*
+ * INTO front-end: C = alpha * A * B + beta * C in C's own storage.
+ * Large f32/f64 products run the packed kernel, whose packing buffers are the
+ * only allocation; everything else runs the typed scaled kernel, which
+ * allocates nothing. beta == 0 overwrites C without reading it (NaN/garbage
+ * in C does not propagate), as in BLAS.
+ */
+static int matrix_multiply_ex_into(Matrix *C, const Matrix *A, const Matrix *B,
+                                   const MatrixOps *ops, const void *alpha, const void *beta) {
+    size_t m, p, n;
+    if (!mm_check_preconditions_generic(A, B, ops, &m, &p, &n)) return 0;
+    if (!C || !C->data) {
+        fprintf(stderr, "matrix_multiply_into: NULL output matrix\n");
+        return 0;
+    }
+    if (C->rows != m || C->cols != n || C->size_of_element != ops->elem_size) {
+        fprintf(stderr,
+            "matrix_multiply_into: output mismatch (C is %zux%zu of %zu bytes, expected %zux%zu of %zu)\n",
+            C->rows, C->cols, C->size_of_element, m, n, ops->elem_size);
+        return 0;
+    }
+    if (C->data == A->data || C->data == B->data) {
+        fprintf(stderr, "matrix_multiply_into: output must not share storage with A or B\n");
+        return 0;
+    }
+
+    const MatrixView cv = matrix_view_of(C), av = matrix_view_of(A), bv = matrix_view_of(B);
+    return mm_gemm_view_core(ops, &cv, &av, &bv, alpha, beta);
+}
+
 /* Public facade + typed wrappers */
 
 /* 
  * matrix_multiply — facade with heuristic kernel choice
- * Purpose: C = A × B (row-major). Allocates C and runs the naive or blocked kernel.
+ * Purpose: C = A × B (row-major). Allocates C and runs the naive or blocked kernel
+ * (the packed micro-kernel path for large float/double products).
  * Dispatch: picks a built-in MatrixOps by element SIZE (float/double preferred).
  * WARNING: size-based dispatch is ambiguous (4B: float/int32/uint32, 8B: double/int64/size_t).
  * If A/B store integers or long double, call the typed wrappers instead.
@@ -421,23 +1204,154 @@ Matrix* matrix_multiply(Matrix *A, Matrix *B) {
         return NULL;
     }
 
-    const size_t m = A->rows, p = A->cols, n = B->cols;
-    const int use_blocked =
-        (m >= 64 && p >= 64 && n >= 64) || (m * n >= 4096) || (p >= 64);
+    const int use_blocked = mm_prefers_blocked(A->rows, A->cols, B->cols);
 
-    if (use_blocked) {
+    if (use_blocked && (ops == &MM_OPS_F64 || ops == &MM_OPS_F32)) {
+        return matrix_multiply_ex_packed(A, B, ops);
+    } else if (use_blocked) {
         return matrix_multiply_ex_blocked(A, B, ops, /*BS=*/64);
     } else {
         return matrix_multiply_ex_naive(A, B, ops);
     }
 }
 
+/*
+ * matrix_multiply_parallel — facade over the parallel path
+ * Same size-based dispatch (and the same WARNING) as matrix_multiply.
+ */
+Matrix* matrix_multiply_parallel(MatrixThreadPool *pool, Matrix *A, Matrix *B) {
+    if (!A || !B) {
+        fprintf(stderr, "matrix_multiply: NULL matrix pointer\n");
+        return NULL;
+    }
+    const MatrixOps *ops = mm_pick_builtin_ops_by_size(A->size_of_element);
+    if (!ops) {
+        fprintf(stderr,
+            "matrix_multiply: unsupported or ambiguous element size %zu. "
+            "Use typed wrappers (e.g., matrix_multiply_i64_parallel).\n",
+            A->size_of_element);
+        return NULL;
+    }
+    return matrix_multiply_ex_parallel(pool, A, B, ops);
+}
+
+/*
+ * matrix_multiply_into — facade for C = alpha * A * B + beta * C
+ * Same size-based dispatch (and the same WARNING) as matrix_multiply;
+ * alpha and beta are converted to the picked floating type.
+ */
+int matrix_multiply_into(Matrix *C, const Matrix *A, const Matrix *B, double alpha, double beta) {
+    if (!A) {
+        fprintf(stderr, "matrix_multiply_into: NULL matrix pointer\n");
+        return 0;
+    }
+    const MatrixOps *ops = mm_pick_builtin_ops_by_size(A->size_of_element);
+    if (ops == &MM_OPS_F64) return matrix_multiply_into_f64(C, A, B, alpha, beta);
+    if (ops == &MM_OPS_F32) return matrix_multiply_into_f32(C, A, B, (float)alpha, (float)beta);
+    if (ops == &MM_OPS_LD)  return matrix_multiply_into_ld (C, A, B, (long double)alpha, (long double)beta);
+    fprintf(stderr,
+        "matrix_multiply_into: unsupported or ambiguous element size %zu. "
+        "Use typed variants (e.g., matrix_multiply_into_i64).\n",
+        A->size_of_element);
+    return 0;
+}
+
+int matrix_multiply_into_f64 (Matrix *C, const Matrix *A, const Matrix *B, double alpha, double beta)           { return matrix_multiply_ex_into(C, A, B, &MM_OPS_F64, &alpha, &beta); }
+int matrix_multiply_into_f32 (Matrix *C, const Matrix *A, const Matrix *B, float alpha, float beta)             { return matrix_multiply_ex_into(C, A, B, &MM_OPS_F32, &alpha, &beta); }
+int matrix_multiply_into_i32 (Matrix *C, const Matrix *A, const Matrix *B, int32_t alpha, int32_t beta)         { return matrix_multiply_ex_into(C, A, B, &MM_OPS_I32, &alpha, &beta); }
+int matrix_multiply_into_i64 (Matrix *C, const Matrix *A, const Matrix *B, int64_t alpha, int64_t beta)         { return matrix_multiply_ex_into(C, A, B, &MM_OPS_I64, &alpha, &beta); }
+int matrix_multiply_into_u32 (Matrix *C, const Matrix *A, const Matrix *B, uint32_t alpha, uint32_t beta)       { return matrix_multiply_ex_into(C, A, B, &MM_OPS_U32, &alpha, &beta); }
+int matrix_multiply_into_size(Matrix *C, const Matrix *A, const Matrix *B, size_t alpha, size_t beta)           { return matrix_multiply_ex_into(C, A, B, &MM_OPS_ST,  &alpha, &beta); }
+int matrix_multiply_into_ld  (Matrix *C, const Matrix *A, const Matrix *B, long double alpha, long double beta) { return matrix_multiply_ex_into(C, A, B, &MM_OPS_LD,  &alpha, &beta); }
+
+/*
+ * matrix_multiply_view_into — facade for views, C = alpha * A * B + beta * C
+ * Same size-based dispatch (and the same WARNING) as matrix_multiply_into.
+ */
+int matrix_multiply_view_into(const MatrixView *C, const MatrixView *A, const MatrixView *B,
+                              double alpha, double beta) {
+    if (!A) {
+        fprintf(stderr, "matrix_multiply_view: NULL view\n");
+        return 0;
+    }
+    const MatrixOps *ops = mm_pick_builtin_ops_by_size(A->size_of_element);
+    if (ops == &MM_OPS_F64) return matrix_multiply_view_into_f64(C, A, B, alpha, beta);
+    if (ops == &MM_OPS_F32) return matrix_multiply_view_into_f32(C, A, B, (float)alpha, (float)beta);
+    if (ops == &MM_OPS_LD)  return matrix_multiply_view_into_ld (C, A, B, (long double)alpha, (long double)beta);
+    fprintf(stderr,
+        "matrix_multiply_view: unsupported or ambiguous element size %zu. "
+        "Use typed variants (e.g., matrix_multiply_view_into_i64).\n",
+        A->size_of_element);
+    return 0;
+}
+
+int matrix_multiply_view_into_f64 (const MatrixView *C, const MatrixView *A, const MatrixView *B, double alpha, double beta)           { return matrix_multiply_ex_view_into(C, A, B, &MM_OPS_F64, &alpha, &beta); }
+int matrix_multiply_view_into_f32 (const MatrixView *C, const MatrixView *A, const MatrixView *B, float alpha, float beta)             { return matrix_multiply_ex_view_into(C, A, B, &MM_OPS_F32, &alpha, &beta); }
+int matrix_multiply_view_into_i32 (const MatrixView *C, const MatrixView *A, const MatrixView *B, int32_t alpha, int32_t beta)         { return matrix_multiply_ex_view_into(C, A, B, &MM_OPS_I32, &alpha, &beta); }
+int matrix_multiply_view_into_i64 (const MatrixView *C, const MatrixView *A, const MatrixView *B, int64_t alpha, int64_t beta)         { return matrix_multiply_ex_view_into(C, A, B, &MM_OPS_I64, &alpha, &beta); }
+int matrix_multiply_view_into_u32 (const MatrixView *C, const MatrixView *A, const MatrixView *B, uint32_t alpha, uint32_t beta)       { return matrix_multiply_ex_view_into(C, A, B, &MM_OPS_U32, &alpha, &beta); }
+int matrix_multiply_view_into_size(const MatrixView *C, const MatrixView *A, const MatrixView *B, size_t alpha, size_t beta)           { return matrix_multiply_ex_view_into(C, A, B, &MM_OPS_ST,  &alpha, &beta); }
+int matrix_multiply_view_into_ld  (const MatrixView *C, const MatrixView *A, const MatrixView *B, long double alpha, long double beta) { return matrix_multiply_ex_view_into(C, A, B, &MM_OPS_LD,  &alpha, &beta); }
+
+/*
+ * matrix_multiply_view_ops — C = A * B on views with a custom operator table.
+ * Generic strided triple loop: one set_zero per C element, one muladd per term.
+ */
+int matrix_multiply_view_ops(const MatrixView *C, const MatrixView *A, const MatrixView *B, const void *ops_opaque) {
+    const MatrixOps *ops = (const MatrixOps*)ops_opaque;
+    if (!mm_check_views(C, A, B, ops)) return 0;
+
+    const size_t es = ops->elem_size;
+    const size_t rsa = mm_view_rs(A), csa = mm_view_cs(A);
+    const size_t rsb = mm_view_rs(B), csb = mm_view_cs(B);
+    const size_t rsc = mm_view_rs(C), csc = mm_view_cs(C);
+    const char *ad = (const char*)A->data;
+    const char *bd = (const char*)B->data;
+    char       *cd = (char*)C->data;
+
+    for (size_t i = 0; i < C->rows; ++i) {
+        for (size_t j = 0; j < C->cols; ++j) {
+            char *Cij = cd + (i * rsc + j * csc) * es;
+            ops->set_zero(Cij);
+            for (size_t k = 0; k < A->cols; ++k) {
+                ops->muladd(Cij, ad + (i * rsa + k * csa) * es, bd + (k * rsb + j * csb) * es);
+            }
+        }
+    }
+    return 1;
+}
+
 /* ----- Typed wrappers: explicit, unambiguous API for the user ----- */
 /* Each function validates that A/B actually carry the declared element size. */
 
 Matrix* matrix_multiply_f64_naive   (const Matrix *A, const Matrix *B) { return matrix_multiply_ex_naive  (A, B, &MM_OPS_F64); }
 Matrix* matrix_multiply_f64_blocked (const Matrix *A, const Matrix *B, size_t BS) { return matrix_multiply_ex_blocked(A, B, &MM_OPS_F64, BS); }
 
+Matrix* matrix_multiply_f64_packed  (const Matrix *A, const Matrix *B) { return matrix_multiply_ex_packed (A, B, &MM_OPS_F64); }
+Matrix* matrix_multiply_f32_packed  (const Matrix *A, const Matrix *B) { return matrix_multiply_ex_packed (A, B, &MM_OPS_F32); }
+
+Matrix* matrix_multiply_f64_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B) { return matrix_multiply_ex_parallel(pool, A, B, &MM_OPS_F64); }
+Matrix* matrix_multiply_f32_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B) { return matrix_multiply_ex_parallel(pool, A, B, &MM_OPS_F32); }
+Matrix* matrix_multiply_i32_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B) { return matrix_multiply_ex_parallel(pool, A, B, &MM_OPS_I32); }
+Matrix* matrix_multiply_i64_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B) { return matrix_multiply_ex_parallel(pool, A, B, &MM_OPS_I64); }
+Matrix* matrix_multiply_u32_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B) { return matrix_multiply_ex_parallel(pool, A, B, &MM_OPS_U32); }
+Matrix* matrix_multiply_size_parallel(MatrixThreadPool *pool, const Matrix *A, const Matrix *B) { return matrix_multiply_ex_parallel(pool, A, B, &MM_OPS_ST); }
+Matrix* matrix_multiply_ld_parallel  (MatrixThreadPool *pool, const Matrix *A, const Matrix *B) { return matrix_multiply_ex_parallel(pool, A, B, &MM_OPS_LD); }
+
+/* Name of the micro-kernel the packed path runs on this CPU. */
+const char* matrix_gemm_kernel_name(void) {
+#if MM_HAVE_AVX2_KERNELS
+    if (mm_cpu_has_avx2_fma()) return "avx2-fma";
+#endif
+    return "scalar";
+}
+
+Matrix* matrix_multiply_f32_naive   (const Matrix *A, const Matrix *B) { return matrix_multiply_ex_naive  (A, B, &MM_OPS_F32); }
+Matrix* matrix_multiply_f32_blocked (const Matrix *A, const Matrix *B, size_t BS) { return matrix_multiply_ex_blocked(A, B, &MM_OPS_F32, BS); }
+
+Matrix* matrix_multiply_i32_naive   (const Matrix *A, const Matrix *B) { return matrix_multiply_ex_naive  (A, B, &MM_OPS_I32); }
+Matrix* matrix_multiply_i32_blocked (const Matrix *A, const Matrix *B, size_t BS) { return matrix_multiply_ex_blocked(A, B, &MM_OPS_I32, BS); }
+
 Matrix* matrix_multiply_i64_naive   (const Matrix *A, const Matrix *B) { return matrix_multiply_ex_naive  (A, B, &MM_OPS_I64); }
 Matrix* matrix_multiply_i64_blocked (const Matrix *A, const Matrix *B, size_t BS) { return matrix_multiply_ex_blocked(A, B, &MM_OPS_I64, BS); }
 
@@ -6,6 +6,7 @@
 #include <stddef.h>  // size_t
 #include <stdint.h>  // SIZE_MAX
 #include <string.h>  // memset, memcpy
+#include "matrix_thread_pool.h"
 
 /*
     Matrix module does not own data. 
@@ -17,6 +18,30 @@
 #define INVALID_MATRIX_CREATION_PARAMETER -80
 #define FAILED_MATRIX_ALLOCATION         -79
 
+/* Cache blocking of the packed f32/f64 GEMM (elements; MC a multiple of 4 and 6, NC of 8 and 16) */
+#ifndef MATRIX_GEMM_MC
+#define MATRIX_GEMM_MC 96      /* rows of A packed per panel (L2)             */
+#endif
+#ifndef MATRIX_GEMM_KC
+#define MATRIX_GEMM_KC 256     /* depth of one packed slice (L1 sliver reuse) */
+#endif
+#ifndef MATRIX_GEMM_NC
+#define MATRIX_GEMM_NC 4096    /* columns of B packed per panel (L3)          */
+#endif
+
+/* Tiles of C handed to the thread pool by the *_parallel multiplies */
+#ifndef MATRIX_PARALLEL_TILE_N
+#define MATRIX_PARALLEL_TILE_N    256  /* f32/f64: MATRIX_GEMM_MC x TILE_N tiles (multiple of 16) */
+#endif
+#ifndef MATRIX_PARALLEL_TILE_ROWS
+#define MATRIX_PARALLEL_TILE_ROWS 64   /* other types: row bands of this height */
+#endif
+
+/* Tile size of the typed kernel behind matrix_multiply_into_* (elements) */
+#ifndef MATRIX_INTO_BLOCK_SIZE
+#define MATRIX_INTO_BLOCK_SIZE 64
+#endif
+
 typedef struct Matrix {
     size_t rows;             // number of rows (M)
     size_t cols;             // number of columns (N)
@@ -25,6 +50,25 @@ typedef struct Matrix {
     void **row;              // row[i] points to the start of row i within data
 } Matrix;
 
+/*
+ * MatrixView: non-owning window on row-major storage (no copies).
+ * Logical element (i,j), 0 <= i < rows, 0 <= j < cols, lives at
+ *   data + (i*row_stride + j) * size_of_element   when transposed == 0
+ *   data + (j*row_stride + i) * size_of_element   when transposed == 1
+ * row_stride is the leading dimension of the underlying storage (elements
+ * between consecutive stored rows). Views of a Matrix stay valid as long as
+ * the Matrix does. A view with data == NULL is the "invalid view" returned
+ * on errors; the multiply functions reject it.
+ */
+typedef struct MatrixView {
+    void  *data;             // logical element (0,0)
+    size_t rows;             // logical rows
+    size_t cols;             // logical columns
+    size_t row_stride;       // leading dimension of the stored layout, in elements
+    size_t size_of_element;
+    int    transposed;       // 1: rows and columns of the storage are swapped
+} MatrixView;
+
 /*
  * operator table: (MatrixOps)
  * Defines how to handle a single element: write-zero and mul-add.
@@ -128,6 +172,7 @@ Matrix* matrix_multiply_for_scalar(size_t m, size_t n, void* k, size_t size_of_d
  *
  * Recommendation:
  *   For integers and long double, use the explicit typed wrappers:
+ *     - matrix_multiply_i32_*   for int32_t
  *     - matrix_multiply_i64_*   for int64_t
  *     - matrix_multiply_u32_*   for uint32_t
  *     - matrix_multiply_size_*  for size_t
@@ -155,6 +200,8 @@ Matrix* matrix_multiply(Matrix *A, Matrix *B);
  * Variants:
  *   *_naive   — minimal overhead (good for small matrices)
  *   *_blocked — tiled kernel for cache reuse; pass BS (e.g., 32/64/128)
+ * All built-in types (these wrappers and the facade) run type-specialized
+ * kernels with plain typed inner loops; no per-element function-pointer call.
  */
 /* ----- Explicit typed wrappers (unambiguous and recommended) ----- */
 
@@ -162,6 +209,14 @@ Matrix* matrix_multiply(Matrix *A, Matrix *B);
 Matrix* matrix_multiply_f64_naive   (const Matrix *A, const Matrix *B);
 Matrix* matrix_multiply_f64_blocked (const Matrix *A, const Matrix *B, size_t BS);
 
+/* float (f32) */
+Matrix* matrix_multiply_f32_naive   (const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_f32_blocked (const Matrix *A, const Matrix *B, size_t BS);
+
+/* int32_t (i32) */
+Matrix* matrix_multiply_i32_naive   (const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_i32_blocked (const Matrix *A, const Matrix *B, size_t BS);
+
 /* int64_t (i64) */
 Matrix* matrix_multiply_i64_naive   (const Matrix *A, const Matrix *B);
 Matrix* matrix_multiply_i64_blocked (const Matrix *A, const Matrix *B, size_t BS);
@@ -178,6 +233,103 @@ Matrix* matrix_multiply_size_blocked(const Matrix *A, const Matrix *B, size_t BS
 Matrix* matrix_multiply_ld_naive    (const Matrix *A, const Matrix *B);
 Matrix* matrix_multiply_ld_blocked  (const Matrix *A, const Matrix *B, size_t BS);
 
+/* -----------------------------------------------------------------------
+ * High-performance float/double path (GotoBLAS/BLIS style).
+ * Packs panels of A and B into contiguous slivers and runs a register-blocked
+ * micro-kernel (f64 4x8, f32 6x16). The kernel is chosen at run time:
+ * AVX2+FMA when available (x86 GCC/Clang, not on Windows), otherwise a portable scalar one;
+ * -DMATRIX_NO_SIMD forces the scalar kernel. Same contract as the wrappers
+ * above; results may differ from naive/blocked in the last bits (different
+ * summation order, fused multiply-add). matrix_multiply() uses this path for
+ * large float/double products.
+ * ----------------------------------------------------------------------- */
+Matrix* matrix_multiply_f64_packed  (const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_f32_packed  (const Matrix *A, const Matrix *B);
+
+/* "avx2-fma" or "scalar": micro-kernel used by the packed path on this CPU. */
+const char* matrix_gemm_kernel_name(void);
+
+/* -----------------------------------------------------------------------
+ * GEMM into a caller-provided output: C = alpha * A * B + beta * C.
+ * Reuses C's storage, so iterative code multiplying same-shaped matrices
+ * allocates no result per call.
+ * Not allocation-free for large f32/f64 products: an m x p times p x n
+ * product with all of m, p, n >= 64, or m * n >= 4096, or p >= 64 (the
+ * size dispatch of matrix_multiply) takes the packed path, which still
+ * mallocs and frees its packing buffers on every call. Failure to get them
+ * returns 0. Every other case allocates nothing.
+ * Contract: the usual A/B contract, plus C non-NULL, C->rows == A->rows,
+ * C->cols == B->cols, same element size, and C not sharing A's or B's data.
+ * beta == 0 overwrites C without reading it (no zero-fill pass, stale
+ * NaN/garbage in C is ignored); beta == 1 accumulates into C.
+ * Returns 1 on success, 0 on failure (C untouched).
+ * matrix_multiply_into uses the size-based dispatch of matrix_multiply (same
+ * WARNING; floating types only); prefer the typed variants for integers.
+ * ----------------------------------------------------------------------- */
+int matrix_multiply_into     (Matrix *C, const Matrix *A, const Matrix *B, double alpha, double beta);
+int matrix_multiply_into_f64 (Matrix *C, const Matrix *A, const Matrix *B, double alpha, double beta);
+int matrix_multiply_into_f32 (Matrix *C, const Matrix *A, const Matrix *B, float alpha, float beta);
+int matrix_multiply_into_i32 (Matrix *C, const Matrix *A, const Matrix *B, int32_t alpha, int32_t beta);
+int matrix_multiply_into_i64 (Matrix *C, const Matrix *A, const Matrix *B, int64_t alpha, int64_t beta);
+int matrix_multiply_into_u32 (Matrix *C, const Matrix *A, const Matrix *B, uint32_t alpha, uint32_t beta);
+int matrix_multiply_into_size(Matrix *C, const Matrix *A, const Matrix *B, size_t alpha, size_t beta);
+int matrix_multiply_into_ld  (Matrix *C, const Matrix *A, const Matrix *B, long double alpha, long double beta);
+
+/* -----------------------------------------------------------------------
+ * Views: sub-blocks, row ranges and transposes without copies.
+ * Constructors return an invalid view (data == NULL) on NULL input or
+ * out-of-range windows. Views compose: a sub-view of a transposed view is a
+ * transposed view of the matching stored block.
+ * ----------------------------------------------------------------------- */
+MatrixView matrix_view_of       (const Matrix *M);                          /* whole matrix */
+MatrixView matrix_view_sub      (const MatrixView *v, size_t r0, size_t c0,
+                                 size_t rows, size_t cols);                 /* window at (r0,c0) */
+MatrixView matrix_view_rows     (const MatrixView *v, size_t r0, size_t count); /* rows [r0, r0+count) */
+MatrixView matrix_view_transpose(const MatrixView *v);                      /* swap rows/cols */
+
+/* Address of logical element (i,j), NULL when out of range or invalid view. */
+void* matrix_view_at(const MatrixView *v, size_t i, size_t j);
+
+/*
+ * GEMM on views: C = alpha * A * B + beta * C, all three may be sub-blocks,
+ * row ranges or transposes of larger matrices. Same kernels as
+ * matrix_multiply_into_* (packed micro-kernel for large f32/f64, which packs
+ * transposed operands directly and allocates its packing buffers per call;
+ * typed kernel otherwise) and same semantics for alpha/beta. C must not overlap the memory span of A or B (checked
+ * conservatively on the address ranges the views cover).
+ * Returns 1 on success, 0 on failure (C untouched).
+ * matrix_multiply_view_ops runs C = A * B with a custom MatrixOps table.
+ * ----------------------------------------------------------------------- */
+int matrix_multiply_view_into     (const MatrixView *C, const MatrixView *A, const MatrixView *B, double alpha, double beta);
+int matrix_multiply_view_into_f64 (const MatrixView *C, const MatrixView *A, const MatrixView *B, double alpha, double beta);
+int matrix_multiply_view_into_f32 (const MatrixView *C, const MatrixView *A, const MatrixView *B, float alpha, float beta);
+int matrix_multiply_view_into_i32 (const MatrixView *C, const MatrixView *A, const MatrixView *B, int32_t alpha, int32_t beta);
+int matrix_multiply_view_into_i64 (const MatrixView *C, const MatrixView *A, const MatrixView *B, int64_t alpha, int64_t beta);
+int matrix_multiply_view_into_u32 (const MatrixView *C, const MatrixView *A, const MatrixView *B, uint32_t alpha, uint32_t beta);
+int matrix_multiply_view_into_size(const MatrixView *C, const MatrixView *A, const MatrixView *B, size_t alpha, size_t beta);
+int matrix_multiply_view_into_ld  (const MatrixView *C, const MatrixView *A, const MatrixView *B, long double alpha, long double beta);
+int matrix_multiply_view_ops      (const MatrixView *C, const MatrixView *A, const MatrixView *B, const void *ops_opaque);
+
+/* -----------------------------------------------------------------------
+ * Multithreaded multiply on a MatrixThreadPool (see matrix_thread_pool.h).
+ * C is cut into tiles (f32/f64: packed-GEMM tiles of MATRIX_GEMM_MC x
+ * MATRIX_PARALLEL_TILE_N; other types: bands of MATRIX_PARALLEL_TILE_ROWS
+ * rows) that the pool's workers share with work stealing. The thread count is
+ * the pool's: build_matrix_thread_pool(n), 0 = one per online CPU. A NULL
+ * or single-thread pool runs the serial kernel instead. Same contract and results
+ * as the single-threaded kernels; one multiply at a time per pool.
+ * matrix_multiply_parallel uses the size-based dispatch of matrix_multiply
+ * (same WARNING); prefer the typed variants for integers.
+ * ----------------------------------------------------------------------- */
+Matrix* matrix_multiply_parallel     (MatrixThreadPool *pool, Matrix *A, Matrix *B);
+Matrix* matrix_multiply_f64_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_f32_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_i32_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_i64_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_u32_parallel (MatrixThreadPool *pool, const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_size_parallel(MatrixThreadPool *pool, const Matrix *A, const Matrix *B);
+Matrix* matrix_multiply_ld_parallel  (MatrixThreadPool *pool, const Matrix *A, const Matrix *B);
+
 /* -----------------------------------------------------------------------
  * Optional (advanced): generic entry points that accept a custom operator
  * table (opaque pointer). This allows you to plug in your own arithmetic
@@ -219,9 +371,11 @@ Matrix* matrix_multiply_blocked_ops (Matrix *A, Matrix *B, const void *ops_opaqu
  *                                   block size in elements (typical: 32/64/128).
  *
  * Note:
- *   Advanced API. For standard primitive types prefer the typed
- *   wrappers (matrix_multiply_f64_*, _i64_*, _u32_*, _size_*, _ld_*) or the
- *   default matrix_multiply(A,B) when appropriate.
+ *   Advanced API. Custom tables cost one indirect muladd call per element,
+ *   so for standard primitive types prefer the typed wrappers
+ *   (matrix_multiply_f64_*, _f32_*, _i32_*, _i64_*, _u32_*, _size_*, _ld_*),
+ *   which run vectorizable typed kernels, or the default matrix_multiply(A,B)
+ *   when appropriate.
  * ----------------------------------------------------------------------- */
 Matrix* matrix_multiply_naive_ops   (Matrix *A, Matrix *B, const void *ops_opaque);
 Matrix* matrix_multiply_blocked_ops (Matrix *A, Matrix *B, const void *ops_opaque, size_t BS);
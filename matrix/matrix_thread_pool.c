@@ -0,0 +1,236 @@
+#include "matrix_thread_pool.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>  /* GetActiveProcessorCount, GetSystemInfo */
+#else
+#include <unistd.h>   /* sysconf */
+#endif
+
+/*
+ * ============================================================================
+ *  MatrixThreadPool — parked workers + range stealing
+ * ============================================================================
+ * A run publishes (fn, ctx) under the pool lock and bumps 'generation'; the
+ * background workers wake up, the caller works as worker 0, and the caller
+ * then waits on done_cv until every background worker left the run.
+ * Each worker pops tasks from the front of its own queue; when it is empty
+ * it takes the upper half of a victim's remaining range. A steal holds one
+ * queue lock at a time (victim first, then its own), so no lock ordering is
+ * needed. A worker that finds every queue empty is done for this run.
+ * ============================================================================
+ */
+
+/* Lock helpers: a failing pthread call means a corrupted lock → abort like the rest of the lib. */
+static void matrix_thread_pool_lock(pthread_mutex_t* lock) {
+    if (pthread_mutex_lock(lock) != 0) {
+        fprintf(stderr, "MatrixThreadPool: failed to acquire lock\n");
+        exit(FAILED_MATRIX_THREAD_POOL_LOCK);
+    }
+}
+
+static void matrix_thread_pool_unlock(pthread_mutex_t* lock) {
+    if (pthread_mutex_unlock(lock) != 0) {
+        fprintf(stderr, "MatrixThreadPool: failed to release lock\n");
+        exit(FAILED_MATRIX_THREAD_POOL_LOCK);
+    }
+}
+
+/* Pop the next task of 'queue'. Returns 1 and sets *task, or 0 if empty. */
+static int matrix_thread_pool_take(MatrixWorkerQueue* queue, size_t* task) {
+    int found = 0;
+    matrix_thread_pool_lock(&queue->lock);
+    if (queue->next < queue->end) {
+        *task = queue->next++;
+        found = 1;
+    }
+    matrix_thread_pool_unlock(&queue->lock);
+    return found;
+}
+
+/* Move the upper half of some victim's remaining range into worker 'self'. Returns 0 if all are empty. */
+static int matrix_thread_pool_steal(MatrixThreadPool* pool, unsigned self) {
+    for (unsigned offset = 1; offset < pool->thread_count; ++offset) {
+        MatrixWorkerQueue* victim = &pool->queues[(self + offset) % pool->thread_count];
+        size_t lo = 0, hi = 0;
+
+        matrix_thread_pool_lock(&victim->lock);
+        if (victim->next < victim->end) {
+            size_t remaining = victim->end - victim->next;
+            hi = victim->end;
+            lo = hi - (remaining + 1) / 2;
+            victim->end = lo;
+        }
+        matrix_thread_pool_unlock(&victim->lock);
+
+        if (lo < hi) {
+            MatrixWorkerQueue* own = &pool->queues[self];
+            matrix_thread_pool_lock(&own->lock);
+            own->next = lo;
+            own->end = hi;
+            matrix_thread_pool_unlock(&own->lock);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Worker 'self' runs tasks until no queue has any left. */
+static void matrix_thread_pool_work(MatrixThreadPool* pool, unsigned self, MatrixTaskFn fn, void* ctx) {
+    size_t task;
+    do {
+        while (matrix_thread_pool_take(&pool->queues[self], &task)) {
+            fn(task, self, ctx);
+        }
+    } while (matrix_thread_pool_steal(pool, self));
+}
+
+static void* matrix_thread_pool_worker_main(void* arg) {
+    MatrixWorkerQueue* queue = (MatrixWorkerQueue*)arg;
+    MatrixThreadPool* pool = queue->pool;
+    const unsigned self = (unsigned)(queue - pool->queues);
+    unsigned long seen = 0;
+
+    for (;;) {
+        matrix_thread_pool_lock(&pool->lock);
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        if (pool->shutdown) {
+            matrix_thread_pool_unlock(&pool->lock);
+            return NULL;
+        }
+        seen = pool->generation;
+        MatrixTaskFn fn = pool->fn;
+        void* ctx = pool->ctx;
+        matrix_thread_pool_unlock(&pool->lock);
+
+        matrix_thread_pool_work(pool, self, fn, ctx);
+
+        matrix_thread_pool_lock(&pool->lock);
+        if (--pool->running == 0) pthread_cond_signal(&pool->done_cv);
+        matrix_thread_pool_unlock(&pool->lock);
+    }
+}
+
+/* Online CPUs, 1 when unknown. */
+static unsigned matrix_thread_pool_online_cpus(void) {
+#if defined(_WIN32)
+#if defined(ALL_PROCESSOR_GROUPS)  /* Windows 7+ headers: count every processor group */
+    DWORD cpus = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    if (cpus > 0) return (unsigned)cpus;
+#endif
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);  /* caller's processor group only (at most 64 CPUs) */
+    if (info.dwNumberOfProcessors > 0) return (unsigned)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus > 0) return (unsigned)cpus;
+#endif
+    return 1;
+}
+
+/* Stop the first 'started' background workers and release everything. */
+static void matrix_thread_pool_teardown(MatrixThreadPool* pool, unsigned started) {
+    matrix_thread_pool_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    matrix_thread_pool_unlock(&pool->lock);
+
+    for (unsigned t = 0; t < started; ++t) pthread_join(pool->threads[t], NULL);
+    for (unsigned w = 0; w < pool->thread_count; ++w) pthread_mutex_destroy(&pool->queues[w].lock);
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->queues);
+    free(pool->threads);
+    free(pool);
+}
+
+/*
+ * Builds the pool: one queue per worker, then starts thread_count - 1
+ * background threads (the caller is worker 0).
+ */
+MatrixThreadPool* build_matrix_thread_pool(unsigned thread_count) {
+    if (thread_count == 0) thread_count = matrix_thread_pool_online_cpus();
+    if (thread_count > MATRIX_THREAD_POOL_MAX_THREADS) thread_count = MATRIX_THREAD_POOL_MAX_THREADS;
+
+    MatrixThreadPool* pool = calloc(1, sizeof(MatrixThreadPool));
+    if (!pool) {
+        fprintf(stderr, "build_matrix_thread_pool: failed to allocate pool\n");
+        return NULL;
+    }
+    pool->thread_count = thread_count;
+    pool->queues = calloc(thread_count, sizeof(MatrixWorkerQueue));
+    pool->threads = calloc(thread_count, sizeof(pthread_t));  /* one spare slot keeps calloc(0) out */
+    if (!pool->queues || !pool->threads) {
+        fprintf(stderr, "build_matrix_thread_pool: failed to allocate worker tables\n");
+        free(pool->queues);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+    for (unsigned w = 0; w < thread_count; ++w) {
+        pthread_mutex_init(&pool->queues[w].lock, NULL);
+        pool->queues[w].pool = pool;
+    }
+
+    for (unsigned t = 0; t + 1 < thread_count; ++t) {
+        if (pthread_create(&pool->threads[t], NULL, matrix_thread_pool_worker_main, &pool->queues[t + 1]) != 0) {
+            fprintf(stderr, "build_matrix_thread_pool: failed to start worker %u\n", t + 1);
+            matrix_thread_pool_teardown(pool, t);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void matrix_thread_pool_destroy(MatrixThreadPool* pool) {
+    if (!pool) return;
+    matrix_thread_pool_teardown(pool, pool->thread_count - 1);
+}
+
+unsigned matrix_thread_pool_size(const MatrixThreadPool* pool) {
+    return pool ? pool->thread_count : 1;
+}
+
+/*
+ * Splits [0, task_count) evenly over the queues, wakes the background
+ * workers, works as worker 0 and waits for the others to finish.
+ */
+void matrix_thread_pool_run(MatrixThreadPool* pool, size_t task_count, MatrixTaskFn fn, void* ctx) {
+    if (!fn || task_count == 0) return;
+    if (!pool || pool->thread_count == 1 || task_count == 1) {
+        for (size_t task = 0; task < task_count; ++task) fn(task, 0, ctx);
+        return;
+    }
+
+    const size_t workers = pool->thread_count;
+    for (size_t w = 0; w < workers; ++w) {
+        MatrixWorkerQueue* queue = &pool->queues[w];
+        matrix_thread_pool_lock(&queue->lock);
+        queue->next = task_count * w / workers;
+        queue->end = task_count * (w + 1) / workers;
+        matrix_thread_pool_unlock(&queue->lock);
+    }
+
+    matrix_thread_pool_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->running = pool->thread_count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cv);
+    matrix_thread_pool_unlock(&pool->lock);
+
+    matrix_thread_pool_work(pool, 0, fn, ctx);
+
+    matrix_thread_pool_lock(&pool->lock);
+    while (pool->running > 0) pthread_cond_wait(&pool->done_cv, &pool->lock);
+    matrix_thread_pool_unlock(&pool->lock);
+}
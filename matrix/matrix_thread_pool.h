@@ -0,0 +1,85 @@
+#ifndef MATRIX_THREAD_POOL_H
+#define MATRIX_THREAD_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#define MATRIX_THREAD_POOL_MAX_THREADS 256
+#define MATRIX_THREAD_POOL_CACHE_LINE  64   /* padding between worker queues */
+#define FAILED_MATRIX_THREAD_POOL_LOCK -78
+
+/*
+ * ============================================================================
+ *  MatrixThreadPool — Contracts & Ownership
+ * ============================================================================
+ * - Workers: a pool of N threads is the calling thread plus N-1 pthreads
+ *   started at build time and parked on a condition variable between runs.
+ *   A pool of 1 runs everything inline on the caller.
+ *
+ * - Work distribution: matrix_thread_pool_run() hands out task indices
+ *   [0, task_count). Each worker starts with a contiguous share of the range;
+ *   a worker whose share is exhausted steals the upper half of the remaining
+ *   range of another worker, so uneven tiles still keep every thread busy.
+ *   Every index is executed exactly once; run() returns when all are done.
+ *
+ * - Task callback: fn(task, worker, ctx), where 'worker' is in
+ *   [0, thread_count) and stable for the whole call, so callers can give each
+ *   worker its own scratch memory. fn must not call run() on the same pool.
+ *
+ * - Thread-safety: run() calls on one pool must not overlap (one multiply at
+ *   a time per pool); build/destroy must not race with a run.
+ * ============================================================================
+ */
+
+typedef void (*MatrixTaskFn)(size_t task, unsigned worker, void* ctx);
+
+/* One worker's share of the current run: tasks [next, end), stealable under lock. */
+typedef struct MatrixWorkerQueue {
+    pthread_mutex_t          lock;
+    struct MatrixThreadPool* pool;    /* back-pointer for the worker thread */
+    size_t                   next;
+    size_t                   end;
+    char                     pad[MATRIX_THREAD_POOL_CACHE_LINE];
+} MatrixWorkerQueue;
+
+typedef struct MatrixThreadPool {
+    unsigned           thread_count;  /* workers, caller included (>= 1) */
+    pthread_t*         threads;       /* thread_count - 1 background workers */
+    MatrixWorkerQueue* queues;        /* one per worker; index 0 is the caller */
+
+    pthread_mutex_t    lock;          /* guards the run state below */
+    pthread_cond_t     work_cv;       /* a new run was published (or shutdown) */
+    pthread_cond_t     done_cv;       /* the last background worker finished */
+    unsigned long      generation;    /* bumped once per run */
+    unsigned           running;       /* background workers still inside the run */
+    int                shutdown;
+
+    MatrixTaskFn       fn;            /* current run */
+    void*              ctx;
+} MatrixThreadPool;
+
+/* ------------------------------------------------------------------------- */
+/*                               API – Prototypes                            */
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Build a pool of 'thread_count' workers (0 = online CPUs; clamped to
+ * MATRIX_THREAD_POOL_MAX_THREADS). Returns NULL on failure.
+ */
+MatrixThreadPool* build_matrix_thread_pool(unsigned thread_count);
+
+/* Stop and join the workers, free the pool (no-op on NULL). */
+void matrix_thread_pool_destroy(MatrixThreadPool* pool);
+
+/* Workers in the pool, caller included (1 for NULL). */
+unsigned matrix_thread_pool_size(const MatrixThreadPool* pool);
+
+/*
+ * Run fn(task, worker, ctx) for every task in [0, task_count) across the pool
+ * and wait for completion. A NULL pool runs the tasks inline (worker 0).
+ */
+void matrix_thread_pool_run(MatrixThreadPool* pool, size_t task_count, MatrixTaskFn fn, void* ctx);
+
+#endif /* MATRIX_THREAD_POOL_H */
@@ -42,7 +42,8 @@ void* ll_alloc_char(char value){
 }
 
 //ll_alloc_HashMapItem: allocates struct on heap and peforms shallow copy of fields
-//DOES NOT PERFORM KEY DEEP COPY
+//DOES NOT PERFORM KEY DEEP COPY (small inline keys are copied with the struct,
+//so their key pointer is re-pointed to the new inline buffer)
 void* ll_alloc_HashMapItem(HashMapItem value) {
     HashMapItem* p = (HashMapItem*) malloc(sizeof(HashMapItem));
     if (p == NULL) {
@@ -50,5 +51,8 @@ void* ll_alloc_HashMapItem(HashMapItem value) {
         exit(MALLOC_FAILURE_EXIT_CODE);
     }
     *p = value;
+    if (p->key_size <= HASH_MAP_INLINE_KEY_SIZE) {
+        p->key = p->inline_key;
+    }
     return (void*) p;
 }
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "concurrent_hashmap_tests.h"
+
+static int chm_passed = 0;
+static int chm_failed = 0;
+
+#define CHM_EXPECT(cond, msg)                                                   \
+    do {                                                                        \
+        if ((cond)) {                                                           \
+            chm_passed++;                                                       \
+        } else {                                                                \
+            chm_failed++;                                                       \
+            fprintf(stderr, "[CHM FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                       \
+    } while (0)
+
+/*
+ * Worker threads never touch the counters above: they record problems in
+ * their own args and the main thread checks them after join.
+ */
+
+#define CHM_THREADS       4
+#define CHM_KEYS_PER_THR  5000
+
+/* -------- Helpers -------- */
+
+static double chm_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* xorshift64*: cheap deterministic per-thread key stream */
+static uint64_t chm_xorshift64s(uint64_t* s) {
+    uint64_t x = *s;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    *s = x;
+    return x * 2685821657736338717ULL;
+}
+
+static int chm_spawn(pthread_t* threads, size_t n, void* (*fn)(void*), void* args, size_t arg_size) {
+    for (size_t t = 0; t < n; ++t) {
+        if (pthread_create(&threads[t], NULL, fn, (char*)args + t * arg_size) != 0) {
+            for (size_t j = 0; j < t; ++j) pthread_join(threads[j], NULL);
+            return 0;
+        }
+    }
+    for (size_t t = 0; t < n; ++t) pthread_join(threads[t], NULL);
+    return 1;
+}
+
+/* Per-segment allocator factory counting live table blocks per segment. */
+typedef struct { long live[CONCURRENT_HASH_MAP_MAX_SEGMENTS]; size_t calls; } ChmSegmentAllocs;
+typedef struct { ChmSegmentAllocs* allocs; size_t segment; } ChmSegmentCtx;
+static ChmSegmentCtx g_chm_segment_ctx[CONCURRENT_HASH_MAP_MAX_SEGMENTS];
+
+static void* chm_segment_alloc(size_t size, void* ctx) {
+    ChmSegmentCtx* c = ctx;
+    c->allocs->live[c->segment]++;
+    return malloc(size);
+}
+static void chm_segment_release(void* ptr, size_t size, void* ctx) {
+    (void)size;
+    ChmSegmentCtx* c = ctx;
+    c->allocs->live[c->segment]--;
+    free(ptr);
+}
+static void chm_segment_factory(size_t segment, size_t segment_count, HashMapAllocator* allocator, void* ctx) {
+    ChmSegmentAllocs* allocs = ctx;
+    if (segment != allocs->calls++ || segment >= segment_count) return;  /* caught by the call count check */
+    g_chm_segment_ctx[segment] = (ChmSegmentCtx){ allocs, segment };
+    allocator->allocate = chm_segment_alloc;
+    allocator->release  = chm_segment_release;
+    allocator->ctx      = &g_chm_segment_ctx[segment];
+}
+
+/* -------- Individual tests -------- */
+
+static void test_build_rounds_segments(void) {
+    ConcurrentHashMap* m = build_concurrent_hash_map(5);
+    CHM_EXPECT(m->segment_count == 8, "Segment count must round up to a power of two");
+    concurrent_hash_map_destroy(m, NULL);
+
+    m = build_concurrent_hash_map(0);
+    CHM_EXPECT(m->segment_count == CONCURRENT_HASH_MAP_DEFAULT_SEGMENTS, "0 segments must select the default");
+    CHM_EXPECT(concurrent_hash_map_size(m) == 0, "New map must be empty");
+    concurrent_hash_map_destroy(m, NULL);
+}
+
+static void test_segment_allocator_factory(void) {
+    ChmSegmentAllocs allocs = {0};
+    ConcurrentHashMap* m = build_concurrent_hash_map_with_allocators(4, chm_segment_factory, &allocs);
+    CHM_EXPECT(m->segment_count == 4 && allocs.calls == 4, "Factory must run once per segment, in order");
+
+    char key[32];
+    int routed = 1;
+    for (int i = 0; i < 5000; i++) {
+        int n = snprintf(key, sizeof key, "seg-%d", i);
+        concurrent_hash_map_put(m, key, (size_t)n, NULL, 0, NULL);
+        routed &= concurrent_hash_map_segment_index(m, key, (size_t)n) < m->segment_count;
+    }
+    CHM_EXPECT(routed, "Segment index must stay below the segment count");
+
+    int all_used = 1;
+    for (size_t i = 0; i < m->segment_count; i++) all_used &= allocs.live[i] > 0;
+    CHM_EXPECT(all_used, "Every segment must allocate its tables through its own allocator");
+
+    concurrent_hash_map_destroy(m, NULL);
+    int all_released = 1;
+    for (size_t i = 0; i < 4; i++) all_released &= allocs.live[i] == 0;
+    CHM_EXPECT(all_released, "Destroy must release every table through the allocator that made it");
+}
+
+static int g_chm_free_count = 0;
+static void chm_data_free_counter(void* p) {
+    if (p) {
+        g_chm_free_count++;
+        free(p);
+    }
+}
+
+static void chm_copy_int(const HashMapItem* item, void* ctx) {
+    *(int*)ctx = *(const int*)item->data;
+}
+
+static void test_single_thread_semantics(void) {
+    ConcurrentHashMap* m = build_concurrent_hash_map(4);
+    g_chm_free_count = 0;
+
+    int* v1 = malloc(sizeof(int)); *v1 = 1;
+    int* v2 = malloc(sizeof(int)); *v2 = 2;
+    CHM_EXPECT(concurrent_hash_map_put(m, "k", 1, v1, sizeof(int), chm_data_free_counter) == 0, "First put must insert");
+    CHM_EXPECT(concurrent_hash_map_put(m, "k", 1, v2, sizeof(int), chm_data_free_counter) == 1, "Second put must update");
+    CHM_EXPECT(g_chm_free_count == 1, "Owned old value must be freed on update");
+
+    void* out = NULL;
+    size_t out_size = 0;
+    CHM_EXPECT(concurrent_hash_map_get(m, "k", 1, &out, &out_size) == 1, "Get must find the key");
+    CHM_EXPECT(out == v2 && out_size == sizeof(int), "Get must return the latest value");
+
+    int seen = 0;
+    CHM_EXPECT(concurrent_hash_map_get_with(m, "k", 1, chm_copy_int, &seen) == 1 && seen == 2,
+               "get_with must visit the stored item");
+    CHM_EXPECT(concurrent_hash_map_get(m, "missing", 7, &out, NULL) == 0, "Get on missing key must fail");
+
+    CHM_EXPECT(concurrent_hash_map_remove(m, "k", 1, chm_data_free_counter) == 1, "Remove must find the key");
+    CHM_EXPECT(g_chm_free_count == 2, "Owned value must be freed on remove");
+    CHM_EXPECT(concurrent_hash_map_size(m) == 0, "Map must be empty after remove");
+
+    concurrent_hash_map_destroy(m, chm_data_free_counter);
+}
+
+typedef struct {
+    ConcurrentHashMap* map;
+    unsigned           id;
+    int                errors;
+} ChmWorkerArgs;
+
+/* Each thread inserts its own key range, reads it back, then removes the odd keys. */
+static void* chm_disjoint_worker(void* p) {
+    ChmWorkerArgs* a = (ChmWorkerArgs*)p;
+    uint32_t base = a->id * CHM_KEYS_PER_THR;
+
+    for (uint32_t i = 0; i < CHM_KEYS_PER_THR; ++i) {
+        uint32_t key = base + i;
+        uint32_t* v = malloc(sizeof(uint32_t));
+        *v = key * 3u;
+        if (concurrent_hash_map_put(a->map, &key, sizeof key, v, sizeof *v, free) != 0) a->errors++;
+    }
+    for (uint32_t i = 0; i < CHM_KEYS_PER_THR; ++i) {
+        uint32_t key = base + i;
+        void* out = NULL;
+        if (!concurrent_hash_map_get(a->map, &key, sizeof key, &out, NULL) || *(uint32_t*)out != key * 3u) a->errors++;
+    }
+    for (uint32_t i = 1; i < CHM_KEYS_PER_THR; i += 2) {
+        uint32_t key = base + i;
+        if (concurrent_hash_map_remove(a->map, &key, sizeof key, free) != 1) a->errors++;
+    }
+    return NULL;
+}
+
+static void test_parallel_disjoint_inserts(void) {
+    ConcurrentHashMap* m = build_concurrent_hash_map(16);
+    pthread_t threads[CHM_THREADS];
+    ChmWorkerArgs args[CHM_THREADS];
+    for (unsigned t = 0; t < CHM_THREADS; ++t) args[t] = (ChmWorkerArgs){ m, t, 0 };
+
+    int spawned = chm_spawn(threads, CHM_THREADS, chm_disjoint_worker, args, sizeof args[0]);
+    CHM_EXPECT(spawned, "Worker threads must start");
+
+    int errors = 0;
+    for (unsigned t = 0; t < CHM_THREADS; ++t) errors += args[t].errors;
+    CHM_EXPECT(errors == 0, "Every thread must see its own puts/gets/removes succeed");
+    CHM_EXPECT(concurrent_hash_map_size(m) == (size_t)CHM_THREADS * CHM_KEYS_PER_THR / 2,
+               "Only even keys must remain");
+
+    int layout_ok = 1;
+    for (uint32_t key = 0; key < CHM_THREADS * CHM_KEYS_PER_THR; ++key) {
+        int found = concurrent_hash_map_get(m, &key, sizeof key, NULL, NULL);
+        if (found != ((key % 2) == 0)) layout_ok = 0;
+    }
+    CHM_EXPECT(layout_ok, "Removed keys must be gone and kept keys reachable");
+
+    concurrent_hash_map_destroy(m, free);
+}
+
+/* All threads hammer the SAME small key set with owned values: exercises update/remove races. */
+#define CHM_SHARED_KEYS 64
+#define CHM_SHARED_OPS  20000
+
+static void chm_check_value(const HashMapItem* item, void* ctx) {
+    /* value is always "key + 1000 * writer": the low part must match the key */
+    uint32_t key = *(const uint32_t*)item->key;
+    if (*(const uint32_t*)item->data % 1000u != key) (*(int*)ctx)++;
+}
+
+static void* chm_shared_worker(void* p) {
+    ChmWorkerArgs* a = (ChmWorkerArgs*)p;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL ^ (a->id + 1);
+
+    for (unsigned i = 0; i < CHM_SHARED_OPS; ++i) {
+        uint64_t r = chm_xorshift64s(&rng);
+        uint32_t key = (uint32_t)(r % CHM_SHARED_KEYS);
+        switch ((r >> 32) % 4) {
+            case 0:
+            case 1: {
+                uint32_t* v = malloc(sizeof(uint32_t));
+                *v = key + 1000u * a->id;
+                (void)concurrent_hash_map_put(a->map, &key, sizeof key, v, sizeof *v, free);
+                break;
+            }
+            case 2:
+                (void)concurrent_hash_map_remove(a->map, &key, sizeof key, free);
+                break;
+            default:
+                (void)concurrent_hash_map_get_with(a->map, &key, sizeof key, chm_check_value, &a->errors);
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void test_parallel_shared_keys(void) {
+    ConcurrentHashMap* m = build_concurrent_hash_map(8);
+    pthread_t threads[CHM_THREADS];
+    ChmWorkerArgs args[CHM_THREADS];
+    for (unsigned t = 0; t < CHM_THREADS; ++t) args[t] = (ChmWorkerArgs){ m, t, 0 };
+
+    int spawned = chm_spawn(threads, CHM_THREADS, chm_shared_worker, args, sizeof args[0]);
+    CHM_EXPECT(spawned, "Worker threads must start");
+
+    int errors = 0;
+    for (unsigned t = 0; t < CHM_THREADS; ++t) errors += args[t].errors;
+    CHM_EXPECT(errors == 0, "Readers must never observe a torn or foreign value");
+    CHM_EXPECT(concurrent_hash_map_size(m) <= CHM_SHARED_KEYS, "Size must stay within the key set");
+
+    concurrent_hash_map_destroy(m, free);
+}
+
+/* -------- Scaling benchmark: 1..N threads, striped map vs one global mutex -------- */
+
+#define CHM_BENCH_KEYS        (1u << 16)
+#define CHM_BENCH_OPS_PER_THR 200000u
+#define CHM_BENCH_MAX_THREADS 8
+
+typedef struct {
+    ConcurrentHashMap* striped; /* used when non-NULL */
+    HashMap*           plain;   /* otherwise: plain map behind 'global' */
+    pthread_mutex_t*   global;
+    unsigned           id;
+} ChmBenchArgs;
+
+/* 90% get / 10% put over a pre-filled key space (values not owned). */
+static void* chm_bench_worker(void* p) {
+    ChmBenchArgs* a = (ChmBenchArgs*)p;
+    uint64_t rng = 0xD1B54A32D192ED03ULL ^ (a->id + 1);
+    uintptr_t sink = 0;
+
+    for (unsigned i = 0; i < CHM_BENCH_OPS_PER_THR; ++i) {
+        uint64_t r = chm_xorshift64s(&rng);
+        uint32_t key = (uint32_t)(r & (CHM_BENCH_KEYS - 1));
+        int is_put = ((r >> 32) % 10) == 0;
+
+        if (a->striped != NULL) {
+            if (is_put) {
+                (void)concurrent_hash_map_put(a->striped, &key, sizeof key, (void*)(uintptr_t)i, 0, NULL);
+            } else {
+                void* out = NULL;
+                (void)concurrent_hash_map_get(a->striped, &key, sizeof key, &out, NULL);
+                sink += (uintptr_t)out;
+            }
+        } else {
+            pthread_mutex_lock(a->global);
+            if (is_put) {
+                (void)hash_map_put(a->plain, &key, sizeof key, (void*)(uintptr_t)i, 0, NULL);
+            } else {
+                const HashMapItem* it = hash_map_get(a->plain, &key, sizeof key);
+                if (it) sink += (uintptr_t)it->data;
+            }
+            pthread_mutex_unlock(a->global);
+        }
+    }
+    return (void*)sink;
+}
+
+static double chm_bench_run(ConcurrentHashMap* striped, HashMap* plain, pthread_mutex_t* global, unsigned n) {
+    pthread_t threads[CHM_BENCH_MAX_THREADS];
+    ChmBenchArgs args[CHM_BENCH_MAX_THREADS];
+    for (unsigned t = 0; t < n; ++t) args[t] = (ChmBenchArgs){ striped, plain, global, t };
+
+    double t0 = chm_now_ms();
+    int spawned = chm_spawn(threads, n, chm_bench_worker, args, sizeof args[0]);
+    double t1 = chm_now_ms();
+    CHM_EXPECT(spawned, "Benchmark threads must start");
+
+    double secs = (t1 - t0) / 1000.0;
+    return secs > 0.0 ? (double)n * CHM_BENCH_OPS_PER_THR / secs : 0.0;
+}
+
+static void test_scaling_benchmark(void) {
+    ConcurrentHashMap* striped = build_concurrent_hash_map(0);
+    HashMap* plain = build_hash_map();
+    pthread_mutex_t global;
+    pthread_mutex_init(&global, NULL);
+
+    for (uint32_t key = 0; key < CHM_BENCH_KEYS; ++key) {
+        (void)concurrent_hash_map_put(striped, &key, sizeof key, NULL, 0, NULL);
+        (void)hash_map_put(plain, &key, sizeof key, NULL, 0, NULL);
+    }
+
+    printf("  bench: 90%% get / 10%% put, %u keys, %u ops per thread\n", CHM_BENCH_KEYS, CHM_BENCH_OPS_PER_THR);
+    for (unsigned n = 1; n <= CHM_BENCH_MAX_THREADS; n *= 2) {
+        double striped_ops = chm_bench_run(striped, NULL, NULL, n);
+        double global_ops = chm_bench_run(NULL, plain, &global, n);
+        printf("  bench: threads=%u striped=%.2f Mops/s global-mutex=%.2f Mops/s (x%.2f)\n",
+               n, striped_ops / 1e6, global_ops / 1e6,
+               global_ops > 0.0 ? striped_ops / global_ops : 0.0);
+    }
+
+    CHM_EXPECT(concurrent_hash_map_size(striped) == CHM_BENCH_KEYS, "Benchmark must not change the key set");
+
+    pthread_mutex_destroy(&global);
+    hash_map_destroy(plain, NULL);
+    concurrent_hash_map_destroy(striped, NULL);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_concurrent_hashmap_tests(void) {
+    chm_passed = chm_failed = 0;
+    printf("[TEST] testing concurrent hashmap...\n");
+
+    test_build_rounds_segments();
+    test_segment_allocator_factory();
+    test_single_thread_semantics();
+    test_parallel_disjoint_inserts();
+    test_parallel_shared_keys();
+    test_scaling_benchmark();
+
+    if (chm_failed == 0) {
+        printf("[TEST OK]  concurrent hashmap: passed=%d failed=%d\n", chm_passed, chm_failed);
+    } else {
+        printf("[TEST FAIL] concurrent hashmap: passed=%d failed=%d\n", chm_passed, chm_failed);
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef CONCURRENT_HASHMAP_TESTS_H
+#define CONCURRENT_HASHMAP_TESTS_H
+
+#include "../hashmap/concurrent_hashmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>      /* timespec_get, struct timespec */
+
+/* Entry point for ConcurrentHashMap tests (includes the 1..N threads scaling benchmark). */
+void run_all_concurrent_hashmap_tests(void);
+
+#endif /* CONCURRENT_HASHMAP_TESTS_H */
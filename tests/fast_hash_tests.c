@@ -0,0 +1,152 @@
+#include "fast_hash_tests.h"
+
+static int fh_passed = 0;
+static int fh_failed = 0;
+
+#define FH_EXPECT(cond, msg)                                                   \
+    do {                                                                       \
+        if ((cond)) {                                                          \
+            fh_passed++;                                                       \
+        } else {                                                               \
+            fh_failed++;                                                       \
+            fprintf(stderr, "[FH FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                      \
+    } while (0)
+
+/* -------- Helpers -------- */
+
+static int fh_popcount64(uint64_t x) {
+    int n = 0;
+    while (x) {
+        x &= x - 1;
+        n++;
+    }
+    return n;
+}
+
+/* -------- Individual tests -------- */
+
+static void test_deterministic_and_seeded(void) {
+    const char* key = "the quick brown fox jumps over the lazy dog";
+    size_t len = strlen(key);
+
+    FH_EXPECT(fast_hash_64(key, len, 7) == fast_hash_64(key, len, 7), "Same input and seed must hash the same");
+    FH_EXPECT(fast_hash_64(key, len, 7) != fast_hash_64(key, len, 8), "Seed must change the hash");
+    FH_EXPECT(fast_hash_u64(42, 7) == fast_hash_u64(42, 7), "Integer mixer must be deterministic");
+    FH_EXPECT(fast_hash_u64(42, 7) != fast_hash_u64(42, 8), "Seed must change the integer hash");
+    FH_EXPECT(fast_hash_64("", 0, 1) != fast_hash_64("", 0, 2), "Even the empty key must depend on the seed");
+}
+
+/* Every prefix length hits a different code path (small, 4..16, 17..48, > 48): all must differ. */
+static void test_every_length_distinct(void) {
+    unsigned char buf[160];
+    for (size_t i = 0; i < sizeof buf; i++) buf[i] = (unsigned char)(i * 31 + 7);
+
+    uint64_t hashes[sizeof buf + 1];
+    int distinct = 1;
+    for (size_t len = 0; len <= sizeof buf; len++) {
+        hashes[len] = fast_hash_64(buf, len, 0);
+        for (size_t j = 0; j < len; j++) {
+            if (hashes[j] == hashes[len]) distinct = 0;
+        }
+    }
+    FH_EXPECT(distinct, "Prefixes of every length must hash differently");
+
+    /* zero bytes still count: "\0" vs "\0\0" vs "" */
+    unsigned char zeros[64] = {0};
+    int zero_distinct = 1;
+    for (size_t len = 1; len < sizeof zeros; len++) {
+        if (fast_hash_64(zeros, len, 0) == fast_hash_64(zeros, len - 1, 0)) zero_distinct = 0;
+    }
+    FH_EXPECT(zero_distinct, "Runs of zero bytes of different lengths must hash differently");
+}
+
+static void test_unaligned_input(void) {
+    unsigned char storage[128];
+    for (size_t i = 0; i < sizeof storage; i++) storage[i] = (unsigned char)(i ^ 0x5A);
+
+    int same = 1;
+    for (size_t offset = 1; offset < 8; offset++) {
+        unsigned char aligned[100];
+        memcpy(aligned, storage + offset, sizeof aligned);
+        for (size_t len = 0; len <= sizeof aligned; len += 3) {
+            if (fast_hash_64(storage + offset, len, 9) != fast_hash_64(aligned, len, 9)) same = 0;
+        }
+    }
+    FH_EXPECT(same, "Hash must not depend on the key's alignment");
+}
+
+/* Flipping one input bit should flip about half of the 64 output bits. */
+static void test_avalanche(void) {
+    const size_t lengths[] = { 3, 8, 13, 24, 64, 100 };
+    unsigned char key[100];
+    long flipped = 0, samples = 0;
+
+    for (size_t l = 0; l < sizeof lengths / sizeof lengths[0]; l++) {
+        size_t len = lengths[l];
+        for (int trial = 0; trial < 16; trial++) {
+            for (size_t i = 0; i < len; i++) key[i] = (unsigned char)(trial * 131 + i * 17);
+            uint64_t base = fast_hash_64(key, len, 1234);
+            for (size_t bit = 0; bit < len * 8; bit++) {
+                key[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+                flipped += fh_popcount64(base ^ fast_hash_64(key, len, 1234));
+                samples++;
+                key[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+            }
+        }
+    }
+    double mean = (double)flipped / (double)samples;
+    FH_EXPECT(mean > 30.0 && mean < 34.0, "fast_hash_64: one flipped input bit must flip ~32 output bits");
+
+    long int_flipped = 0, int_samples = 0;
+    for (uint64_t x = 0; x < 256; x++) {
+        uint64_t base = fast_hash_u64(x, 99);
+        for (int bit = 0; bit < 64; bit++) {
+            int_flipped += fh_popcount64(base ^ fast_hash_u64(x ^ (1ULL << bit), 99));
+            int_samples++;
+        }
+    }
+    double int_mean = (double)int_flipped / (double)int_samples;
+    FH_EXPECT(int_mean > 30.0 && int_mean < 34.0, "fast_hash_u64: one flipped input bit must flip ~32 output bits");
+}
+
+/* Sequential integers (the typical id key) must spread over the low bits a table indexes with. */
+static void test_sequential_keys_spread(void) {
+    enum { BUCKETS = 1024, N = BUCKETS * 16 };
+    static int counts_bytes[BUCKETS];
+    static int counts_int[BUCKETS];
+    memset(counts_bytes, 0, sizeof counts_bytes);
+    memset(counts_int, 0, sizeof counts_int);
+
+    for (uint64_t i = 0; i < N; i++) {
+        counts_bytes[fast_hash_64(&i, sizeof i, 5) & (BUCKETS - 1)]++;
+        counts_int[fast_hash_u64(i, 5) & (BUCKETS - 1)]++;
+    }
+    int max_bytes = 0, max_int = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        if (counts_bytes[b] > max_bytes) max_bytes = counts_bytes[b];
+        if (counts_int[b] > max_int) max_int = counts_int[b];
+    }
+    /* mean is 16 per bucket; a decent hash stays well under 3x that */
+    FH_EXPECT(max_bytes < 48, "fast_hash_64 must spread sequential keys over the low bits");
+    FH_EXPECT(max_int < 48, "fast_hash_u64 must spread sequential keys over the low bits");
+}
+
+/* -------- Entry point -------- */
+
+void run_all_fast_hash_tests(void) {
+    fh_passed = fh_failed = 0;
+    printf("[TEST] testing fast_hash...\n");
+
+    test_deterministic_and_seeded();
+    test_every_length_distinct();
+    test_unaligned_input();
+    test_avalanche();
+    test_sequential_keys_spread();
+
+    if (fh_failed == 0) {
+        printf("[TEST OK]  fast_hash: passed=%d failed=%d\n", fh_passed, fh_failed);
+    } else {
+        printf("[TEST FAIL] fast_hash: passed=%d failed=%d\n", fh_passed, fh_failed);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef FAST_HASH_TESTS_H
+#define FAST_HASH_TESTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../hashing/fast_hash.h"
+
+/* Entry point for fast_hash_64 / fast_hash_u64 property tests. */
+void run_all_fast_hash_tests(void);
+
+#endif /* FAST_HASH_TESTS_H */
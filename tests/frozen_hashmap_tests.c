@@ -0,0 +1,209 @@
+#include "frozen_hashmap_tests.h"
+
+static int frz_passed = 0;
+static int frz_failed = 0;
+
+#define FRZ_EXPECT(cond, msg)                                                   \
+    do {                                                                        \
+        if ((cond)) {                                                           \
+            frz_passed++;                                                       \
+        } else {                                                                \
+            frz_failed++;                                                       \
+            fprintf(stderr, "[FRZ FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                       \
+    } while (0)
+
+/* -------- Helpers -------- */
+
+static double frz_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* --- stderr silencer (test-only) --- */
+static int frz_saved_stderr_fd = -1;
+
+static void frz_silence_stderr_begin(void) {
+    fflush(stderr);
+    frz_saved_stderr_fd = frz_dup(frz_fileno(stderr));
+    if (frz_saved_stderr_fd < 0) return;
+
+    int devnull = frz_open(FRZ_DEV_NULL, FRZ_O_WRONLY);
+    if (devnull >= 0) {
+        frz_dup2(devnull, frz_fileno(stderr));
+        frz_close(devnull);
+    }
+}
+
+static void frz_silence_stderr_end(void) {
+    if (frz_saved_stderr_fd >= 0) {
+        fflush(stderr);
+        frz_dup2(frz_saved_stderr_fd, frz_fileno(stderr));
+        frz_close(frz_saved_stderr_fd);
+        frz_saved_stderr_fd = -1;
+    }
+}
+
+/* -------- Individual tests -------- */
+
+static void test_freeze_keys_and_values(void) {
+    HashMap* m = build_hash_map();
+    char key[64];
+    char value[64];
+
+    for (int i = 0; i < 5000; ++i) {
+        int kn = snprintf(key, sizeof key, "key-%d%s", i, (i % 3 == 0) ? "-with-a-longer-spilled-tail" : "");
+        int vn = snprintf(value, sizeof value, "value-%d", i * 7);
+        char* v = malloc((size_t)vn + 1);
+        memcpy(v, value, (size_t)vn + 1);
+        (void)hash_map_put(m, key, (size_t)kn, v, (size_t)vn + 1, free);
+    }
+    (void)hash_map_put(m, "", 0, NULL, 0, free);  /* empty key, no value */
+    for (int i = 0; i < 5000; i += 5) {         /* tombstones in the source must not matter */
+        int kn = snprintf(key, sizeof key, "key-%d%s", i, (i % 3 == 0) ? "-with-a-longer-spilled-tail" : "");
+        (void)hash_map_remove(m, key, (size_t)kn, free);
+    }
+
+    FrozenHashMap* fm = hash_map_freeze(m);
+    FRZ_EXPECT(fm != NULL, "Freeze must succeed");
+    if (fm == NULL) {
+        hash_map_destroy(m, free);
+        return;
+    }
+    FRZ_EXPECT(fm->size == m->size, "Frozen map must hold every live entry");
+
+    int all_match = 1;
+    for (int i = 0; i < 5000; ++i) {
+        int kn = snprintf(key, sizeof key, "key-%d%s", i, (i % 3 == 0) ? "-with-a-longer-spilled-tail" : "");
+        const FrozenHashMapEntry* e = frozen_hash_map_get(fm, key, (size_t)kn);
+        const HashMapItem* live = hash_map_get(m, key, (size_t)kn);
+        if ((e != NULL) != (live != NULL)) all_match = 0;
+        if (e != NULL && (e->data != live->data || e->data_size != live->data_size)) all_match = 0;
+    }
+    FRZ_EXPECT(all_match, "Frozen lookups must agree with the source map");
+
+    const FrozenHashMapEntry* empty = frozen_hash_map_get(fm, "", 0);
+    FRZ_EXPECT(empty != NULL && empty->key_size == 0 && empty->data == NULL, "Empty key must be frozen too");
+    FRZ_EXPECT(frozen_hash_map_get(fm, "missing", 7) == NULL, "Missing key must not be found");
+
+    /* ownership moves to the frozen map: the source lets go of the data */
+    hash_map_destroy(m, NULL);
+    FRZ_EXPECT(frozen_hash_map_get(fm, "key-1", 5) != NULL, "Frozen map must outlive its source");
+    frozen_hash_map_destroy(fm, free);
+}
+
+static void test_freeze_small_and_empty(void) {
+    HashMap* m = build_hash_map();
+    FrozenHashMap* fm = hash_map_freeze(m);
+    FRZ_EXPECT(fm != NULL && fm->size == 0, "Freezing an empty map must give an empty frozen map");
+    FRZ_EXPECT(frozen_hash_map_get(fm, "x", 1) == NULL, "Empty frozen map must find nothing");
+    frozen_hash_map_destroy(fm, NULL);
+
+    int one = 1;
+    (void)hash_map_put(m, "a", 1, &one, sizeof one, NULL);
+    fm = hash_map_freeze(m);
+    const FrozenHashMapEntry* e = frozen_hash_map_get(fm, "a", 1);
+    FRZ_EXPECT(e != NULL && e->data == &one, "Single-entry map must freeze");
+    FRZ_EXPECT(frozen_hash_map_get(fm, "b", 1) == NULL, "Single-entry frozen map must reject other keys");
+    frozen_hash_map_destroy(fm, NULL);
+    hash_map_destroy(m, NULL);
+
+    frz_silence_stderr_begin();
+    frozen_hash_map_destroy(NULL, NULL);  /* documented no-op */
+    frz_silence_stderr_end();
+    FRZ_EXPECT(frozen_hash_map_memory_bytes(NULL) == 0, "NULL frozen map owns no memory");
+}
+
+static void test_freeze_during_migration(void) {
+    HashMap* m = build_hash_map();
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_INCREMENTAL);
+    uint32_t n = 0;
+    while ((n < 1000 || !hash_map_is_rehashing(m)) && n < 100000) {
+        (void)hash_map_put(m, &n, sizeof n, NULL, 0, NULL);
+        n++;
+    }
+    FRZ_EXPECT(hash_map_is_rehashing(m), "Source map must be mid-migration");
+
+    FrozenHashMap* fm = hash_map_freeze(m);
+    size_t hits = 0;
+    for (uint32_t i = 0; i < n; ++i) hits += frozen_hash_map_get(fm, &i, sizeof i) != NULL;
+    FRZ_EXPECT(fm != NULL && fm->size == n && hits == n, "Freeze must cover both tables of a migrating map");
+
+    frozen_hash_map_destroy(fm, NULL);
+    hash_map_destroy(m, NULL);
+}
+
+static void test_freeze_keeps_hash_kind(void) {
+    HashMap* m = build_hash_map_with_hash(HASH_MAP_HASH_FAST64, hash_map_random_seed());
+    char key[32];
+    for (int i = 0; i < 1000; ++i) {
+        int kn = snprintf(key, sizeof key, "seeded-%d", i);
+        (void)hash_map_put(m, key, (size_t)kn, NULL, (size_t)i, NULL);
+    }
+
+    FrozenHashMap* fm = hash_map_freeze(m);
+    int all_match = fm != NULL;
+    for (int i = 0; i < 1000 && fm != NULL; ++i) {
+        int kn = snprintf(key, sizeof key, "seeded-%d", i);
+        const FrozenHashMapEntry* e = frozen_hash_map_get(fm, key, (size_t)kn);
+        if (e == NULL || e->data_size != (size_t)i) all_match = 0;
+    }
+    FRZ_EXPECT(all_match, "Frozen map must look keys up with the source map's hash kind and seed");
+
+    if (fm != NULL) frozen_hash_map_destroy(fm, NULL);
+    hash_map_destroy(m, NULL);
+}
+
+/* Memory and lookup time: live map vs its frozen copy. */
+static void test_freeze_memory_and_timings(void) {
+    enum { N = 200000 };
+    HashMap* m = build_hash_map();
+    for (uint32_t i = 0; i < N; ++i) {
+        (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    }
+
+    double t0 = frz_now_ms();
+    FrozenHashMap* fm = hash_map_freeze(m);
+    double t1 = frz_now_ms();
+
+    size_t hits = 0;
+    double t2 = frz_now_ms();
+    for (uint32_t i = 0; i < N; ++i) hits += hash_map_get(m, &i, sizeof i) != NULL;
+    double t3 = frz_now_ms();
+    for (uint32_t i = 0; i < N; ++i) hits += frozen_hash_map_get(fm, &i, sizeof i) != NULL;
+    double t4 = frz_now_ms();
+
+    HashMapStats st;
+    hash_map_stats(m, &st);
+    size_t frozen_bytes = frozen_hash_map_memory_bytes(fm);
+
+    FRZ_EXPECT(fm != NULL && hits == 2 * (size_t)N, "Every key must be found in both maps");
+    FRZ_EXPECT(frozen_bytes < st.total_bytes, "Frozen map must be smaller than the live map");
+    printf("  timings: %d entries: freeze=%.3f ms, gets live=%.3f ms, gets frozen=%.3f ms; "
+           "bytes live=%zu (%.1f/key), frozen=%zu (%.1f/key)\n",
+           N, t1 - t0, t3 - t2, t4 - t3,
+           st.total_bytes, (double)st.total_bytes / N, frozen_bytes, (double)frozen_bytes / N);
+
+    frozen_hash_map_destroy(fm, NULL);
+    hash_map_destroy(m, NULL);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_frozen_hashmap_tests(void) {
+    frz_passed = frz_failed = 0;
+    printf("[TEST] testing frozen hashmap...\n");
+
+    test_freeze_keys_and_values();
+    test_freeze_small_and_empty();
+    test_freeze_during_migration();
+    test_freeze_keeps_hash_kind();
+    test_freeze_memory_and_timings();
+
+    if (frz_failed == 0) {
+        printf("[TEST OK]  frozen hashmap: passed=%d failed=%d\n", frz_passed, frz_failed);
+    } else {
+        printf("[TEST FAIL] frozen hashmap: passed=%d failed=%d\n", frz_passed, frz_failed);
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef FROZEN_HASHMAP_TESTS_H
+#define FROZEN_HASHMAP_TESTS_H
+
+#include "../hashmap/frozen_hashmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>      /* timespec_get, struct timespec */
+
+/* --- stderr silencer platform shims (same pattern as the BST tests) --- */
+#if defined(_WIN32)
+  #include <io.h>
+  #include <fcntl.h>
+  #define FRZ_DEV_NULL  "NUL"
+  #define frz_dup       _dup
+  #define frz_dup2      _dup2
+  #define frz_open      _open
+  #define frz_close     _close
+  #define frz_fileno    _fileno
+  #define FRZ_O_WRONLY  _O_WRONLY
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #define FRZ_DEV_NULL  "/dev/null"
+  #define frz_dup       dup
+  #define frz_dup2      dup2
+  #define frz_open      open
+  #define frz_close     close
+  #define frz_fileno    fileno
+  #define FRZ_O_WRONLY  O_WRONLY
+#endif
+
+/* Entry point for FrozenHashMap (perfect-hash freeze) tests. */
+void run_all_frozen_hashmap_tests(void);
+
+#endif /* FROZEN_HASHMAP_TESTS_H */
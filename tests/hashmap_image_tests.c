@@ -0,0 +1,247 @@
+#include "hashmap_image_tests.h"
+
+static int img_passed = 0;
+static int img_failed = 0;
+
+#define IMG_EXPECT(cond, msg)                                                   \
+    do {                                                                        \
+        if ((cond)) {                                                           \
+            img_passed++;                                                       \
+        } else {                                                                \
+            img_failed++;                                                       \
+            fprintf(stderr, "[IMG FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                       \
+    } while (0)
+
+#define IMG_TEST_PATH "hashmap_image_test.bin"
+
+/* -------- Helpers -------- */
+
+static double img_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* --- stderr silencer (test-only) --- */
+static int img_saved_stderr_fd = -1;
+
+static void img_silence_stderr_begin(void) {
+    fflush(stderr);
+    img_saved_stderr_fd = img_dup(img_fileno(stderr));
+    if (img_saved_stderr_fd < 0) return;
+
+    int devnull = img_open(IMG_DEV_NULL, IMG_O_WRONLY);
+    if (devnull >= 0) {
+        img_dup2(devnull, img_fileno(stderr));
+        img_close(devnull);
+    }
+}
+
+static void img_silence_stderr_end(void) {
+    if (img_saved_stderr_fd >= 0) {
+        fflush(stderr);
+        img_dup2(img_saved_stderr_fd, img_fileno(stderr));
+        img_close(img_saved_stderr_fd);
+        img_saved_stderr_fd = -1;
+    }
+}
+
+/* -------- Individual tests -------- */
+
+static void test_round_trip_keys_and_values(void) {
+    HashMap* m = build_hash_map();
+    char key[64];
+    char value[64];
+
+    for (int i = 0; i < 2000; ++i) {
+        int kn = snprintf(key, sizeof key, "key-%d%s", i, (i % 3 == 0) ? "-with-a-longer-spilled-tail" : "");
+        int vn = snprintf(value, sizeof value, "value-%d", i * 7);
+        char* v = malloc((size_t)vn + 1);
+        memcpy(v, value, (size_t)vn + 1);
+        (void)hash_map_put(m, key, (size_t)kn, v, (size_t)vn + 1, free);
+    }
+    (void)hash_map_put(m, "", 0, NULL, 0, free);  /* empty key, empty value */
+    for (int i = 0; i < 2000; i += 5) {         /* leave tombstones behind: image must not care */
+        int kn = snprintf(key, sizeof key, "key-%d%s", i, (i % 3 == 0) ? "-with-a-longer-spilled-tail" : "");
+        (void)hash_map_remove(m, key, (size_t)kn, free);
+    }
+
+    IMG_EXPECT(hash_map_save(m, IMG_TEST_PATH) == 0, "Save must succeed");
+    MappedHashMap* mm = hash_map_open_mmap(IMG_TEST_PATH);
+    IMG_EXPECT(mm != NULL, "Open must succeed on a fresh image");
+    if (mm == NULL) {
+        hash_map_destroy(m, free);
+        remove(IMG_TEST_PATH);
+        return;
+    }
+
+    IMG_EXPECT(mapped_hash_map_size(mm) == m->size, "Image must hold every live entry");
+
+    int all_match = 1;
+    for (int i = 0; i < 2000; ++i) {
+        int kn = snprintf(key, sizeof key, "key-%d%s", i, (i % 3 == 0) ? "-with-a-longer-spilled-tail" : "");
+        const void* data = NULL;
+        size_t data_size = 0;
+        int found = mapped_hash_map_get(mm, key, (size_t)kn, &data, &data_size);
+        const HashMapItem* live = hash_map_get(m, key, (size_t)kn);
+        if (found != (live != NULL)) all_match = 0;
+        if (found && (data_size != live->data_size || memcmp(data, live->data, data_size) != 0)) all_match = 0;
+        if (found && ((uintptr_t)data % 8) != 0) all_match = 0;
+    }
+    IMG_EXPECT(all_match, "Mapped lookups must agree with the live map (keys, values, alignment)");
+
+    const void* data = (const void*)1;
+    size_t data_size = 99;
+    IMG_EXPECT(mapped_hash_map_get(mm, "", 0, &data, &data_size) == 1 && data_size == 0, "Empty key must round-trip");
+    IMG_EXPECT(mapped_hash_map_get(mm, "missing", 7, NULL, NULL) == 0, "Missing key must not be found");
+
+    hash_map_close_mmap(mm);
+    hash_map_destroy(m, free);
+    remove(IMG_TEST_PATH);
+}
+
+static void test_empty_map_round_trip(void) {
+    HashMap* m = build_hash_map();
+    IMG_EXPECT(hash_map_save(m, IMG_TEST_PATH) == 0, "Saving an empty map must succeed");
+    MappedHashMap* mm = hash_map_open_mmap(IMG_TEST_PATH);
+    IMG_EXPECT(mm != NULL && mapped_hash_map_size(mm) == 0, "Empty image must open with no entries");
+    IMG_EXPECT(mapped_hash_map_get(mm, "x", 1, NULL, NULL) == 0, "Empty image must find nothing");
+    hash_map_close_mmap(mm);
+    hash_map_destroy(m, NULL);
+    remove(IMG_TEST_PATH);
+}
+
+static void test_round_trip_keeps_hash_kind(void) {
+    HashMap* m = build_hash_map_with_hash(HASH_MAP_HASH_INT64, hash_map_random_seed());
+    for (uint64_t i = 0; i < 1000; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+
+    IMG_EXPECT(hash_map_save(m, IMG_TEST_PATH) == 0, "Save must succeed");
+    MappedHashMap* mm = hash_map_open_mmap(IMG_TEST_PATH);
+    size_t hits = 0;
+    for (uint64_t i = 0; i < 1000 && mm != NULL; ++i) hits += (size_t)mapped_hash_map_get(mm, &i, sizeof i, NULL, NULL);
+    IMG_EXPECT(mm != NULL && hits == 1000, "An image must be queried with the saved map's hash kind and seed");
+
+    if (mm != NULL) hash_map_close_mmap(mm);
+    hash_map_destroy(m, NULL);
+    remove(IMG_TEST_PATH);
+}
+
+static int img_open_garbage_fails(void) {
+    FILE* f = fopen(IMG_TEST_PATH, "wb");
+    if (f == NULL) return 0;
+    char junk[256];
+    memset(junk, 'J', sizeof junk);
+    fwrite(junk, 1, sizeof junk, f);
+    fclose(f);
+
+    MappedHashMap* mm = hash_map_open_mmap(IMG_TEST_PATH);
+    remove(IMG_TEST_PATH);
+    if (mm != NULL) {
+        hash_map_close_mmap(mm);
+        return 0;
+    }
+    return 1;
+}
+
+static int img_save_null_value_fails(void) {
+    HashMap* m = build_hash_map();
+    (void)hash_map_put(m, "k", 1, NULL, 8, NULL);  /* claims 8 bytes but has no buffer */
+    int rc = hash_map_save(m, IMG_TEST_PATH);
+    hash_map_destroy(m, NULL);
+    remove(IMG_TEST_PATH);
+    return rc == HASH_MAP_IMAGE_BAD_VALUE;
+}
+
+static int img_open_missing_file_fails(void) {
+    return hash_map_open_mmap("this-file-does-not-exist.bin") == NULL;
+}
+
+/* Saves a small map, overwrites one uint64 header field with 'value' and tries to open it. */
+static int img_open_patched_header_fails(size_t field_offset, uint64_t value) {
+    HashMap* m = build_hash_map();
+    for (int i = 0; i < 50; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    int rc = hash_map_save(m, IMG_TEST_PATH);
+    hash_map_destroy(m, NULL);
+    if (rc != 0) return 0;
+
+    FILE* f = fopen(IMG_TEST_PATH, "r+b");
+    if (f == NULL) return 0;
+    int patched = fseek(f, (long)field_offset, SEEK_SET) == 0 && fwrite(&value, sizeof value, 1, f) == 1;
+    fclose(f);
+
+    MappedHashMap* mm = patched ? hash_map_open_mmap(IMG_TEST_PATH) : NULL;
+    remove(IMG_TEST_PATH);
+    if (mm != NULL) {
+        hash_map_close_mmap(mm);
+        return 0;
+    }
+    return patched;
+}
+
+static void test_rejects_bad_inputs(void) {
+    img_silence_stderr_begin();
+    int garbage_rejected = img_open_garbage_fails();
+    int null_value_rejected = img_save_null_value_fails();
+    int missing_rejected = img_open_missing_file_fails();
+    /* offsets near UINT64_MAX: offset + section size wraps around to a small number */
+    int ctrl_wrap_rejected  = img_open_patched_header_fails(offsetof(HashMapImageHeader, ctrl_offset), UINT64_MAX - 7);
+    int index_wrap_rejected = img_open_patched_header_fails(offsetof(HashMapImageHeader, index_offset), UINT64_MAX - 7);
+    int blob_past_end_rejected = img_open_patched_header_fails(offsetof(HashMapImageHeader, blob_offset), UINT64_MAX - 7);
+    img_silence_stderr_end();
+
+    IMG_EXPECT(garbage_rejected, "Open must reject a file that is not an image");
+    IMG_EXPECT(null_value_rejected, "Save must reject sized values without a buffer");
+    IMG_EXPECT(missing_rejected, "Open must fail on a missing file");
+    IMG_EXPECT(ctrl_wrap_rejected, "Open must reject a ctrl_offset that wraps past the end");
+    IMG_EXPECT(index_wrap_rejected, "Open must reject an index_offset that wraps past the end");
+    IMG_EXPECT(blob_past_end_rejected, "Open must reject a blob_offset past the end");
+}
+
+/* Cold start: rebuilding with puts vs mapping a saved image and querying it. */
+static void test_cold_start_timings(void) {
+    enum { N = 200000 };
+    HashMap* m = build_hash_map();
+
+    double t0 = img_now_ms();
+    for (uint32_t i = 0; i < N; ++i) {
+        (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    }
+    double t1 = img_now_ms();
+
+    IMG_EXPECT(hash_map_save(m, IMG_TEST_PATH) == 0, "Save must succeed");
+
+    double t2 = img_now_ms();
+    MappedHashMap* mm = hash_map_open_mmap(IMG_TEST_PATH);
+    double t3 = img_now_ms();
+    size_t hits = 0;
+    for (uint32_t i = 0; i < N; ++i) hits += (size_t)mapped_hash_map_get(mm, &i, sizeof i, NULL, NULL);
+    double t4 = img_now_ms();
+
+    IMG_EXPECT(mm != NULL && hits == N, "Every key must be served from the mapping");
+    printf("  timings: %d entries: rebuild with puts=%.3f ms, open_mmap=%.3f ms, %d mapped gets=%.3f ms\n",
+           N, t1 - t0, t3 - t2, N, t4 - t3);
+
+    hash_map_close_mmap(mm);
+    hash_map_destroy(m, NULL);
+    remove(IMG_TEST_PATH);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_hashmap_image_tests(void) {
+    img_passed = img_failed = 0;
+    printf("[TEST] testing hashmap image...\n");
+
+    test_round_trip_keys_and_values();
+    test_empty_map_round_trip();
+    test_round_trip_keeps_hash_kind();
+    test_rejects_bad_inputs();
+    test_cold_start_timings();
+
+    if (img_failed == 0) {
+        printf("[TEST OK]  hashmap image: passed=%d failed=%d\n", img_passed, img_failed);
+    } else {
+        printf("[TEST FAIL] hashmap image: passed=%d failed=%d\n", img_passed, img_failed);
+    }
+}
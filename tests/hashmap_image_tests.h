@@ -0,0 +1,37 @@
+#ifndef HASHMAP_IMAGE_TESTS_H
+#define HASHMAP_IMAGE_TESTS_H
+
+#include "../hashmap/hashmap_image.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>      /* timespec_get, struct timespec */
+
+/* --- stderr silencer platform shims (same pattern as the BST tests) --- */
+#if defined(_WIN32)
+  #include <io.h>
+  #include <fcntl.h>
+  #define IMG_DEV_NULL  "NUL"
+  #define img_dup       _dup
+  #define img_dup2      _dup2
+  #define img_open      _open
+  #define img_close     _close
+  #define img_fileno    _fileno
+  #define IMG_O_WRONLY  _O_WRONLY
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #define IMG_DEV_NULL  "/dev/null"
+  #define img_dup       dup
+  #define img_dup2      dup2
+  #define img_open      open
+  #define img_close     close
+  #define img_fileno    fileno
+  #define IMG_O_WRONLY  O_WRONLY
+#endif
+
+/* Entry point for HashMap image (save / mmap) tests. Writes scratch files in the working directory. */
+void run_all_hashmap_image_tests(void);
+
+#endif /* HASHMAP_IMAGE_TESTS_H */
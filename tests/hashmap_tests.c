@@ -23,36 +23,41 @@ static void data_free_counter(void* p) {
     }
 }
 
-/* Compute bucket index (utility only for tests) */
-static size_t bucket_of(const void* key, size_t key_size) {
+/* Compute the home slot of a key in the map's current table (utility only for tests) */
+static size_t home_slot_of(const HashMap* m, const void* key, size_t key_size) {
     uint64_t h = generate_hash(key, key_size);
-    return (size_t)(h % HASH_MAP_BUCKET_NUM);
+    return (size_t)(h & (m->capacity - 1));
 }
 
-/* Find a different key that collides into the same bucket as (k,ks).
+/* Find a different key whose home slot is the same as target_slot in m.
  * Very simple search by appending a suffix; deterministic enough for tests. */
-static void make_colliding_key(char* out, size_t out_cap,
+static void make_colliding_key(const HashMap* m, char* out, size_t out_cap,
                                const void* base_key, size_t base_len,
-                               size_t target_bucket)
+                               size_t target_slot, unsigned start)
 {
     /* Start from base + "#i" */
-    for (unsigned i = 0; i < 200000; ++i) {
+    for (unsigned i = start; i < start + 200000; ++i) {
         int n = snprintf(out, (int)out_cap, "%.*s#%u", (int)base_len, (const char*)base_key, i);
         if (n <= 0 || (size_t)n >= out_cap) continue;
-        if (bucket_of(out, (size_t)n) == target_bucket) return;
+        if (home_slot_of(m, out, (size_t)n) == target_slot) return;
     }
     /* Fallback: keep the base (worst case will not collide) */
     snprintf(out, (int)out_cap, "%.*s#X", (int)base_len, (const char*)base_key);
 }
 
+static int is_power_of_two(size_t x) {
+    return x != 0 && (x & (x - 1)) == 0;
+}
+
 /* -------- Individual tests -------- */
 
-static void test_build_map_buckets_initialized(void) {
+static void test_build_map_table_initialized(void) {
     HashMap* m = build_hash_map();
-    /* sanity check some buckets (not NULL, empty) */
-    for (size_t i = 0; i < HASH_MAP_BUCKET_NUM; ++i) {
-        HM_EXPECT(m->buckets[i] != NULL, "Bucket head must be allocated");
-        HM_EXPECT(is_linked_list_empty(m->buckets[i]) == 1, "New bucket must be logically empty");
+    HM_EXPECT(m->capacity == HASH_MAP_INITIAL_CAPACITY, "New map must start at the initial capacity");
+    HM_EXPECT(is_power_of_two(m->capacity), "Capacity must be a power of two");
+    HM_EXPECT(m->size == 0 && m->tombstones == 0, "New map must be empty");
+    for (size_t i = 0; i < m->capacity + HASH_MAP_GROUP_WIDTH; ++i) {
+        HM_EXPECT(m->ctrl[i] == HASH_MAP_CTRL_EMPTY, "New control byte (and mirror) must be EMPTY");
     }
     hash_map_destroy(m, NULL);
 }
@@ -125,7 +130,7 @@ static void test_key_is_deep_copied(void) {
     hash_map_destroy(m, NULL);
 }
 
-static void test_remove_head_singleton_and_multinode(void) {
+static void test_remove_singleton_and_chain_head(void) {
     HashMap* m = build_hash_map();
 
     const char* k1 = "HEAD-ONLY";
@@ -133,134 +138,961 @@ static void test_remove_head_singleton_and_multinode(void) {
     char* v1 = (char*)malloc(2); memcpy(v1, "A", 2);
     g_data_free_count = 0;
 
-    /* single-node bucket removal */
+    /* lone key removal */
     (void)hash_map_put(m, k1, ks1, v1, 2, data_free_counter);
-    HM_EXPECT(hash_map_remove(m, k1, ks1, data_free_counter) == 1, "Remove must succeed for single-node bucket");
+    HM_EXPECT(hash_map_remove(m, k1, ks1, data_free_counter) == 1, "Remove must succeed for a lone key");
     HM_EXPECT(hash_map_get(m, k1, ks1) == NULL, "Get must return NULL after removal");
     HM_EXPECT(g_data_free_count == 1, "Owned value must be freed on removal");
+    HM_EXPECT(m->size == 0, "Size must drop back to 0");
 
-    /* multi-node head removal (promote second) */
+    /* remove the first key of a probe chain: the second must stay reachable */
     const char* base = "COLLIDE";
     size_t base_len = strlen(base);
-    size_t target_bucket = bucket_of(base, base_len);
+    size_t target_slot = home_slot_of(m, base, base_len);
 
-    /* insert head */
     char* vH = (char*)malloc(2); memcpy(vH, "H", 2);
     (void)hash_map_put(m, base, base_len, vH, 2, data_free_counter);
 
-    /* find another key colliding into same bucket to become second */
+    /* find another key with the same home slot: it lands right after base */
     char k2buf[64];
-    make_colliding_key(k2buf, sizeof k2buf, base, base_len, target_bucket);
+    make_colliding_key(m, k2buf, sizeof k2buf, base, base_len, target_slot, 0);
+    HM_EXPECT(home_slot_of(m, k2buf, strlen(k2buf)) == target_slot, "k2 must share base's home slot");
 
     char* vS = (char*)malloc(2); memcpy(vS, "S", 2);
     (void)hash_map_put(m, k2buf, strlen(k2buf), vS, 2, data_free_counter);
 
-    /* remove head; second should be promoted, and still retrievable */
-    size_t frees_before = g_data_free_count;
-    HM_EXPECT(hash_map_remove(m, base, base_len, data_free_counter) == 1, "Remove head from multi-node bucket must succeed");
+    int frees_before = g_data_free_count;
+    HM_EXPECT(hash_map_remove(m, base, base_len, data_free_counter) == 1, "Remove chain head must succeed");
     HM_EXPECT(hash_map_get(m, base, base_len) == NULL, "Head key must no longer be present after removal");
     HM_EXPECT(hash_map_get(m, k2buf, strlen(k2buf)) != NULL, "Second key must survive head removal");
     HM_EXPECT(g_data_free_count == frees_before + 1, "Owned head value must be freed exactly once");
+    /* a lightly loaded table has EMPTY bytes in every window: no tombstone needed */
+    HM_EXPECT(m->ctrl[target_slot] == HASH_MAP_CTRL_EMPTY && m->tombstones == 0,
+              "Removed chain head in a sparse group must go back to EMPTY");
 
-    hash_map_destroy(m, data_free_counter); /* frees vS if still present */
+    hash_map_destroy(m, data_free_counter); /* frees vS */
 }
 
-static void test_remove_non_head(void) {
+static void test_remove_middle_of_chain(void) {
     HashMap* m = build_hash_map();
 
     const char* base = "COLLIDE-NH";
     size_t base_len = strlen(base);
-    size_t target_bucket = bucket_of(base, base_len);
+    size_t target_slot = home_slot_of(m, base, base_len);
 
-    /* Try to build two extra keys that collide in the same target bucket */
+    /* Two extra keys with the same home slot (distinct suffix ranges) */
     char k2buf[64], k3buf[64];
-    make_colliding_key(k2buf, sizeof k2buf, base, base_len, target_bucket);
-    make_colliding_key(k3buf, sizeof k3buf, base, base_len, target_bucket);
-
-    /* Fallback: if they don't collide, deterministically craft colliding keys */
-    if (bucket_of(k2buf, strlen(k2buf)) != target_bucket || strcmp(k2buf, base) == 0) {
-        unsigned long long s = 1;
-        for (;; ++s) {
-            int n = snprintf(k2buf, sizeof k2buf, "%s#%llu", base, s);
-            if (n > 0 && (size_t)n < sizeof k2buf &&
-                bucket_of(k2buf, (size_t)n) == target_bucket &&
-                strcmp(k2buf, base) != 0) {
-                break;
-            }
-        }
-    }
-    if (bucket_of(k3buf, strlen(k3buf)) != target_bucket || strcmp(k3buf, base) == 0 || strcmp(k3buf, k2buf) == 0) {
-        unsigned long long s = 1000000ULL; /* start far to avoid k2 suffixes */
-        for (;; ++s) {
-            int n = snprintf(k3buf, sizeof k3buf, "%s#%llu", base, s);
-            if (n > 0 && (size_t)n < sizeof k3buf &&
-                bucket_of(k3buf, (size_t)n) == target_bucket &&
-                strcmp(k3buf, base) != 0 &&
-                strcmp(k3buf, k2buf) != 0) {
-                break;
-            }
-        }
-    }
+    make_colliding_key(m, k2buf, sizeof k2buf, base, base_len, target_slot, 0);
+    make_colliding_key(m, k3buf, sizeof k3buf, base, base_len, target_slot, 1000000u);
 
     /* Sanity: now they MUST collide */
-    HM_EXPECT(bucket_of(k2buf, strlen(k2buf)) == target_bucket, "k2 must collide in target bucket");
-    HM_EXPECT(bucket_of(k3buf, strlen(k3buf)) == target_bucket, "k3 must collide in target bucket");
+    HM_EXPECT(home_slot_of(m, k2buf, strlen(k2buf)) == target_slot, "k2 must collide in target slot");
+    HM_EXPECT(home_slot_of(m, k3buf, strlen(k3buf)) == target_slot, "k3 must collide in target slot");
+    HM_EXPECT(strcmp(k2buf, k3buf) != 0, "k2 and k3 must differ");
 
     /* Allocate tiny values (owned by the map via data_free_counter) */
     char* v1 = (char*)malloc(2); memcpy(v1, "1", 2);
     char* v2 = (char*)malloc(2); memcpy(v2, "2", 2);
     char* v3 = (char*)malloc(2); memcpy(v3, "3", 2);
 
-    /* Insert in order: head (base), middle (k2), tail (k3) */
-    (void)hash_map_put(m, base,  base_len,      v1, 2, data_free_counter); /* head */
-    (void)hash_map_put(m, k2buf, strlen(k2buf), v2, 2, data_free_counter); /* middle */
-    (void)hash_map_put(m, k3buf, strlen(k3buf), v3, 2, data_free_counter); /* tail */
-
-    /* Bucket must now contain exactly 3 nodes */
-    LinkedList bucket = m->buckets[target_bucket];
-    HM_EXPECT(!is_linked_list_empty(bucket), "Bucket must be non-empty before removal");
-    size_t size_before = get_linked_list_size(bucket);
-    HM_EXPECT(size_before == 3, "Bucket size must be 3 before removal");
-
-    /* Tail before should be k3 */
-    LinkedListNode* tail_before = get_linked_list_last_element(bucket);
-    HM_EXPECT(tail_before != NULL, "Tail must exist before removal");
-    HashMapItem* tail_item_before = (HashMapItem*)tail_before->data;
-    HM_EXPECT(tail_item_before != NULL, "Tail item must be non-null before removal");
-    HM_EXPECT(tail_item_before->key_size == strlen(k3buf), "Tail key size must match before removal");
-    HM_EXPECT(memcmp(tail_item_before->key, k3buf, strlen(k3buf)) == 0, "Tail before must be k3");
-
-    /* Remove the non-head (middle) key */
-    size_t frees_before = (size_t)g_data_free_count;
+    /* Insert in order: head (base), middle (k2), tail (k3) → three consecutive slots */
+    g_data_free_count = 0;
+    (void)hash_map_put(m, base,  base_len,      v1, 2, data_free_counter);
+    (void)hash_map_put(m, k2buf, strlen(k2buf), v2, 2, data_free_counter);
+    (void)hash_map_put(m, k3buf, strlen(k3buf), v3, 2, data_free_counter);
+    HM_EXPECT(m->size == 3, "Map size must be 3 before removal");
+
+    size_t middle = (target_slot + 1) & (m->capacity - 1);
+    size_t tail   = (target_slot + 2) & (m->capacity - 1);
+    HM_EXPECT(m->ctrl[middle] == HASH_MAP_H2(generate_hash(k2buf, strlen(k2buf))) &&
+              memcmp(m->slots[middle].key, k2buf, strlen(k2buf)) == 0, "k2 must sit right after its home slot");
+    HM_EXPECT(m->ctrl[tail] == HASH_MAP_H2(generate_hash(k3buf, strlen(k3buf))) &&
+              memcmp(m->slots[tail].key, k3buf, strlen(k3buf)) == 0, "k3 must sit two slots after its home slot");
+
+    /* Remove the middle key */
     HM_EXPECT(hash_map_remove(m, k2buf, strlen(k2buf), data_free_counter) == 1,
-              "Remove non-head must succeed");
+              "Remove middle must succeed");
 
-    /* Middle must be gone; head and tail must still be findable */
+    /* Middle must be gone; head and tail must still be findable across the hole */
     HM_EXPECT(hash_map_get(m, k2buf, strlen(k2buf)) == NULL, "Removed middle key must be gone");
     HM_EXPECT(hash_map_get(m, base,  base_len)      != NULL, "Head must still exist");
     HM_EXPECT(hash_map_get(m, k3buf, strlen(k3buf)) != NULL, "Tail must still exist");
+    HM_EXPECT(m->size == 2, "Map size must decrease by 1");
+    HM_EXPECT(m->tombstones == 0 && m->ctrl[middle] == HASH_MAP_CTRL_EMPTY,
+              "Middle slot of a sparse group must go back to EMPTY");
+    HM_EXPECT(g_data_free_count == 1, "Owned middle value must be freed once");
+
+    /* Re-inserting k2 must reuse the freed slot */
+    char* v2b = (char*)malloc(2); memcpy(v2b, "4", 2);
+    HM_EXPECT(hash_map_put(m, k2buf, strlen(k2buf), v2b, 2, data_free_counter) == 0, "Re-insert must be new");
+    HM_EXPECT(HASH_MAP_CTRL_IS_FULL(m->ctrl[middle]), "Freed slot must be reused");
+
+    hash_map_destroy(m, data_free_counter);
+    HM_EXPECT(g_data_free_count == 4, "Destroy must free every remaining owned value");
+}
+
+static void test_tombstone_keeps_full_group_reachable(void) {
+    HashMap* m = build_hash_map();
+
+    /* Fillers push the table to 64 slots */
+    for (unsigned i = 0; i < 30; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    const size_t cap = m->capacity;
+    HM_EXPECT(cap == 64, "30 fillers must grow the table to 64 slots");
+
+    /* 20 keys sharing one home slot fill its whole first group and spill over */
+    char keys[20][64];
+    const char* base = "TOMB";
+    size_t target_slot = home_slot_of(m, base, strlen(base));
+    for (unsigned k = 0; k < 20; ++k) {
+        make_colliding_key(m, keys[k], sizeof keys[k], base, strlen(base), target_slot, k * 100000u);
+        (void)hash_map_put(m, keys[k], strlen(keys[k]), NULL, 0, NULL);
+    }
+    HM_EXPECT(m->capacity == cap, "Colliding keys must not trigger growth");
+
+    /* Remove whatever sits in the middle of the (now full) home group */
+    size_t victim_slot = (target_slot + HASH_MAP_GROUP_WIDTH / 2) & (cap - 1);
+    HM_EXPECT(HASH_MAP_CTRL_IS_FULL(m->ctrl[victim_slot]), "Home group must be full");
+    char victim[64];
+    size_t victim_len = m->slots[victim_slot].key_size;
+    memcpy(victim, m->slots[victim_slot].key, victim_len);
+    HM_EXPECT(hash_map_remove(m, victim, victim_len, NULL) == 1, "Remove from a full group must succeed");
+    HM_EXPECT(m->ctrl[victim_slot] == HASH_MAP_CTRL_DELETED && m->tombstones == 1,
+              "Slot inside a full window must become a tombstone");
+
+    int all_found = 1;
+    for (unsigned k = 0; k < 20; ++k) {
+        int is_victim = strlen(keys[k]) == victim_len && memcmp(keys[k], victim, victim_len) == 0;
+        if ((hash_map_get(m, keys[k], strlen(keys[k])) != NULL) == is_victim) all_found = 0;
+    }
+    for (unsigned i = 0; i < 30; ++i) {
+        int is_victim = victim_len == sizeof i && memcmp(&i, victim, victim_len) == 0;
+        if ((hash_map_get(m, &i, sizeof i) != NULL) == is_victim) all_found = 0;
+    }
+    HM_EXPECT(all_found, "Keys probed past the tombstone must stay reachable");
+
+    hash_map_destroy(m, NULL);
+}
+
+static void test_growth_keeps_all_entries(void) {
+    HashMap* m = build_hash_map();
+    const unsigned N = 20000;
+
+    for (unsigned i = 0; i < N; ++i) {
+        HM_EXPECT(hash_map_put(m, &i, sizeof i, (void*)(uintptr_t)(i + 1), 0, NULL) == 0,
+                  "Insert of a fresh key must return 0");
+    }
+    HM_EXPECT(m->size == N, "Size must count every inserted key");
+    HM_EXPECT(is_power_of_two(m->capacity), "Capacity must stay a power of two");
+    HM_EXPECT((m->size + m->tombstones) * HASH_MAP_MAX_LOAD_DEN <= m->capacity * HASH_MAP_MAX_LOAD_NUM,
+              "Load factor must stay within the limit");
+
+    int all_found = 1;
+    for (unsigned i = 0; i < N; ++i) {
+        const HashMapItem* it = hash_map_get(m, &i, sizeof i);
+        if (it == NULL || it->data != (void*)(uintptr_t)(i + 1)) { all_found = 0; break; }
+    }
+    HM_EXPECT(all_found, "Every key must be retrievable with its value after growth");
+
+    /* Remove even keys, then churn inserts/removes to stress tombstone cleanup */
+    for (unsigned i = 0; i < N; i += 2) {
+        HM_EXPECT(hash_map_remove(m, &i, sizeof i, NULL) == 1, "Remove of a present key must succeed");
+    }
+    for (unsigned round = 0; round < 4; ++round) {
+        for (unsigned i = N; i < N + 5000; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+        for (unsigned i = N; i < N + 5000; ++i) (void)hash_map_remove(m, &i, sizeof i, NULL);
+    }
+    HM_EXPECT(m->size == N / 2, "Size must reflect removals");
+
+    int parity_ok = 1;
+    for (unsigned i = 0; i < N; ++i) {
+        const HashMapItem* it = hash_map_get(m, &i, sizeof i);
+        if ((i % 2 == 0) != (it == NULL)) { parity_ok = 0; break; }
+    }
+    HM_EXPECT(parity_ok, "Only odd keys must survive");
+    HM_EXPECT((m->size + m->tombstones) * HASH_MAP_MAX_LOAD_DEN <= m->capacity * HASH_MAP_MAX_LOAD_NUM,
+              "Tombstones must be accounted in the load limit");
+
+    hash_map_destroy(m, NULL);
+}
+
+static void test_incremental_rehash_is_bounded(void) {
+    HashMap* m = build_hash_map();
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_INCREMENTAL);
+    g_data_free_count = 0;
+
+    /* Grow until a migration starts, owning every value */
+    unsigned n = 0;
+    while (!hash_map_is_rehashing(m) && n < 100000) {
+        int* v = (int*)malloc(sizeof(int)); *v = (int)n;
+        (void)hash_map_put(m, &n, sizeof n, v, sizeof(int), data_free_counter);
+        n++;
+    }
+    HM_EXPECT(hash_map_is_rehashing(m), "Growth in incremental mode must leave a pending migration");
+
+    /* Keep inserting: each put may only advance the migration by one step */
+    int bounded = 1, all_found = 1;
+    size_t migrated_total = 0;
+    for (unsigned round = 0; round < 20000 && all_found; ++round, ++n) {
+        size_t pos_before = m->migrate_pos;
+        size_t old_cap_before = m->old_capacity;
+        int* v = (int*)malloc(sizeof(int)); *v = (int)n;
+        (void)hash_map_put(m, &n, sizeof n, v, sizeof(int), data_free_counter);
+        if (m->old_capacity == old_cap_before && m->migrate_pos > pos_before + HASH_MAP_REHASH_STEP_SLOTS) {
+            bounded = 0;
+        }
+        migrated_total++;
+
+        /* probe a few keys that may sit in either table */
+        unsigned probe = (n * 2654435761u) % (n + 1);
+        const HashMapItem* it = hash_map_get(m, &probe, sizeof probe);
+        if (it == NULL || *(const int*)it->data != (int)probe) all_found = 0;
+    }
+    HM_EXPECT(bounded, "A single put must not migrate more than HASH_MAP_REHASH_STEP_SLOTS slots");
+    HM_EXPECT(all_found, "Gets must find keys in both the old and the new table");
+    HM_EXPECT(m->size == n, "Size must count entries in both tables");
+
+    /* Update and remove keys while a migration may be pending */
+    while (!hash_map_is_rehashing(m)) {
+        int* v = (int*)malloc(sizeof(int)); *v = (int)n;
+        (void)hash_map_put(m, &n, sizeof n, v, sizeof(int), data_free_counter);
+        n++;
+    }
+    unsigned victim = 0; /* low slots migrate first, but any key works: put searches both tables */
+    int* nv = (int*)malloc(sizeof(int)); *nv = -1;
+    HM_EXPECT(hash_map_put(m, &victim, sizeof victim, nv, sizeof(int), data_free_counter) == 1,
+              "Update of a not-yet-migrated key must be reported as update");
+    HM_EXPECT(*(const int*)hash_map_get(m, &victim, sizeof victim)->data == -1, "Updated value must be visible");
+    unsigned gone = 1;
+    HM_EXPECT(hash_map_remove(m, &gone, sizeof gone, data_free_counter) == 1, "Remove during migration must succeed");
+    HM_EXPECT(hash_map_get(m, &gone, sizeof gone) == NULL, "Removed key must be gone");
+
+    /* Idle-time draining */
+    while (hash_map_rehash_step(m, 16)) { }
+    HM_EXPECT(!hash_map_is_rehashing(m) && m->old_slots == NULL, "Draining must end the migration");
+
+    int ok = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        const HashMapItem* it = hash_map_get(m, &i, sizeof i);
+        if (i == gone) { if (it != NULL) ok = 0; continue; }
+        if (it == NULL) { ok = 0; break; }
+    }
+    HM_EXPECT(ok, "All surviving keys must be found after migration");
+
+    /* Destroying mid-migration must release both tables (checked by leak tools) */
+    while (!hash_map_is_rehashing(m)) {
+        (void)hash_map_put(m, &n, sizeof n, NULL, 0, NULL);
+        n++;
+    }
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_STOP_THE_WORLD);
+    HM_EXPECT(!hash_map_is_rehashing(m), "Switching to stop-the-world must finish the migration");
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_INCREMENTAL);
+    while (!hash_map_is_rehashing(m)) {
+        (void)hash_map_put(m, &n, sizeof n, NULL, 0, NULL);
+        n++;
+    }
+    hash_map_destroy(m, data_free_counter);
+}
+
+static void test_small_keys_are_stored_inline(void) {
+    HashMap* m = build_hash_map();
+
+    char short_key[HASH_MAP_INLINE_KEY_SIZE];
+    char long_key[HASH_MAP_INLINE_KEY_SIZE + 1];
+    memset(short_key, 's', sizeof short_key);
+    memset(long_key, 'l', sizeof long_key);
+
+    (void)hash_map_put(m, short_key, sizeof short_key, NULL, 0, NULL);
+    (void)hash_map_put(m, long_key, sizeof long_key, NULL, 0, NULL);
+    (void)hash_map_put(m, "", 0, NULL, 0, NULL);
+
+    const HashMapItem* s_it = hash_map_get(m, short_key, sizeof short_key);
+    const HashMapItem* l_it = hash_map_get(m, long_key, sizeof long_key);
+    HM_EXPECT(s_it != NULL && s_it->key == (const void*)s_it->inline_key, "Key of inline size must live in the item");
+    HM_EXPECT(l_it != NULL && l_it->key != (const void*)l_it->inline_key, "Longer key must spill to the heap");
+    HM_EXPECT(l_it != NULL && memcmp(l_it->key, long_key, sizeof long_key) == 0, "Spilled key must be a faithful copy");
+    HM_EXPECT(hash_map_get(m, "", 0) != NULL, "Empty key must be storable");
+
+    /* Force several rehashes: inline key pointers must follow their items */
+    for (unsigned i = 0; i < 5000; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    int inline_ok = 1;
+    for (size_t i = 0; i < m->capacity; ++i) {
+        if (!HASH_MAP_CTRL_IS_FULL(m->ctrl[i])) continue;
+        const HashMapItem* it = &m->slots[i];
+        if ((it->key_size <= HASH_MAP_INLINE_KEY_SIZE) != (it->key == (const void*)it->inline_key)) inline_ok = 0;
+    }
+    HM_EXPECT(inline_ok, "Inline key pointers must be re-targeted when items move");
+    s_it = hash_map_get(m, short_key, sizeof short_key);
+    HM_EXPECT(s_it != NULL && memcmp(s_it->key, short_key, sizeof short_key) == 0, "Inline key must survive rehash");
+
+    /* Shallow heap copy keeps the invariant too */
+    HashMapItem* copy = (HashMapItem*)ll_alloc_HashMapItem(*s_it);
+    HM_EXPECT(copy->key == (void*)copy->inline_key, "ll_alloc_HashMapItem must re-point inline keys");
+    free(copy);
+
+    hash_map_destroy(m, NULL);
+}
+
+static void test_batch_ops_match_single_ops(void) {
+    HashMap* m = build_hash_map();
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_INCREMENTAL);  /* batches must cope with both tables */
+    enum { N = 3000 };
+
+    static uint32_t ids[N];
+    static const void* keys[N];
+    static size_t sizes[N];
+    static const void* vals[N];
+    for (uint32_t i = 0; i < N; ++i) {
+        ids[i] = i * 7u + 1u;
+        keys[i] = &ids[i];
+        sizes[i] = sizeof ids[i];
+        vals[i] = (const void*)(uintptr_t)(i + 100u);
+    }
+
+    HM_EXPECT(hash_map_put_batch(m, keys, sizes, vals, NULL, N, NULL) == 0, "First batch put must only insert");
+    HM_EXPECT(m->size == N, "Batch put must insert every key");
+    HM_EXPECT(hash_map_put_batch(m, keys, sizes, NULL, NULL, N / 2, NULL) == N / 2, "Second batch put must update");
+
+    static const HashMapItem* found[N];
+    hash_map_get_batch(m, keys, sizes, N, found);
+    int same = 1;
+    for (uint32_t i = 0; i < N; ++i) {
+        const void* expected = i < N / 2 ? NULL : vals[i];
+        if (found[i] == NULL || found[i] != hash_map_get(m, keys[i], sizes[i]) || found[i]->data != expected) same = 0;
+    }
+    HM_EXPECT(same, "Batch get must return the same items as hash_map_get");
+
+    uint32_t missing_id = 2;  /* ids are 1 mod 7 */
+    const void* missing_key = &missing_id;
+    size_t missing_size = sizeof missing_id;
+    const HashMapItem* missing = (const HashMapItem*)1;
+    hash_map_get_batch(m, &missing_key, &missing_size, 1, &missing);
+    HM_EXPECT(missing == NULL, "Batch get must report missing keys as NULL");
+
+    HM_EXPECT(hash_map_remove_batch(m, keys, sizes, N, NULL) == N, "Batch remove must remove every key");
+    HM_EXPECT(hash_map_remove_batch(m, keys, sizes, N, NULL) == 0, "Second batch remove must find nothing");
+    HM_EXPECT(m->size == 0, "Map must be empty after batch remove");
+
+    hash_map_destroy(m, NULL);
+}
+
+/* Prints single vs batch lookup timings on a table much larger than the caches. */
+static double hm_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static void test_batch_get_perf(void) {
+    enum { N = 1 << 18, LOOKUPS = 1 << 19 };
+    HashMap* m = build_hash_map();
+    for (uint32_t i = 0; i < N; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+
+    uint32_t* ids = malloc(LOOKUPS * sizeof(uint32_t));
+    const void** keys = malloc(LOOKUPS * sizeof(void*));
+    size_t* sizes = malloc(LOOKUPS * sizeof(size_t));
+    const HashMapItem** out = malloc(LOOKUPS * sizeof(HashMapItem*));
+    HM_EXPECT(ids && keys && sizes && out, "perf buffers must allocate");
+    if (!ids || !keys || !sizes || !out) {
+        free(ids); free(keys); free(sizes); free(out);
+        hash_map_destroy(m, NULL);
+        return;
+    }
+
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < LOOKUPS; ++i) {
+        x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+        ids[i] = (uint32_t)((x * 2685821657736338717ULL) >> 40) % N;
+        keys[i] = &ids[i];
+        sizes[i] = sizeof ids[i];
+    }
+
+    double t0 = hm_now_ms();
+    size_t hits_single = 0;
+    for (size_t i = 0; i < LOOKUPS; ++i) hits_single += hash_map_get(m, keys[i], sizes[i]) != NULL;
+    double t1 = hm_now_ms();
+    hash_map_get_batch(m, keys, sizes, LOOKUPS, out);
+    double t2 = hm_now_ms();
+
+    size_t hits_batch = 0;
+    for (size_t i = 0; i < LOOKUPS; ++i) hits_batch += out[i] != NULL;
+    HM_EXPECT(hits_single == LOOKUPS && hits_batch == LOOKUPS, "Every perf lookup must hit");
+
+    printf("  timings: %d lookups over %d keys: single=%.3f ms, batch=%.3f ms, speedup x%.2f\n",
+           LOOKUPS, N, t1 - t0, t2 - t1, (t2 - t1) > 0.0 ? (t1 - t0) / (t2 - t1) : 0.0);
+
+    free(ids); free(keys); free(sizes); free(out);
+    hash_map_destroy(m, NULL);
+}
+
+static void test_prehashed_ops_interoperate(void) {
+    HashMap* m = build_hash_map();
+    const char* a = "prehashed-key-longer-than-inline";
+    const char* b = "plain";
+    uint64_t ha = generate_hash(a, strlen(a));
+    uint64_t hb = generate_hash(b, strlen(b));
+
+    HM_EXPECT(hash_map_put_prehashed(m, ha, a, strlen(a), (void*)1, 0, NULL) == 0, "Pre-hashed put must insert");
+    HM_EXPECT(hash_map_put(m, b, strlen(b), (void*)2, 0, NULL) == 0, "Plain put must insert");
+
+    const HashMapItem* it = hash_map_get(m, a, strlen(a));
+    HM_EXPECT(it != NULL && it->data == (void*)1 && it->hash == ha, "Plain get must see a pre-hashed put");
+    it = hash_map_get_prehashed(m, hb, b, strlen(b));
+    HM_EXPECT(it != NULL && it->data == (void*)2, "Pre-hashed get must see a plain put");
+    HM_EXPECT(hash_map_put_prehashed(m, hb, b, strlen(b), (void*)3, 0, NULL) == 1, "Pre-hashed put must update");
+
+    HM_EXPECT(hash_map_remove_prehashed(m, ha, a, strlen(a), NULL) == 1, "Pre-hashed remove must find the key");
+    HM_EXPECT(hash_map_get(m, a, strlen(a)) == NULL, "Removed key must be gone");
+    HM_EXPECT(hash_map_get_prehashed(m, hb, b, strlen(b))->data == (void*)3, "Other key must be untouched");
+
+    /* Long keys: lookups that skip hashing only pay the final key compare */
+    enum { KEYS = 256, KEY_LEN = 1024, ROUNDS = 64 };
+    char (*keys)[KEY_LEN] = malloc(KEYS * sizeof *keys);
+    uint64_t* hashes = malloc(KEYS * sizeof(uint64_t));
+    HM_EXPECT(keys && hashes, "Long-key buffers must allocate");
+    if (keys && hashes) {
+        for (int k = 0; k < KEYS; ++k) {
+            memset(keys[k], 'a' + k % 26, KEY_LEN);
+            memcpy(keys[k], &k, sizeof k);
+            hashes[k] = generate_hash(keys[k], KEY_LEN);
+            (void)hash_map_put(m, keys[k], KEY_LEN, NULL, 0, NULL);
+        }
+
+        size_t hits = 0;
+        double t0 = hm_now_ms();
+        for (int r = 0; r < ROUNDS; ++r)
+            for (int k = 0; k < KEYS; ++k) hits += hash_map_get(m, keys[k], KEY_LEN) != NULL;
+        double t1 = hm_now_ms();
+        for (int r = 0; r < ROUNDS; ++r)
+            for (int k = 0; k < KEYS; ++k) hits += hash_map_get_prehashed(m, hashes[k], keys[k], KEY_LEN) != NULL;
+        double t2 = hm_now_ms();
+
+        HM_EXPECT(hits == 2u * ROUNDS * KEYS, "Every long-key lookup must hit");
+        printf("  timings: %d lookups of %d-byte keys: hashed=%.3f ms, prehashed=%.3f ms, speedup x%.2f\n",
+               ROUNDS * KEYS, KEY_LEN, t1 - t0, t2 - t1, (t2 - t1) > 0.0 ? (t1 - t0) / (t2 - t1) : 0.0);
+    }
+
+    free(keys);
+    free(hashes);
+    hash_map_destroy(m, NULL);
+}
+
+/* Sums key values and counts visits, for the iteration tests. */
+typedef struct { size_t visits; uint64_t key_sum; } HmVisitTally;
+
+static void hm_tally_visit(const HashMapItem* item, void* ctx) {
+    HmVisitTally* t = (HmVisitTally*)ctx;
+    uint32_t k;
+    memcpy(&k, item->key, sizeof k);
+    t->visits++;
+    t->key_sum += k;
+}
+
+static void test_iteration_visits_every_entry_once(void) {
+    HashMap* m = build_hash_map();
+    const uint32_t N = 5000;
+    uint64_t expected_sum = 0;
+    for (uint32_t i = 0; i < N; ++i) {
+        (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+        expected_sum += i;
+    }
 
-    /* Bucket size decreased by 1 and the (logical) tail persists as k3 */
-    bucket = m->buckets[target_bucket];
-    HM_EXPECT(!is_linked_list_empty(bucket), "Bucket must remain non-empty after removal");
-    size_t size_after = get_linked_list_size(bucket);
-    HM_EXPECT(size_after == size_before - 1, "Bucket size must decrease by 1");
+    HashMapIterator it;
+    HmVisitTally tally = { 0, 0 };
+    const HashMapItem* prev = NULL;
+    int memory_order = 1;
+    hash_map_iterator_init(&it, m);
+    for (const HashMapItem* item = hash_map_iterator_next(&it); item; item = hash_map_iterator_next(&it)) {
+        if (prev != NULL && item <= prev) memory_order = 0;
+        prev = item;
+        hm_tally_visit(item, &tally);
+    }
+    HM_EXPECT(tally.visits == N && tally.key_sum == expected_sum, "Iterator must visit every entry exactly once");
+    HM_EXPECT(memory_order, "Iterator must walk the slots in memory order");
+    HM_EXPECT(!hash_map_iterator_invalidated(&it), "Untouched map must not invalidate the iterator");
+
+    HmVisitTally each = { 0, 0 };
+    hash_map_for_each(m, hm_tally_visit, &each);
+    HM_EXPECT(each.visits == N && each.key_sum == expected_sum, "for_each must visit every entry exactly once");
+
+    /* Removing the entry just returned keeps the walk going */
+    hash_map_iterator_init(&it, m);
+    size_t removed = 0;
+    for (const HashMapItem* item = hash_map_iterator_next(&it); item; item = hash_map_iterator_next(&it)) {
+        uint32_t k;
+        memcpy(&k, item->key, sizeof k);
+        if (k % 2 == 0) removed += (size_t)hash_map_remove(m, &k, sizeof k, NULL);
+    }
+    HM_EXPECT(removed == N / 2 && m->size == N - N / 2, "Removing the current item must not derail the iterator");
+
+    /* Growth moves items: an open iterator must stop and say so */
+    hash_map_iterator_init(&it, m);
+    (void)hash_map_iterator_next(&it);
+    for (uint32_t i = N; i < 4 * N; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    HM_EXPECT(hash_map_iterator_next(&it) == NULL && hash_map_iterator_invalidated(&it),
+              "Iterator must be invalidated by a rehash");
+
+    HashMap* empty = build_hash_map();
+    hash_map_iterator_init(&it, empty);
+    HM_EXPECT(hash_map_iterator_next(&it) == NULL, "Empty map must yield nothing");
+    hash_map_destroy(empty, NULL);
+    hash_map_destroy(m, NULL);
+}
+
+static void test_iteration_covers_both_tables_while_rehashing(void) {
+    HashMap* m = build_hash_map();
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_INCREMENTAL);
+    uint32_t i = 0;
+    while (!hash_map_is_rehashing(m) || m->old_size < 100) {
+        (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+        ++i;
+        if (i > 100000) break;
+    }
+    HM_EXPECT(hash_map_is_rehashing(m), "Setup must leave a migration pending");
+
+    HmVisitTally tally = { 0, 0 };
+    hash_map_for_each(m, hm_tally_visit, &tally);
+    HM_EXPECT(tally.visits == m->size && tally.key_sum == (uint64_t)i * (i - 1) / 2,
+              "for_each must cover the old and the current table");
+
+    hash_map_destroy(m, NULL);
+}
+
+static void test_cursor_scans_in_slices(void) {
+    HashMap* m = build_hash_map();
+    const uint32_t N = 3000;
+    uint64_t expected_sum = 0;
+    for (uint32_t i = 0; i < N; ++i) {
+        (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+        expected_sum += i;
+    }
+
+    HashMapCursor cursor;
+    HmVisitTally tally = { 0, 0 };
+    size_t slices = 0;
+    hash_map_cursor_init(&cursor);
+    while (hash_map_scan(m, &cursor, 100, hm_tally_visit, &tally)) slices++;
+    slices++;
+    HM_EXPECT(tally.visits == N && tally.key_sum == expected_sum, "Sliced scan must visit every entry exactly once");
+    HM_EXPECT(slices == (m->capacity + 99) / 100, "Each slice must cover at most max_slots slots");
+    HM_EXPECT(cursor.restarts == 0, "A quiet map must not restart the scan");
+
+    /* Modifications between slices that do not move items are tolerated */
+    hash_map_cursor_init(&cursor);
+    tally = (HmVisitTally){ 0, 0 };
+    (void)hash_map_scan(m, &cursor, 64, hm_tally_visit, &tally);
+    uint32_t gone = N + 1;  /* not present: no-op */
+    (void)hash_map_remove(m, &gone, sizeof gone, NULL);
+    while (hash_map_scan(m, &cursor, 64, hm_tally_visit, &tally)) {}
+    HM_EXPECT(tally.visits == N && cursor.restarts == 0, "Non-moving changes must not restart the pass");
+
+    /* A rehash between slices restarts the pass */
+    hash_map_cursor_init(&cursor);
+    tally = (HmVisitTally){ 0, 0 };
+    (void)hash_map_scan(m, &cursor, 64, hm_tally_visit, &tally);
+    for (uint32_t i = N; i < 4 * N; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    tally = (HmVisitTally){ 0, 0 };
+    while (hash_map_scan(m, &cursor, 64, hm_tally_visit, &tally)) {}
+    HM_EXPECT(cursor.restarts == 1 && tally.visits == 4 * N, "A rehash must restart the pass from scratch");
+
+    hash_map_destroy(m, NULL);
+}
+
+static size_t hm_histogram_total(const HashMapStats* st) {
+    size_t total = 0;
+    for (size_t b = 0; b < HASH_MAP_STATS_PROBE_BUCKETS; ++b) total += st->probe_histogram[b];
+    return total;
+}
+
+static void test_stats_track_entries_and_bytes(void) {
+    HashMap* m = build_hash_map();
+    HashMapStats st;
+
+    hash_map_stats(m, &st);
+    HM_EXPECT(st.entries == 0 && st.key_heap_bytes == 0 && st.max_probe_length == 0, "Empty map stats must be zero");
+    HM_EXPECT(st.capacity == HASH_MAP_INITIAL_CAPACITY && st.load_factor == 0.0, "Empty map must report its capacity");
+
+    /* 1000 short (inline) keys and 1000 keys of 40 bytes (spilled) */
+    char long_key[40];
+    memset(long_key, 'L', sizeof long_key);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+        memcpy(long_key, &i, sizeof i);
+        (void)hash_map_put(m, long_key, sizeof long_key, NULL, 0, NULL);
+    }
+    (void)hash_map_put(m, long_key, sizeof long_key, (void*)1, 0, NULL);  /* update: no new key copy */
+
+    hash_map_stats(m, &st);
+    HM_EXPECT(st.entries == 2000, "Stats must count every entry");
+    HM_EXPECT(st.key_heap_bytes == 1000 * sizeof long_key, "Only spilled keys count as key heap bytes");
+    HM_EXPECT(st.table_bytes == st.capacity * (sizeof(HashMapItem) + 1) + HASH_MAP_GROUP_WIDTH,
+              "Table bytes must cover slots and control bytes");
+    HM_EXPECT(st.total_bytes == sizeof(HashMap) + st.table_bytes + st.key_heap_bytes, "Total must add up");
+    HM_EXPECT(st.load_factor > 0.0 && st.load_factor <= 7.0 / 8.0, "Load factor must respect the 7/8 limit");
+    HM_EXPECT(hm_histogram_total(&st) == st.entries, "Histogram must account for every entry");
+    HM_EXPECT(st.max_probe_length >= 1 && st.mean_probe_length >= 1.0 &&
+              st.mean_probe_length <= (double)st.max_probe_length, "Probe lengths must be consistent");
+
+    for (uint32_t i = 0; i < 500; ++i) {
+        memcpy(long_key, &i, sizeof i);
+        (void)hash_map_remove(m, long_key, sizeof long_key, NULL);
+    }
+    hash_map_stats(m, &st);
+    HM_EXPECT(st.entries == 1500 && st.key_heap_bytes == 500 * sizeof long_key, "Removes must release key bytes");
+
+    /* During an incremental rehash both tables are measured */
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_INCREMENTAL);
+    for (uint32_t i = 1000; !hash_map_is_rehashing(m) && i < 100000; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    hash_map_stats(m, &st);
+    HM_EXPECT(st.old_capacity > 0 && st.old_entries > 0, "Stats must expose a pending migration");
+    HM_EXPECT(hm_histogram_total(&st) == st.entries, "Histogram must cover both tables");
+
+    hash_map_destroy(m, NULL);
+}
+
+static void test_arena_map_recycles_keys(void) {
+    HashMap* m = build_arena_hash_map();
+    char key[96];
+    g_data_free_count = 0;
+
+    for (int i = 0; i < 4000; ++i) {
+        int kn = snprintf(key, sizeof key, "arena-key-%d-%.*s", i, i % 60, "................................................................");
+        int* v = (int*)malloc(sizeof(int)); *v = i;
+        (void)hash_map_put(m, key, (size_t)kn, v, sizeof(int), data_free_counter);
+    }
+    HashMapStats st;
+    hash_map_stats(m, &st);
+    size_t reserved = st.key_heap_bytes;
+    HM_EXPECT(reserved > 0 && st.total_bytes == sizeof(HashMap) + st.table_bytes + reserved,
+              "Arena chunks must show up as key heap bytes");
+
+    /* remove and re-insert the same key sizes: blocks must come back from the free lists */
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4000; i += 2) {
+            int kn = snprintf(key, sizeof key, "arena-key-%d-%.*s", i, i % 60, "................................................................");
+            (void)hash_map_remove(m, key, (size_t)kn, data_free_counter);
+        }
+        for (int i = 0; i < 4000; i += 2) {
+            int kn = snprintf(key, sizeof key, "arena-key-%d-%.*s", i, i % 60, "................................................................");
+            int* v = (int*)malloc(sizeof(int)); *v = i;
+            (void)hash_map_put(m, key, (size_t)kn, v, sizeof(int), data_free_counter);
+        }
+    }
+    hash_map_stats(m, &st);
+    HM_EXPECT(st.key_heap_bytes == reserved, "Removed key blocks must be reused, not re-allocated");
+    HM_EXPECT(g_data_free_count == 3 * 2000, "Removes must still free owned values");
+
+    int all_found = 1;
+    for (int i = 0; i < 4000; ++i) {
+        int kn = snprintf(key, sizeof key, "arena-key-%d-%.*s", i, i % 60, "................................................................");
+        const HashMapItem* it = hash_map_get(m, key, (size_t)kn);
+        if (it == NULL || *(const int*)it->data != i || memcmp(it->key, key, (size_t)kn) != 0) all_found = 0;
+    }
+    HM_EXPECT(all_found, "Every arena-backed key must still match after churn");
+
+    hash_map_destroy(m, data_free_counter);
+    HM_EXPECT(g_data_free_count == 3 * 2000 + 4000, "Arena destroy must still free every owned value");
+}
+
+/* Teardown cost: one free per spilled key vs whole arena chunks. */
+static void test_arena_destroy_perf(void) {
+    enum { N = 200000 };
+    char key[48];
+    HashMap* maps[2] = { build_hash_map(), build_arena_hash_map() };
+
+    for (int k = 0; k < 2; ++k) {
+        for (int i = 0; i < N; ++i) {
+            int kn = snprintf(key, sizeof key, "destroy-perf-key-%08d", i);
+            (void)hash_map_put(maps[k], key, (size_t)kn, NULL, 0, NULL);
+        }
+    }
+    HM_EXPECT(maps[0]->size == N && maps[1]->size == N, "Both maps must hold every key");
+
+    double t0 = hm_now_ms();
+    hash_map_destroy(maps[0], NULL);
+    double t1 = hm_now_ms();
+    hash_map_destroy(maps[1], NULL);
+    double t2 = hm_now_ms();
+    printf("  timings: destroy %d spilled keys: malloc=%.3f ms, arena=%.3f ms\n", N, t1 - t0, t2 - t1);
+}
 
-    LinkedListNode* tail_after = get_linked_list_last_element(bucket);
-    HM_EXPECT(tail_after != NULL, "Tail must still exist");
-    HashMapItem* tail_item_after = (HashMapItem*)tail_after->data;
-    HM_EXPECT(tail_item_after != NULL, "Tail item must be non-null after removal");
-    HM_EXPECT(tail_item_after->key_size == strlen(k3buf), "Tail key size must match after removal");
-    HM_EXPECT(memcmp(tail_item_after->key, k3buf, strlen(k3buf)) == 0, "Tail after must still be k3");
+static void test_hash_kinds_are_interchangeable(void) {
+    const int kinds[] = { HASH_MAP_HASH_MURMUR3, HASH_MAP_HASH_FAST64, HASH_MAP_HASH_INT64 };
+    char key[64];
 
-    /* Exactly one owned value (middle) must have been freed */
-    HM_EXPECT((size_t)g_data_free_count == frees_before + 1,
-              "Owned middle value must be freed once");
+    for (size_t k = 0; k < sizeof kinds / sizeof kinds[0]; ++k) {
+        HashMap* m = build_hash_map_with_hash(kinds[k], 0x1234567890ABCDEFULL + k);
+        int ok = 1;
+        for (uint64_t i = 0; i < 3000; ++i) {  /* 8-byte keys and strings of every size class */
+            int kn = snprintf(key, sizeof key, "k%llu%.*s", (unsigned long long)i, (int)(i % 40), "........................................");
+            (void)hash_map_put(m, &i, sizeof i, NULL, (size_t)i, NULL);
+            (void)hash_map_put(m, key, (size_t)kn, NULL, (size_t)i, NULL);
+        }
+        for (uint64_t i = 0; i < 3000; i += 3) (void)hash_map_remove(m, &i, sizeof i, NULL);
+        for (uint64_t i = 0; i < 3000; ++i) {
+            int kn = snprintf(key, sizeof key, "k%llu%.*s", (unsigned long long)i, (int)(i % 40), "........................................");
+            const HashMapItem* a = hash_map_get(m, &i, sizeof i);
+            const HashMapItem* b = hash_map_get(m, key, (size_t)kn);
+            if ((i % 3 == 0) != (a == NULL) || b == NULL || b->data_size != i) ok = 0;
+            if (b != NULL && b->hash != hash_map_hash_key(m, key, (size_t)kn)) ok = 0;
+        }
+        HM_EXPECT(ok && m->size == 5000, "Every hash kind must behave like a map");
+
+        uint64_t probe = 77;
+        uint64_t h = hash_map_hash_key(m, &probe, sizeof probe);
+        HM_EXPECT(hash_map_get_prehashed(m, h, &probe, sizeof probe) != NULL,
+                  "hash_map_hash_key must give the hash the pre-hashed calls expect");
+        hash_map_destroy(m, NULL);
+    }
+
+    HashMap* def = build_hash_map();
+    HM_EXPECT(hash_map_hash_key(def, "abc", 3) == generate_hash("abc", 3), "Default maps must keep hashing with generate_hash");
+    HashMap* seeded = build_hash_map_with_hash(HASH_MAP_HASH_FAST64, 1);
+    HashMap* reseeded = build_hash_map_with_hash(HASH_MAP_HASH_FAST64, 2);
+    HM_EXPECT(hash_map_hash_key(seeded, "abc", 3) != hash_map_hash_key(reseeded, "abc", 3), "The seed must change the hash");
+    HM_EXPECT(hash_map_random_seed() != hash_map_random_seed(), "Random seeds must differ between calls");
+    hash_map_destroy(seeded, NULL);
+    hash_map_destroy(reseeded, NULL);
+
+    /* switching on a populated, migrating map rehashes everything */
+    hash_map_set_rehash_mode(def, HASH_MAP_REHASH_INCREMENTAL);
+    uint32_t n = 0;
+    while ((n < 500 || !hash_map_is_rehashing(def)) && n < 100000) {
+        (void)hash_map_put(def, &n, sizeof n, NULL, n, NULL);
+        n++;
+    }
+    hash_map_set_hash(def, HASH_MAP_HASH_FAST64, hash_map_random_seed());
+    int all_found = !hash_map_is_rehashing(def) && def->size == n;
+    for (uint32_t i = 0; i < n; ++i) {
+        const HashMapItem* it = hash_map_get(def, &i, sizeof i);
+        if (it == NULL || it->data_size != i || it->hash != hash_map_hash_key(def, &i, sizeof i)) all_found = 0;
+    }
+    HM_EXPECT(all_found, "hash_map_set_hash must keep every entry reachable under the new hash");
+    hash_map_destroy(def, NULL);
+}
+
+/* Hash cost and put+get cost per hash kind, on the key shapes our maps see. */
+static void test_hash_kinds_perf(void) {
+    enum { N = 100000 };
+    static const char* const kind_names[] = { "murmur3", "fast64", "int64" };
+    static const size_t shape_sizes[] = { 8, 12, 40, 256 };
+    static const char* const shape_names[] = { "u64 ids", "12B strings", "40B keys", "256B keys" };
+    unsigned char* keys = malloc((size_t)N * 256);
+    if (keys == NULL) return;
+
+    for (size_t s = 0; s < sizeof shape_sizes / sizeof shape_sizes[0]; ++s) {
+        const size_t ks = shape_sizes[s];
+        for (size_t i = 0; i < N; ++i) {  /* ids are sequential; other shapes share a long prefix */
+            unsigned char* k = keys + i * ks;
+            memset(k, 'p', ks);
+            uint64_t id = (uint64_t)i;
+            memcpy(k + ks - sizeof id, &id, sizeof id);
+        }
+
+        printf("  timings: %s (%d keys):", shape_names[s], N);
+        for (int kind = HASH_MAP_HASH_MURMUR3; kind <= HASH_MAP_HASH_INT64; ++kind) {
+            uint64_t sink = 0;
+            double t0 = hm_now_ms();
+            for (size_t i = 0; i < N; ++i) sink ^= hash_map_hash_bytes(kind, 42, keys + i * ks, ks);
+            double t1 = hm_now_ms();
+
+            HashMap* m = build_hash_map_with_hash(kind, 42);
+            for (size_t i = 0; i < N; ++i) (void)hash_map_put(m, keys + i * ks, ks, NULL, 0, NULL);
+            size_t hits = 0;
+            for (size_t i = 0; i < N; ++i) hits += hash_map_get(m, keys + i * ks, ks) != NULL;
+            double t2 = hm_now_ms();
+            HM_EXPECT(hits == N && sink != 0, "Every key must be found whatever the hash kind");
+            hash_map_destroy(m, NULL);
+
+            printf(" %s hash=%.2f ms put+get=%.2f ms%s", kind_names[kind], t1 - t0, t2 - t1,
+                   kind == HASH_MAP_HASH_INT64 ? "\n" : ";");
+        }
+    }
+    free(keys);
+}
+
+/* upsert_with callback: keeps a heap-allocated int counter per key. */
+static void hm_count_update(HashMapItem* item, int inserted, void* ctx) {
+    (void)ctx;
+    if (inserted) {
+        item->data = calloc(1, sizeof(int));
+        item->data_size = sizeof(int);
+    }
+    (*(int*)item->data)++;
+}
+
+static void test_get_or_insert_and_upsert_with(void) {
+    HashMap* m = build_hash_map();
+    int inserted = -1;
+
+    HashMapItem* it = hash_map_get_or_insert(m, "apple", 5, &inserted);
+    HM_EXPECT(it != NULL && inserted == 1 && it->data == NULL && it->data_size == 0 && m->size == 1,
+              "get_or_insert must add an empty item for a new key");
+    it->data_size = 41;  /* mutate in place */
+    it = hash_map_get_or_insert(m, "apple", 5, &inserted);
+    HM_EXPECT(inserted == 0 && it->data_size == 41 && m->size == 1, "get_or_insert must return the existing item");
+    it->data_size++;
+    HM_EXPECT(hash_map_get(m, "apple", 5)->data_size == 42, "In-place updates must be visible to get");
+    (void)hash_map_get_or_insert(m, "pear", 4, NULL);  /* NULL 'inserted' is allowed */
+    HM_EXPECT(m->size == 2, "get_or_insert with NULL flag must still insert");
+
+    /* word count with owned counters, across growth and an incremental rehash */
+    hash_map_set_rehash_mode(m, HASH_MAP_REHASH_INCREMENTAL);
+    int ok = 1;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 5000; ++i) {
+            char word[32];
+            int len = snprintf(word, sizeof word, "word-number-%d", i);
+            int existed = hash_map_upsert_with(m, word, (size_t)len, hm_count_update, NULL);
+            if (existed != (round > 0)) ok = 0;
+        }
+    }
+    for (int i = 0; i < 5000; ++i) {
+        char word[32];
+        int len = snprintf(word, sizeof word, "word-number-%d", i);
+        const HashMapItem* item = hash_map_get(m, word, (size_t)len);
+        if (item == NULL || *(int*)item->data != 3) ok = 0;
+    }
+    HM_EXPECT(ok && m->size == 5002, "upsert_with must count every word exactly once per round");
+
+    HM_EXPECT(hash_map_remove(m, "word-number-0", 13, data_free_counter) == 1, "Upserted keys must be removable");
+    (void)hash_map_remove(m, "apple", 5, NULL);
+    (void)hash_map_remove(m, "pear", 4, NULL);
+    hash_map_destroy(m, free);
+}
+
+/* Counting 8-byte ids: get-then-put (two probes) vs get_or_insert (one). */
+static void test_get_or_insert_perf(void) {
+    enum { N = 400000, DISTINCT = 50000 };
+
+    double t0 = hm_now_ms();
+    HashMap* twice = build_hash_map();
+    for (uint64_t i = 0; i < N; ++i) {
+        uint64_t k = (i * 2654435761u) % DISTINCT;
+        const HashMapItem* item = hash_map_get(twice, &k, sizeof k);
+        (void)hash_map_put(twice, &k, sizeof k, NULL, item != NULL ? item->data_size + 1 : 1, NULL);
+    }
+    double t1 = hm_now_ms();
+    HashMap* once = build_hash_map();
+    for (uint64_t i = 0; i < N; ++i) {
+        uint64_t k = (i * 2654435761u) % DISTINCT;
+        hash_map_get_or_insert(once, &k, sizeof k, NULL)->data_size++;
+    }
+    double t2 = hm_now_ms();
+
+    int same = once->size == twice->size;
+    for (uint64_t k = 0; k < DISTINCT; ++k) {
+        const HashMapItem* a = hash_map_get(once, &k, sizeof k);
+        const HashMapItem* b = hash_map_get(twice, &k, sizeof k);
+        if (a == NULL || b == NULL || a->data_size != b->data_size) same = 0;
+    }
+    HM_EXPECT(same, "Both counting styles must produce the same counts");
+    printf("  timings: %d increments over %d keys: get+put=%.3f ms, get_or_insert=%.3f ms\n",
+           N, DISTINCT, t1 - t0, t2 - t1);
+
+    hash_map_destroy(twice, NULL);
+    hash_map_destroy(once, NULL);
+}
+
+static void test_reserve_prevents_rehash(void) {
+    HashMap* m = build_hash_map_with_capacity(10000);
+    size_t capacity = m->capacity, generation = m->generation;
+    HM_EXPECT(capacity / 8 * 7 >= 10000 && capacity / 2 / 8 * 7 < 10000, "Capacity must be the smallest that fits");
+
+    for (int i = 0; i < 10000; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    HM_EXPECT(m->capacity == capacity && m->generation == generation, "Reserved map must not rehash while filling");
+
+    hash_map_reserve(m, 10);
+    HM_EXPECT(m->capacity == capacity, "reserve must never shrink");
+    hash_map_reserve(m, 100000);
+    int ok = m->capacity > capacity;
+    for (int i = 0; i < 10000; ++i) ok &= hash_map_get(m, &i, sizeof i) != NULL;
+    HM_EXPECT(ok, "Growing reserve must keep every entry");
+    hash_map_destroy(m, NULL);
+}
+
+static void test_bulk_load_matches_puts(void) {
+    enum { N = 20000 };
+    static char storage[N][40];
+    static const void* keys[N];
+    static size_t key_sizes[N];
+    static const void* values[N];
+
+    for (int i = 0; i < N; ++i) {  /* short (inline) and long (spilled) keys */
+        int len = snprintf(storage[i], sizeof storage[i], (i & 1) ? "k%d" : "a-rather-long-bulk-key-%d", i);
+        keys[i] = storage[i];
+        key_sizes[i] = (size_t)len;
+        values[i] = malloc(sizeof(int));
+    }
+
+    /* pre-existing entries and tombstones must not confuse the unique path */
+    HashMap* m = build_hash_map();
+    for (int i = 0; i < 300; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 7, NULL);
+    for (int i = 0; i < 300; i += 2) (void)hash_map_remove(m, &i, sizeof i, NULL);
+
+    g_data_free_count = 0;
+    HM_EXPECT(hash_map_bulk_load(m, keys, key_sizes, values, NULL, N, 1, data_free_counter) == 0,
+              "Unique bulk load reports no updates");
+    int ok = m->size == N + 150;
+    for (int i = 0; i < N; ++i) {
+        const HashMapItem* it = hash_map_get(m, keys[i], key_sizes[i]);
+        if (it == NULL || it->data != values[i] || it->data_size != 0) ok = 0;
+    }
+    for (int i = 1; i < 300; i += 2) ok &= hash_map_get(m, &i, sizeof i) != NULL;
+    HM_EXPECT(ok, "Bulk-loaded and earlier entries must all be found");
+    HM_EXPECT(m->size + m->tombstones <= m->capacity / 8 * 7, "Load limit must hold after a bulk load");
+
+    /* checked mode: duplicates update in order */
+    size_t sizes[3] = { 1, 2, 3 };
+    const void* dup_keys[3] = { "k1", "new", "k1" };
+    size_t dup_key_sizes[3] = { 2, 3, 2 };
+    HM_EXPECT(hash_map_bulk_load(m, dup_keys, dup_key_sizes, NULL, sizes, 3, 0, data_free_counter) == 2,
+              "Checked bulk load must count updated keys");
+    HM_EXPECT(hash_map_get(m, "k1", 2)->data_size == 3 && hash_map_get(m, "new", 3) != NULL && g_data_free_count == 1,
+              "Later duplicates must win and replaced owned values be freed");
 
     hash_map_destroy(m, data_free_counter);
+    HM_EXPECT(g_data_free_count == N, "Destroy must free every bulk-loaded owned value");
 }
 
+/* 1M u64 keys: individual puts vs reserved puts vs unique bulk load. */
+static void test_bulk_load_perf(void) {
+    enum { N = 1000000 };
+    uint64_t* ids = malloc((size_t)N * sizeof(uint64_t));
+    const void** keys = malloc((size_t)N * sizeof(void*));
+    size_t* key_sizes = malloc((size_t)N * sizeof(size_t));
+    if (ids == NULL || keys == NULL || key_sizes == NULL) {
+        free(ids); free(keys); free(key_sizes);
+        return;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        ids[i] = i * 0x9E3779B97F4A7C15ULL;
+        keys[i] = &ids[i];
+        key_sizes[i] = sizeof(uint64_t);
+    }
 
+    double t0 = hm_now_ms();
+    HashMap* plain = build_hash_map();
+    for (size_t i = 0; i < N; ++i) (void)hash_map_put(plain, keys[i], key_sizes[i], NULL, 0, NULL);
+    double t1 = hm_now_ms();
+    HashMap* reserved = build_hash_map_with_capacity(N);
+    for (size_t i = 0; i < N; ++i) (void)hash_map_put(reserved, keys[i], key_sizes[i], NULL, 0, NULL);
+    double t2 = hm_now_ms();
+    HashMap* bulk = build_hash_map();
+    (void)hash_map_bulk_load(bulk, keys, key_sizes, NULL, NULL, N, 1, NULL);
+    double t3 = hm_now_ms();
+
+    size_t hits = 0;
+    for (size_t i = 0; i < N; i += 97) hits += hash_map_get(bulk, keys[i], key_sizes[i]) != NULL;
+    HM_EXPECT(plain->size == N && reserved->size == N && bulk->size == N && hits == (N + 96) / 97,
+              "All three loads must hold every key");
+    printf("  timings: load %d keys: puts=%.3f ms, reserved puts=%.3f ms, bulk_load(unique)=%.3f ms\n",
+           N, t1 - t0, t2 - t1, t3 - t2);
+
+    hash_map_destroy(plain, NULL);
+    hash_map_destroy(reserved, NULL);
+    hash_map_destroy(bulk, NULL);
+    free(ids); free(keys); free(key_sizes);
+}
 
 static void test_get_missing_returns_null(void) {
     HashMap* m = build_hash_map();
@@ -274,12 +1106,32 @@ void run_all_hashmap_tests(void) {
     hm_passed = hm_failed = 0;
     printf("[TEST] testing hashmap...\n");
 
-    test_build_map_buckets_initialized();
+    test_build_map_table_initialized();
     test_put_get_without_data_ownership();
     test_put_updates_and_frees_old_value_when_owned();
     test_key_is_deep_copied();
-    test_remove_head_singleton_and_multinode();
-    test_remove_non_head();
+    test_remove_singleton_and_chain_head();
+    test_remove_middle_of_chain();
+    test_tombstone_keeps_full_group_reachable();
+    test_growth_keeps_all_entries();
+    test_incremental_rehash_is_bounded();
+    test_small_keys_are_stored_inline();
+    test_batch_ops_match_single_ops();
+    test_batch_get_perf();
+    test_prehashed_ops_interoperate();
+    test_iteration_visits_every_entry_once();
+    test_iteration_covers_both_tables_while_rehashing();
+    test_cursor_scans_in_slices();
+    test_stats_track_entries_and_bytes();
+    test_arena_map_recycles_keys();
+    test_arena_destroy_perf();
+    test_hash_kinds_are_interchangeable();
+    test_hash_kinds_perf();
+    test_get_or_insert_and_upsert_with();
+    test_get_or_insert_perf();
+    test_reserve_prevents_rehash();
+    test_bulk_load_matches_puts();
+    test_bulk_load_perf();
     test_get_missing_returns_null();
 
     if (hm_failed == 0) {
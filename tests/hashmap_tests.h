@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <time.h>      /* timespec_get, struct timespec */
 
 /* Entry point for HashMap tests. Prints a summary and does not exit. */
 void run_all_hashmap_tests(void);
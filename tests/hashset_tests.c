@@ -0,0 +1,247 @@
+#include "hashset_tests.h"
+
+static int hs_passed = 0;
+static int hs_failed = 0;
+
+#define HS_EXPECT(cond, msg)                                                   \
+    do {                                                                       \
+        if ((cond)) {                                                          \
+            hs_passed++;                                                       \
+        } else {                                                               \
+            hs_failed++;                                                       \
+            fprintf(stderr, "[HS FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                      \
+    } while (0)
+
+/* -------- Helpers -------- */
+
+static double hs_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* --- stderr silencer (test-only) --- */
+static int hs_saved_stderr_fd = -1;
+
+static void hs_silence_stderr_begin(void) {
+    fflush(stderr);
+    hs_saved_stderr_fd = hs_dup(hs_fileno(stderr));
+    if (hs_saved_stderr_fd < 0) return;
+
+    int devnull = hs_open(HS_DEV_NULL, HS_O_WRONLY);
+    if (devnull >= 0) {
+        hs_dup2(devnull, hs_fileno(stderr));
+        hs_close(devnull);
+    }
+}
+
+static void hs_silence_stderr_end(void) {
+    if (hs_saved_stderr_fd >= 0) {
+        fflush(stderr);
+        hs_dup2(hs_saved_stderr_fd, hs_fileno(stderr));
+        hs_close(hs_saved_stderr_fd);
+        hs_saved_stderr_fd = -1;
+    }
+}
+
+static void hs_count_visit(const HashSetEntry* entry, void* ctx) {
+    (void)entry;
+    (*(size_t*)ctx)++;
+}
+
+/* Every entry of 'set' is a uint32_t; returns 1 if all of them satisfy pred(value, arg). */
+static int hs_all_u32(const HashSet* set, int (*pred)(uint32_t value, uint32_t arg), uint32_t arg) {
+    HashSetIterator it;
+    hash_set_iterator_init(&it, set);
+    for (const HashSetEntry* e = hash_set_iterator_next(&it); e != NULL; e = hash_set_iterator_next(&it)) {
+        uint32_t v;
+        if (e->key_size != sizeof v) return 0;
+        memcpy(&v, e->key, sizeof v);
+        if (!pred(v, arg)) return 0;
+    }
+    return 1;
+}
+
+static int hs_is_multiple_of(uint32_t value, uint32_t arg) { return value % arg == 0; }
+static int hs_is_below(uint32_t value, uint32_t arg)       { return value < arg; }
+
+/* -------- Individual tests -------- */
+
+static void test_hash_set_basics(void) {
+    HashSet* s = build_hash_set();
+
+    HS_EXPECT(hash_set_insert(s, "apple", 5) == 1, "First insert must add the key");
+    HS_EXPECT(hash_set_insert(s, "apple", 5) == 0, "Second insert must report the key as present");
+    HS_EXPECT(hash_set_insert(s, "apple", 4) == 1, "A prefix is a different key");
+    HS_EXPECT(hash_set_insert(s, "", 0) == 1, "The empty key must be insertable");
+    HS_EXPECT(s->size == 3, "Size must count distinct keys");
+
+    HS_EXPECT(hash_set_contains(s, "apple", 5) && hash_set_contains(s, "appl", 4), "Inserted keys must be found");
+    HS_EXPECT(hash_set_contains(s, "", 0), "The empty key must be found");
+    HS_EXPECT(!hash_set_contains(s, "pear", 4), "Missing key must not be found");
+
+    /* keys longer than the inline buffer get a heap copy owned by the set */
+    char long_key[64];
+    memset(long_key, 'x', sizeof long_key);
+    HS_EXPECT(hash_set_insert(s, long_key, sizeof long_key) == 1, "Long key must insert");
+    long_key[0] = 'y';
+    HS_EXPECT(!hash_set_contains(s, long_key, sizeof long_key), "The set must keep its own copy of the key");
+    long_key[0] = 'x';
+    HS_EXPECT(hash_set_contains(s, long_key, sizeof long_key), "Long key must be found");
+
+    HS_EXPECT(hash_set_remove(s, "apple", 5) == 1, "Remove must find the key");
+    HS_EXPECT(hash_set_remove(s, "apple", 5) == 0, "Second remove must report not found");
+    HS_EXPECT(hash_set_remove(s, long_key, sizeof long_key) == 1, "Long key must be removable");
+    HS_EXPECT(s->size == 2 && !hash_set_contains(s, "apple", 5), "Removed keys must be gone");
+
+    HS_EXPECT(sizeof(HashSetEntry) < sizeof(HashMapItem), "Set slots must be smaller than map slots");
+
+    hash_set_destroy(s);
+
+    HS_EXPECT(!hash_set_contains(NULL, "a", 1) && hash_set_remove(NULL, "a", 1) == 0, "NULL set must be empty");
+    hs_silence_stderr_begin();
+    hash_set_destroy(NULL);  /* documented no-op */
+    hs_silence_stderr_end();
+}
+
+/* Random churn checked against a plain presence array. */
+static void test_hash_set_churn_matches_reference(void) {
+    enum { KEYS = 4096, OPS = 200000 };
+    static unsigned char expected[KEYS];
+    memset(expected, 0, sizeof expected);
+
+    HashSet* s = build_hash_set_with_hash(HASH_MAP_HASH_FAST64, hash_map_random_seed());
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    size_t live = 0;
+    int ok = 1;
+
+    for (int op = 0; op < OPS; ++op) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        size_t k = (size_t)(rng % KEYS);
+        char key[32];
+        /* mix inline (<= 16 byte) and heap keys */
+        int len = snprintf(key, sizeof key, (k & 1) ? "key-%zu" : "a-much-longer-key-%zu", k);
+
+        if ((rng >> 32) % 3 == 0) {
+            int removed = hash_set_remove(s, key, (size_t)len);
+            if (removed != expected[k]) ok = 0;
+            if (removed) live--;
+            expected[k] = 0;
+        } else {
+            int added = hash_set_insert(s, key, (size_t)len);
+            if (added == expected[k]) ok = 0;
+            if (added) live++;
+            expected[k] = 1;
+        }
+    }
+    for (size_t k = 0; k < KEYS; ++k) {
+        char key[32];
+        int len = snprintf(key, sizeof key, (k & 1) ? "key-%zu" : "a-much-longer-key-%zu", k);
+        if (hash_set_contains(s, key, (size_t)len) != expected[k]) ok = 0;
+    }
+    HS_EXPECT(ok && s->size == live, "Set must agree with the reference after churn");
+    HS_EXPECT(s->size + s->tombstones <= s->capacity / 8 * 7, "Load limit must hold");
+
+    size_t visited = 0;
+    hash_set_for_each(s, hs_count_visit, &visited);
+    HS_EXPECT(visited == live, "for_each must visit every live key once");
+
+    visited = 0;
+    HashSetIterator it;
+    hash_set_iterator_init(&it, s);
+    while (hash_set_iterator_next(&it) != NULL) visited++;
+    HS_EXPECT(visited == live && hash_set_iterator_next(&it) == NULL, "Iterator must visit every live key, then stop");
+
+    hash_set_destroy(s);
+}
+
+/* Multiples of 2 and of 3 below N; also with operands hashing differently. */
+static void test_hash_set_union_intersection(void) {
+    enum { N = 30000 };
+    HashSet* twos   = build_hash_set();
+    HashSet* threes = build_hash_set();
+    HashSet* other  = build_hash_set_with_hash(HASH_MAP_HASH_INT64, 12345);  /* same keys as 'threes' */
+
+    for (uint32_t i = 0; i < N; i += 2) (void)hash_set_insert(twos, &i, sizeof i);
+    for (uint32_t i = 0; i < N; i += 3) {
+        (void)hash_set_insert(threes, &i, sizeof i);
+        (void)hash_set_insert(other, &i, sizeof i);
+    }
+
+    HashSet* u = hash_set_union(twos, threes);
+    HashSet* x = hash_set_intersection(twos, threes);
+    size_t expected_union = (N + 1) / 2 + (N + 2) / 3 - (N + 5) / 6;
+    HS_EXPECT(u->size == expected_union && hs_all_u32(u, hs_is_below, N), "Union must hold every key of both");
+    HS_EXPECT(x->size == (N + 5) / 6 && hs_all_u32(x, hs_is_multiple_of, 6), "Intersection must hold the common keys");
+    HS_EXPECT(twos->size == (N + 1) / 2 && threes->size == (N + 2) / 3, "Operands must be left untouched");
+
+    HashSet* u2 = hash_set_union(twos, other);
+    HashSet* x2 = hash_set_intersection(other, twos);
+    HS_EXPECT(u2->size == expected_union && u2->hash_kind == twos->hash_kind, "Mixed-hash union must match");
+    HS_EXPECT(x2->size == (N + 5) / 6 && x2->hash_kind == HASH_MAP_HASH_INT64 && x2->hash_seed == 12345,
+              "Mixed-hash intersection must match and hash like its first operand");
+    uint32_t probe = 6;
+    HS_EXPECT(hash_set_contains(x2, &probe, sizeof probe) && hash_set_contains(u2, &probe, sizeof probe),
+              "Result sets must be searchable with their own hash");
+
+    HashSet* empty = build_hash_set();
+    HashSet* x3 = hash_set_intersection(empty, threes);
+    HashSet* u3 = hash_set_union(empty, threes);
+    HS_EXPECT(x3->size == 0 && u3->size == threes->size, "Empty operand must behave as the empty set");
+
+    hash_set_destroy(twos);
+    hash_set_destroy(threes);
+    hash_set_destroy(other);
+    hash_set_destroy(u);
+    hash_set_destroy(x);
+    hash_set_destroy(u2);
+    hash_set_destroy(x2);
+    hash_set_destroy(empty);
+    hash_set_destroy(x3);
+    hash_set_destroy(u3);
+}
+
+/* Insert + contains of 8-byte ids: HashSet vs HashMap used as a set (NULL values). */
+static void test_hash_set_vs_hash_map_perf(void) {
+    enum { N = 200000 };
+
+    double t0 = hs_now_ms();
+    HashSet* s = build_hash_set();
+    for (uint64_t i = 0; i < N; ++i) (void)hash_set_insert(s, &i, sizeof i);
+    size_t hits = 0;
+    for (uint64_t i = 0; i < N; ++i) hits += (size_t)hash_set_contains(s, &i, sizeof i);
+    double t1 = hs_now_ms();
+
+    HashMap* m = build_hash_map();
+    for (uint64_t i = 0; i < N; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    for (uint64_t i = 0; i < N; ++i) hits += hash_map_get(m, &i, sizeof i) != NULL;
+    double t2 = hs_now_ms();
+
+    HS_EXPECT(hits == 2 * (size_t)N, "Every id must be found in both containers");
+    printf("  timings: %d ids insert+contains: HashSet=%.3f ms, HashMap=%.3f ms; "
+           "table bytes %zu vs %zu\n",
+           N, t1 - t0, t2 - t1,
+           s->capacity * (sizeof(HashSetEntry) + 1), m->capacity * (sizeof(HashMapItem) + 1));
+
+    hash_set_destroy(s);
+    hash_map_destroy(m, NULL);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_hashset_tests(void) {
+    hs_passed = hs_failed = 0;
+    printf("[TEST] testing hashset...\n");
+
+    test_hash_set_basics();
+    test_hash_set_churn_matches_reference();
+    test_hash_set_union_intersection();
+    test_hash_set_vs_hash_map_perf();
+
+    if (hs_failed == 0) {
+        printf("[TEST OK]  hashset: passed=%d failed=%d\n", hs_passed, hs_failed);
+    } else {
+        printf("[TEST FAIL] hashset: passed=%d failed=%d\n", hs_passed, hs_failed);
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef HASHSET_TESTS_H
+#define HASHSET_TESTS_H
+
+#include "../hashset/hashset.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>      /* timespec_get, struct timespec */
+
+/* --- stderr silencer platform shims (same pattern as the BST tests) --- */
+#if defined(_WIN32)
+  #include <io.h>
+  #include <fcntl.h>
+  #define HS_DEV_NULL  "NUL"
+  #define hs_dup       _dup
+  #define hs_dup2      _dup2
+  #define hs_open      _open
+  #define hs_close     _close
+  #define hs_fileno    _fileno
+  #define HS_O_WRONLY  _O_WRONLY
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #define HS_DEV_NULL  "/dev/null"
+  #define hs_dup       dup
+  #define hs_dup2      dup2
+  #define hs_open      open
+  #define hs_close     close
+  #define hs_fileno    fileno
+  #define HS_O_WRONLY  O_WRONLY
+#endif
+
+/* Entry point for HashSet tests. */
+void run_all_hashset_tests(void);
+
+#endif /* HASHSET_TESTS_H */
@@ -0,0 +1,268 @@
+#include "lru_cache_tests.h"
+
+static int lru_passed = 0;
+static int lru_failed = 0;
+
+#define LRU_EXPECT(cond, msg)                                                   \
+    do {                                                                        \
+        if ((cond)) {                                                           \
+            lru_passed++;                                                       \
+        } else {                                                                \
+            lru_failed++;                                                       \
+            fprintf(stderr, "[LRU FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                       \
+    } while (0)
+
+/* -------- Helpers -------- */
+
+static double lru_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* --- stderr silencer (test-only) --- */
+static int lru_saved_stderr_fd = -1;
+
+static void lru_silence_stderr_begin(void) {
+    fflush(stderr);
+    lru_saved_stderr_fd = lru_dup(lru_fileno(stderr));
+    if (lru_saved_stderr_fd < 0) return;
+
+    int devnull = lru_open(LRU_DEV_NULL, LRU_O_WRONLY);
+    if (devnull >= 0) {
+        lru_dup2(devnull, lru_fileno(stderr));
+        lru_close(devnull);
+    }
+}
+
+static void lru_silence_stderr_end(void) {
+    if (lru_saved_stderr_fd >= 0) {
+        fflush(stderr);
+        lru_dup2(lru_saved_stderr_fd, lru_fileno(stderr));
+        lru_close(lru_saved_stderr_fd);
+        lru_saved_stderr_fd = -1;
+    }
+}
+
+static int lru_free_count = 0;
+static void lru_free_counter(void* p) {
+    if (p != NULL) {
+        free(p);
+        lru_free_count++;
+    }
+}
+
+static int* lru_int(int v) {
+    int* p = malloc(sizeof(int));
+    *p = v;
+    return p;
+}
+
+/* -------- Individual tests -------- */
+
+static void test_lru_entry_bound_evicts_least_recent(void) {
+    LruCache* c = build_lru_cache(3, 0, lru_free_counter);
+    lru_free_count = 0;
+
+    LRU_EXPECT(lru_cache_put(c, "a", 1, lru_int(1), sizeof(int)) == 0, "First put must insert");
+    (void)lru_cache_put(c, "b", 1, lru_int(2), sizeof(int));
+    (void)lru_cache_put(c, "c", 1, lru_int(3), sizeof(int));
+    LRU_EXPECT(lru_cache_get(c, "a", 1) != NULL, "a must be cached");   /* order now a, c, b */
+
+    (void)lru_cache_put(c, "d", 1, lru_int(4), sizeof(int));
+    LRU_EXPECT(c->size == 3 && c->evictions == 1 && lru_free_count == 1, "Fourth key must evict exactly one entry");
+    LRU_EXPECT(lru_cache_peek(c, "b", 1) == NULL, "The least recently used key must be the one evicted");
+    LRU_EXPECT(lru_cache_peek(c, "a", 1) != NULL && lru_cache_peek(c, "c", 1) != NULL, "Recent keys must survive");
+
+    /* peek does not touch: c stays least recent */
+    (void)lru_cache_peek(c, "c", 1);
+    (void)lru_cache_put(c, "e", 1, lru_int(5), sizeof(int));
+    LRU_EXPECT(lru_cache_peek(c, "c", 1) == NULL, "peek must not refresh recency");
+
+    LRU_EXPECT(lru_cache_put(c, "a", 1, lru_int(10), sizeof(int)) == 1, "Put on a cached key must update");
+    LRU_EXPECT(lru_free_count == 3, "Update must free the replaced value");
+    const LruCacheEntry* e = lru_cache_get(c, "a", 1);
+    LRU_EXPECT(e != NULL && *(int*)e->data == 10 && e->key_size == 1 && e->key[0] == 'a', "Get must see the update");
+
+    LRU_EXPECT(lru_cache_remove(c, "a", 1) == 1 && lru_cache_remove(c, "a", 1) == 0, "Remove must find the key once");
+    LRU_EXPECT(c->size == 2 && c->evictions == 2 && lru_free_count == 4, "Remove frees but is not an eviction");
+
+    lru_cache_destroy(c);
+    LRU_EXPECT(lru_free_count == 6, "Destroy must free every owned value");
+
+    lru_silence_stderr_begin();
+    lru_cache_destroy(NULL);  /* documented no-op */
+    lru_silence_stderr_end();
+}
+
+static void test_lru_byte_bound(void) {
+    LruCache* c = build_lru_cache(0, 100, NULL);  /* data not owned */
+    char key[8];
+
+    for (int i = 0; i < 10; ++i) {
+        int len = snprintf(key, sizeof key, "k%d", i);
+        (void)lru_cache_put(c, key, (size_t)len, NULL, 30);  /* charge: 2 + 30 */
+    }
+    LRU_EXPECT(c->bytes <= 100 && c->size == 3 && c->bytes == 96, "Byte bound must hold (3 entries of 32 bytes)");
+    LRU_EXPECT(lru_cache_peek(c, "k9", 2) != NULL && lru_cache_peek(c, "k6", 2) == NULL, "Newest entries must stay");
+
+    /* growing a value through an update evicts others, not itself */
+    (void)lru_cache_put(c, "k8", 2, NULL, 60);
+    LRU_EXPECT(c->size == 2 && c->bytes == 94 && lru_cache_peek(c, "k7", 2) == NULL, "Update must evict older entries");
+
+    /* an entry larger than the whole budget is kept alone */
+    (void)lru_cache_put(c, "big", 3, NULL, 500);
+    LRU_EXPECT(c->size == 1 && lru_cache_peek(c, "big", 3) != NULL, "Oversized entry must be kept alone");
+    (void)lru_cache_put(c, "k0", 2, NULL, 1);
+    LRU_EXPECT(c->size == 1 && c->bytes == 3, "The next put must evict the oversized entry");
+
+    lru_cache_destroy(c);
+}
+
+/* Long keys are stored once (the entry points at the map's copy) and survive map growth. */
+static void test_lru_long_keys_stored_once(void) {
+    LruCache* c = build_lru_cache(200, 0, NULL);
+    char key[64];
+
+    for (int i = 0; i < 500; ++i) {  /* grows the map several times, evicts 300 */
+        int len = snprintf(key, sizeof key, "a-key-well-past-the-inline-limit-%d", i);
+        (void)lru_cache_put(c, key, (size_t)len, NULL, 0);
+    }
+
+    int shared = 1, intact = 1;
+    for (int i = 300; i < 500; ++i) {
+        int len = snprintf(key, sizeof key, "a-key-well-past-the-inline-limit-%d", i);
+        const LruCacheEntry* e = lru_cache_peek(c, key, (size_t)len);
+        const HashMapItem* item = hash_map_get(c->map, key, (size_t)len);
+        if (e == NULL || item == NULL || (const void*)e->key != item->key) shared = 0;
+        if (e == NULL || e->key_size != (size_t)len || memcmp(e->key, key, (size_t)len) != 0) intact = 0;
+    }
+    LRU_EXPECT(c->size == 200 && c->bytes == 200 * strlen("a-key-well-past-the-inline-limit-300"),
+               "Charge must be key_size + data_size per entry");
+    LRU_EXPECT(shared, "A long key must be stored once, in the map");
+    LRU_EXPECT(intact, "Entry keys must stay readable after the map grew");
+
+    const LruCacheEntry* small = NULL;
+    (void)lru_cache_put(c, "tiny", 4, NULL, 0);
+    small = lru_cache_peek(c, "tiny", 4);
+    LRU_EXPECT(small != NULL && small->key == small->inline_key, "Short keys live in the entry");
+
+    lru_cache_destroy(c);
+}
+
+/* Random gets/puts checked against a timestamp-based reference LRU. */
+static void test_lru_matches_reference(void) {
+    enum { KEYS = 512, CAP = 64, OPS = 50000 };
+    static size_t stamp[KEYS];         /* last use; 0 = not cached */
+    memset(stamp, 0, sizeof stamp);
+
+    LruCache* c = build_lru_cache(CAP, 0, NULL);
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    size_t cached = 0, hits = 0, gets = 0;
+    int ok = 1;
+
+    for (size_t op = 1; op <= OPS; ++op) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        uint32_t k = (uint32_t)((rng % KEYS) * (rng % KEYS) / KEYS);  /* skewed towards small keys */
+
+        if ((rng >> 40) % 4 != 0) {
+            gets++;
+            const LruCacheEntry* e = lru_cache_get(c, &k, sizeof k);
+            if ((e != NULL) != (stamp[k] != 0)) ok = 0;
+            if (e != NULL) { hits++; stamp[k] = op; }
+        } else {
+            if (stamp[k] == 0 && cached == CAP) {
+                size_t victim = 0;
+                for (size_t i = 0; i < KEYS; ++i) {
+                    if (stamp[i] != 0 && (stamp[victim] == 0 || stamp[i] < stamp[victim])) victim = i;
+                }
+                stamp[victim] = 0;
+                cached--;
+            }
+            if (stamp[k] == 0) cached++;
+            (void)lru_cache_put(c, &k, sizeof k, NULL, k);
+            stamp[k] = op;
+        }
+    }
+    for (uint32_t k = 0; k < KEYS; ++k) {
+        const LruCacheEntry* e = lru_cache_peek(c, &k, sizeof k);
+        if ((e != NULL) != (stamp[k] != 0)) ok = 0;
+        if (e != NULL && e->data_size != k) ok = 0;
+    }
+    LRU_EXPECT(ok && c->size == cached, "Cache must evict exactly like the reference LRU");
+    LRU_EXPECT(c->hits == hits && c->misses == gets - hits, "Hit / miss counters must match");
+    LRU_EXPECT(lru_cache_hit_ratio(c) > 0.0 && lru_cache_hit_ratio(c) < 1.0, "Hit ratio must be a fraction");
+
+    lru_cache_destroy(c);
+}
+
+/*
+ * Recency touches on a full cache: LruCache vs HashMap + LinkedList, where a
+ * touch walks the list to the node and moves it to the front.
+ */
+static void test_lru_vs_linked_list_perf(void) {
+    enum { CAP = 2048, GETS = 100000 };
+    static int values[CAP];
+    uint64_t rng = 0xD1B54A32D192ED03ULL;
+
+    LruCache* c = build_lru_cache(CAP, 0, NULL);
+    HashMap* m = build_hash_map();
+    LinkedList list = build_empty_linked_list();
+    for (int i = 0; i < CAP; ++i) {
+        values[i] = i;
+        (void)lru_cache_put(c, &i, sizeof i, &values[i], sizeof(int));
+        (void)hash_map_put(m, &i, sizeof i, &values[i], sizeof(int), NULL);
+        linked_list_push_front(list, &values[i]);
+    }
+
+    size_t hits = 0;
+    double t0 = lru_now_ms();
+    for (int g = 0; g < GETS; ++g) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        int k = (int)(rng % CAP);
+        hits += lru_cache_get(c, &k, sizeof k) != NULL;
+    }
+    double t1 = lru_now_ms();
+    for (int g = 0; g < GETS; ++g) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        int k = (int)(rng % CAP);
+        const HashMapItem* item = hash_map_get(m, &k, sizeof k);
+        if (item == NULL) continue;
+        hits++;
+        if (list->data == item->data) continue;
+        LinkedListNode* prev = list;
+        while (prev->next != NULL && prev->next->data != item->data) prev = prev->next;
+        linked_list_remove_next_node(prev);
+        linked_list_push_front(list, item->data);
+    }
+    double t2 = lru_now_ms();
+
+    LRU_EXPECT(hits == 2 * (size_t)GETS, "Every get must hit in both caches");
+    printf("  timings: %d touches on %d entries: LruCache=%.3f ms, HashMap+LinkedList walk=%.3f ms\n",
+           GETS, CAP, t1 - t0, t2 - t1);
+
+    lru_cache_destroy(c);
+    hash_map_destroy(m, NULL);
+    while (!is_linked_list_empty(list) && list->next != NULL) linked_list_remove_next_node(list);
+    free(list);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_lru_cache_tests(void) {
+    lru_passed = lru_failed = 0;
+    printf("[TEST] testing lru cache...\n");
+
+    test_lru_entry_bound_evicts_least_recent();
+    test_lru_byte_bound();
+    test_lru_long_keys_stored_once();
+    test_lru_matches_reference();
+    test_lru_vs_linked_list_perf();
+
+    if (lru_failed == 0) {
+        printf("[TEST OK]  lru cache: passed=%d failed=%d\n", lru_passed, lru_failed);
+    } else {
+        printf("[TEST FAIL] lru cache: passed=%d failed=%d\n", lru_passed, lru_failed);
+    }
+}
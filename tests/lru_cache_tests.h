@@ -0,0 +1,38 @@
+#ifndef LRU_CACHE_TESTS_H
+#define LRU_CACHE_TESTS_H
+
+#include "../cache/lru_cache.h"
+#include "../linked_list/linked_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>      /* timespec_get, struct timespec */
+
+/* --- stderr silencer platform shims (same pattern as the BST tests) --- */
+#if defined(_WIN32)
+  #include <io.h>
+  #include <fcntl.h>
+  #define LRU_DEV_NULL  "NUL"
+  #define lru_dup       _dup
+  #define lru_dup2      _dup2
+  #define lru_open      _open
+  #define lru_close     _close
+  #define lru_fileno    _fileno
+  #define LRU_O_WRONLY  _O_WRONLY
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #define LRU_DEV_NULL  "/dev/null"
+  #define lru_dup       dup
+  #define lru_dup2      dup2
+  #define lru_open      open
+  #define lru_close     close
+  #define lru_fileno    fileno
+  #define LRU_O_WRONLY  O_WRONLY
+#endif
+
+/* Entry point for LruCache tests. */
+void run_all_lru_cache_tests(void);
+
+#endif /* LRU_CACHE_TESTS_H */
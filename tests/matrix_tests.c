@@ -692,6 +692,602 @@ static void test_large_rectangular_perf(void) {
     destroy_matrix(B);
 }
 
+/* ============================ TYPED KERNELS ============================ */
+/* User-side copies of the built-in arithmetic: passed through the _ops entry
+ * points they force the generic (function-pointer) path, which serves as the
+ * reference for the type-specialized kernels. */
+
+static void user_f64_zero(void *dst) { *(double*)dst = 0.0; }
+static void user_f64_muladd(void *acc, const void *a, const void *b) {
+    *(double*)acc += (*(const double*)a) * (*(const double*)b);
+}
+static const MatrixOps USER_F64_OPS = { sizeof(double), user_f64_zero, user_f64_muladd };
+
+static void user_i64_zero(void *dst) { *(int64_t*)dst = 0; }
+static void user_i64_muladd(void *acc, const void *a, const void *b) {
+    *(int64_t*)acc += (*(const int64_t*)a) * (*(const int64_t*)b);
+}
+static const MatrixOps USER_I64_OPS = { sizeof(int64_t), user_i64_zero, user_i64_muladd };
+
+static int same_bytes(const Matrix *X, const Matrix *Y) {
+    return X && Y && X->rows == Y->rows && X->cols == Y->cols &&
+           X->size_of_element == Y->size_of_element &&
+           memcmp(X->data, Y->data, X->rows * X->cols * X->size_of_element) == 0;
+}
+
+static int all_nearly_equal_f64(const Matrix *X, const Matrix *Y, double tol) {
+    if (!X || !Y || X->rows != Y->rows || X->cols != Y->cols) return 0;
+    const double *x = (const double*)X->data, *y = (const double*)Y->data;
+    for (size_t i = 0; i < X->rows * X->cols; ++i) {
+        if (!nearly_equal(x[i], y[i], tol)) return 0;
+    }
+    return 1;
+}
+
+/* ----- f32 / i32 wrappers on a small exact case ----- */
+static void test_typed_f32_i32_wrappers(void) {
+    START_TEST("typed wrappers: f32 and i32");
+
+    const float  Af[6] = {1,2,3, 4,5,6};            /* 2x3 */
+    const float  Bf[6] = {7,8, 9,10, 11,12};        /* 3x2 */
+    const int32_t Ai[6] = {1,-2,3, -4,5,-6};
+    const int32_t Bi[6] = {7,8, -9,10, 11,-12};
+    const float   Cf_ref[4] = {58,64, 139,154};
+    const int32_t Ci_ref[4] = {58,-48, -139,90};
+
+    Matrix *MAf = new_matrix(2,3,sizeof(float)),   *MBf = new_matrix(3,2,sizeof(float));
+    Matrix *MAi = new_matrix(2,3,sizeof(int32_t)), *MBi = new_matrix(3,2,sizeof(int32_t));
+    memcpy(MAf->data, Af, sizeof Af); memcpy(MBf->data, Bf, sizeof Bf);
+    memcpy(MAi->data, Ai, sizeof Ai); memcpy(MBi->data, Bi, sizeof Bi);
+
+    Matrix *Cfn = matrix_multiply_f32_naive(MAf, MBf), *Cfb = matrix_multiply_f32_blocked(MAf, MBf, 2);
+    Matrix *Cin = matrix_multiply_i32_naive(MAi, MBi), *Cib = matrix_multiply_i32_blocked(MAi, MBi, 2);
+    MAT_EXPECT(Cfn && memcmp(Cfn->data, Cf_ref, sizeof Cf_ref) == 0, "f32 naive exact");
+    MAT_EXPECT(Cfb && memcmp(Cfb->data, Cf_ref, sizeof Cf_ref) == 0, "f32 blocked exact");
+    MAT_EXPECT(Cin && memcmp(Cin->data, Ci_ref, sizeof Ci_ref) == 0, "i32 naive exact");
+    MAT_EXPECT(Cib && memcmp(Cib->data, Ci_ref, sizeof Ci_ref) == 0, "i32 blocked exact");
+
+    destroy_matrix(Cfn); destroy_matrix(Cfb); destroy_matrix(Cin); destroy_matrix(Cib);
+    destroy_matrix(MAf); destroy_matrix(MBf); destroy_matrix(MAi); destroy_matrix(MBi);
+}
+
+/* ----- Typed kernels vs generic ops path on odd shapes (tails, partial tiles) ----- */
+static void test_typed_kernels_match_generic_ops(void) {
+    START_TEST("typed kernels vs generic ops path");
+
+    const size_t M = 37, P = 29, N = 41;
+    Matrix *Ad = new_matrix(M, P, sizeof(double)),  *Bd = new_matrix(P, N, sizeof(double));
+    Matrix *Ai = new_matrix(M, P, sizeof(int64_t)), *Bi = new_matrix(P, N, sizeof(int64_t));
+    fill_random_f64_seed(Ad, 0x5EED0001u);
+    fill_random_f64_seed(Bd, 0x5EED0002u);
+    uint64_t st = 0x5EED0003u;
+    for (size_t i = 0; i < M * P; ++i) ((int64_t*)Ai->data)[i] = (int64_t)(mm_xorshift64s(&st) % 2001) - 1000;
+    for (size_t i = 0; i < P * N; ++i) ((int64_t*)Bi->data)[i] = (int64_t)(mm_xorshift64s(&st) % 2001) - 1000;
+
+    Matrix *Rd = matrix_multiply_naive_ops(Ad, Bd, &USER_F64_OPS);
+    Matrix *Ri = matrix_multiply_naive_ops(Ai, Bi, &USER_I64_OPS);
+    Matrix *Rib = matrix_multiply_blocked_ops(Ai, Bi, &USER_I64_OPS, 8);
+
+    Matrix *Tdn = matrix_multiply_f64_naive(Ad, Bd), *Tdb = matrix_multiply_f64_blocked(Ad, Bd, 8);
+    Matrix *Tin = matrix_multiply_i64_naive(Ai, Bi), *Tib = matrix_multiply_i64_blocked(Ai, Bi, 8);
+
+    MAT_EXPECT(all_nearly_equal_f64(Tdn, Rd, 1e-12), "f64 typed naive must match the ops path");
+    MAT_EXPECT(all_nearly_equal_f64(Tdb, Rd, 1e-12), "f64 typed blocked must match the ops path");
+    MAT_EXPECT(same_bytes(Tin, Ri), "i64 typed naive must match the ops path exactly");
+    MAT_EXPECT(same_bytes(Tib, Ri) && same_bytes(Rib, Ri), "i64 typed/generic blocked must match exactly");
+
+    destroy_matrix(Rd); destroy_matrix(Ri); destroy_matrix(Rib);
+    destroy_matrix(Tdn); destroy_matrix(Tdb); destroy_matrix(Tin); destroy_matrix(Tib);
+    destroy_matrix(Ad); destroy_matrix(Bd); destroy_matrix(Ai); destroy_matrix(Bi);
+}
+
+/* ----- Perf: typed kernel vs one muladd call per element ----- */
+static void test_typed_kernel_perf(void) {
+    START_TEST("typed vs generic ops perf (double): 256x256 multiplied for 256x256");
+
+    const size_t S = 256, BS = 64;
+    Matrix *A = new_matrix(S, S, sizeof(double)), *B = new_matrix(S, S, sizeof(double));
+    fill_random_f64_seed(A, 0xBEEF01u);
+    fill_random_f64_seed(B, 0xBEEF02u);
+
+    double t0 = mm_now_ms();
+    Matrix *Cg = matrix_multiply_blocked_ops(A, B, &USER_F64_OPS, BS);
+    double t1 = mm_now_ms();
+    Matrix *Ct = matrix_multiply_f64_blocked(A, B, BS);
+    double t2 = mm_now_ms();
+
+    MAT_EXPECT(all_nearly_equal_f64(Ct, Cg, 1e-12), "typed vs generic blocked equal within tol");
+    printf("  timings: blocked(BS=%zu) generic ops=%.3f ms, typed=%.3f ms, speedup x%.2f\n",
+           BS, t1 - t0, t2 - t1, (t2 - t1 > 0.0) ? (t1 - t0) / (t2 - t1) : 0.0);
+
+    destroy_matrix(Cg); destroy_matrix(Ct); destroy_matrix(A); destroy_matrix(B);
+}
+
+/* ============================ PACKED GEMM ============================ */
+
+static int all_nearly_equal_f32(const Matrix *X, const Matrix *Y, double tol) {
+    if (!X || !Y || X->rows != Y->rows || X->cols != Y->cols) return 0;
+    const float *x = (const float*)X->data, *y = (const float*)Y->data;
+    for (size_t i = 0; i < X->rows * X->cols; ++i) {
+        if (!nearly_equal(x[i], y[i], tol)) return 0;
+    }
+    return 1;
+}
+
+/* ----- Packed path vs typed naive: full/edge tiles, several KC slices and MC panels ----- */
+static void test_packed_matches_naive(void) {
+    START_TEST("packed micro-kernel GEMM vs naive (double, float)");
+    printf("  packed micro-kernel: %s\n", matrix_gemm_kernel_name());
+
+    const size_t shapes[][3] = { {1,1,1}, {4,1,8}, {5,3,300}, {131,257,77}, {96,64,128}, {13,700,35} };
+    for (size_t s = 0; s < sizeof shapes / sizeof shapes[0]; ++s) {
+        const size_t M = shapes[s][0], P = shapes[s][1], N = shapes[s][2];
+        Matrix *A = new_matrix(M, P, sizeof(double)), *B = new_matrix(P, N, sizeof(double));
+        Matrix *Af = new_matrix(M, P, sizeof(float)), *Bf = new_matrix(P, N, sizeof(float));
+        fill_random_f64_seed(A, 0x7ACE0000u + s);
+        fill_random_f64_seed(B, 0x7ACE1000u + s);
+        for (size_t i = 0; i < M * P; ++i) ((float*)Af->data)[i] = (float)((double*)A->data)[i];
+        for (size_t i = 0; i < P * N; ++i) ((float*)Bf->data)[i] = (float)((double*)B->data)[i];
+
+        Matrix *Rn = matrix_multiply_f64_naive(A, B),  *Rp = matrix_multiply_f64_packed(A, B);
+        Matrix *Fn = matrix_multiply_f32_naive(Af, Bf), *Fp = matrix_multiply_f32_packed(Af, Bf);
+        int ok64 = all_nearly_equal_f64(Rp, Rn, 1e-12);
+        int ok32 = all_nearly_equal_f32(Fp, Fn, 1e-4);
+        MAT_EXPECT(ok64, "f64 packed must match naive");
+        MAT_EXPECT(ok32, "f32 packed must match naive");
+        if (!ok64 || !ok32) printf("  mismatch for shape %zux%zu * %zux%zu\n", M, P, P, N);
+
+        destroy_matrix(Rn); destroy_matrix(Rp); destroy_matrix(Fn); destroy_matrix(Fp);
+        destroy_matrix(A); destroy_matrix(B); destroy_matrix(Af); destroy_matrix(Bf);
+    }
+
+    /* the facade routes large float/double products to the packed path */
+    Matrix *A = new_matrix(70, 70, sizeof(double)), *B = new_matrix(70, 70, sizeof(double));
+    fill_random_f64_seed(A, 11u);
+    fill_random_f64_seed(B, 12u);
+    Matrix *Cf = matrix_multiply(A, B), *Cp = matrix_multiply_f64_packed(A, B);
+    MAT_EXPECT(same_bytes(Cf, Cp), "facade must use the packed path for large doubles");
+    MAT_EXPECT(matrix_multiply_f64_packed(A, NULL) == NULL, "packed must reject NULL inputs");
+    destroy_matrix(Cf); destroy_matrix(Cp); destroy_matrix(A); destroy_matrix(B);
+}
+
+/* ----- Perf: tiled typed kernel vs packed micro-kernel ----- */
+static void test_packed_perf(void) {
+    START_TEST("blocked vs packed perf (double): 512x512 multiplied for 512x512");
+
+    const size_t S = 512;
+    Matrix *A = new_matrix(S, S, sizeof(double)), *B = new_matrix(S, S, sizeof(double));
+    fill_random_f64_seed(A, 0xFACE01u);
+    fill_random_f64_seed(B, 0xFACE02u);
+
+    double t0 = mm_now_ms();
+    Matrix *Cb = matrix_multiply_f64_blocked(A, B, 64);
+    double t1 = mm_now_ms();
+    Matrix *Cp = matrix_multiply_f64_packed(A, B);
+    double t2 = mm_now_ms();
+
+    MAT_EXPECT(all_nearly_equal_f64(Cp, Cb, 1e-12), "blocked vs packed equal within tol");
+    const double flops = 2.0 * (double)S * (double)S * (double)S;
+    printf("  timings: blocked(BS=64)=%.3f ms (%.2f GFLOP/s), packed[%s]=%.3f ms (%.2f GFLOP/s)\n",
+           t1 - t0, (t1 - t0 > 0.0) ? flops / ((t1 - t0) * 1e6) : 0.0,
+           matrix_gemm_kernel_name(),
+           t2 - t1, (t2 - t1 > 0.0) ? flops / ((t2 - t1) * 1e6) : 0.0);
+
+    destroy_matrix(Cb); destroy_matrix(Cp); destroy_matrix(A); destroy_matrix(B);
+}
+
+/* ============================ THREAD POOL & PARALLEL ============================ */
+
+typedef struct PoolProbe {
+    unsigned char *hits;      /* one slot per task: tasks are disjoint, no race */
+    unsigned      *worker_of;
+    unsigned       workers;
+} PoolProbe;
+
+static void pool_probe_task(size_t task, unsigned worker, void *ctx) {
+    PoolProbe *probe = (PoolProbe*)ctx;
+    volatile double sink = 0.0;
+    for (size_t spin = 0; spin < (task % 37) * 200; ++spin) sink += (double)spin;  /* uneven tasks */
+    (void)sink;
+    probe->hits[task]++;
+    probe->worker_of[task] = worker;
+}
+
+/* ----- Pool: every task exactly once, valid worker ids, reusable across runs ----- */
+static void test_thread_pool_runs_each_task_once(void) {
+    START_TEST("thread pool: each task once, across runs");
+
+    enum { TASKS = 1000 };
+    unsigned char hits[TASKS];
+    unsigned worker_of[TASKS];
+    PoolProbe probe = { hits, worker_of, 0 };
+
+    MatrixThreadPool *pool = build_matrix_thread_pool(4);
+    MAT_EXPECT(pool && matrix_thread_pool_size(pool) == 4, "pool of 4 must build");
+    probe.workers = matrix_thread_pool_size(pool);
+
+    int ok = 1;
+    for (int run = 0; run < 20; ++run) {
+        memset(hits, 0, sizeof hits);
+        const size_t count = (run % 2) ? TASKS : 3 + (size_t)run;
+        matrix_thread_pool_run(pool, count, pool_probe_task, &probe);
+        for (size_t t = 0; t < count; ++t) {
+            if (hits[t] != 1 || worker_of[t] >= probe.workers) ok = 0;
+        }
+        for (size_t t = count; t < TASKS; ++t) if (hits[t] != 0) ok = 0;
+    }
+    MAT_EXPECT(ok, "every task must run exactly once on a valid worker");
+    matrix_thread_pool_destroy(pool);
+
+    memset(hits, 0, sizeof hits);
+    matrix_thread_pool_run(NULL, TASKS, pool_probe_task, &probe);
+    ok = 1;
+    for (size_t t = 0; t < TASKS; ++t) if (hits[t] != 1 || worker_of[t] != 0) ok = 0;
+    MAT_EXPECT(ok, "NULL pool must run every task inline as worker 0");
+
+    MatrixThreadPool *auto_pool = build_matrix_thread_pool(0);
+    MAT_EXPECT(auto_pool && matrix_thread_pool_size(auto_pool) >= 1, "0 threads must mean one per online CPU");
+    matrix_thread_pool_destroy(auto_pool);
+    matrix_thread_pool_destroy(NULL);  /* documented no-op */
+}
+
+/* ----- Parallel multiply matches the serial kernels for several pool sizes ----- */
+static void test_parallel_multiply_matches_serial(void) {
+    START_TEST("parallel multiply vs serial (double, float, int64)");
+
+    const size_t M = 203, P = 150, N = 300;  /* partial tiles in both directions */
+    Matrix *A = new_matrix(M, P, sizeof(double)), *B = new_matrix(P, N, sizeof(double));
+    Matrix *Af = new_matrix(M, P, sizeof(float)), *Bf = new_matrix(P, N, sizeof(float));
+    Matrix *Ai = new_matrix(M, P, sizeof(int64_t)), *Bi = new_matrix(P, N, sizeof(int64_t));
+    fill_random_f64_seed(A, 0xA11u);
+    fill_random_f64_seed(B, 0xB22u);
+    for (size_t i = 0; i < M * P; ++i) {
+        ((float*)Af->data)[i] = (float)((double*)A->data)[i];
+        ((int64_t*)Ai->data)[i] = (int64_t)(((double*)A->data)[i] * 1000.0);
+    }
+    for (size_t i = 0; i < P * N; ++i) {
+        ((float*)Bf->data)[i] = (float)((double*)B->data)[i];
+        ((int64_t*)Bi->data)[i] = (int64_t)(((double*)B->data)[i] * 1000.0);
+    }
+
+    Matrix *Rd = matrix_multiply_f64_packed(A, B);
+    Matrix *Rf = matrix_multiply_f32_packed(Af, Bf);
+    Matrix *Ri = matrix_multiply_i64_naive(Ai, Bi);
+
+    const unsigned sizes[] = { 0 /* NULL pool */, 1, 3, 8 };
+    for (size_t s = 0; s < sizeof sizes / sizeof sizes[0]; ++s) {
+        MatrixThreadPool *pool = sizes[s] ? build_matrix_thread_pool(sizes[s]) : NULL;
+        Matrix *Pd = matrix_multiply_f64_parallel(pool, A, B);
+        Matrix *Pf = matrix_multiply_f32_parallel(pool, Af, Bf);
+        Matrix *Pi = matrix_multiply_i64_parallel(pool, Ai, Bi);
+        Matrix *Pg = matrix_multiply_parallel(pool, A, B);
+        MAT_EXPECT(same_bytes(Pd, Rd), "f64 parallel must equal the packed result");
+        MAT_EXPECT(same_bytes(Pf, Rf), "f32 parallel must equal the packed result");
+        MAT_EXPECT(same_bytes(Pi, Ri), "i64 parallel must equal the serial result");
+        MAT_EXPECT(same_bytes(Pg, Rd), "parallel facade must dispatch doubles to the packed tiles");
+        destroy_matrix(Pd); destroy_matrix(Pf); destroy_matrix(Pi); destroy_matrix(Pg);
+        matrix_thread_pool_destroy(pool);
+    }
+    MAT_EXPECT(matrix_multiply_f64_parallel(NULL, A, Bf) == NULL, "parallel must reject element size mismatch");
+
+    destroy_matrix(Rd); destroy_matrix(Rf); destroy_matrix(Ri);
+    destroy_matrix(A); destroy_matrix(B); destroy_matrix(Af); destroy_matrix(Bf);
+    destroy_matrix(Ai); destroy_matrix(Bi);
+}
+
+/* ----- Perf: packed single thread vs parallel on a pool of online CPUs ----- */
+static void test_parallel_perf(void) {
+    START_TEST("serial vs parallel perf (double): 768x768 multiplied for 768x768");
+
+    const size_t S = 768;
+    Matrix *A = new_matrix(S, S, sizeof(double)), *B = new_matrix(S, S, sizeof(double));
+    fill_random_f64_seed(A, 0xD00D01u);
+    fill_random_f64_seed(B, 0xD00D02u);
+    MatrixThreadPool *pool = build_matrix_thread_pool(0);
+
+    double t0 = mm_now_ms();
+    Matrix *Cs = matrix_multiply_f64_packed(A, B);
+    double t1 = mm_now_ms();
+    Matrix *Cp = matrix_multiply_f64_parallel(pool, A, B);
+    double t2 = mm_now_ms();
+
+    MAT_EXPECT(same_bytes(Cs, Cp), "serial vs parallel must be identical");
+    printf("  timings: packed 1 thread=%.3f ms, parallel %u thread(s)=%.3f ms, speedup x%.2f\n",
+           t1 - t0, matrix_thread_pool_size(pool), t2 - t1,
+           (t2 - t1 > 0.0) ? (t1 - t0) / (t2 - t1) : 0.0);
+
+    matrix_thread_pool_destroy(pool);
+    destroy_matrix(Cs); destroy_matrix(Cp); destroy_matrix(A); destroy_matrix(B);
+}
+
+/* ============================ MULTIPLY INTO ============================ */
+
+/* ----- C = alpha*A*B + beta*C on the typed and packed paths ----- */
+static void test_multiply_into_alpha_beta(void) {
+    START_TEST("multiply_into: alpha/beta, beta=0 overwrite, rejections");
+
+    const size_t shapes[][3] = { {3,4,5}, {70,70,70}, {130,300,17} };  /* typed kernel, packed, packed */
+    for (size_t s = 0; s < sizeof shapes / sizeof shapes[0]; ++s) {
+        const size_t M = shapes[s][0], P = shapes[s][1], N = shapes[s][2];
+        Matrix *A = new_matrix(M, P, sizeof(double)), *B = new_matrix(P, N, sizeof(double));
+        Matrix *C = new_matrix(M, N, sizeof(double));
+        fill_random_f64_seed(A, 0x1170u + s);
+        fill_random_f64_seed(B, 0x2270u + s);
+        fill_random_f64_seed(C, 0x3370u + s);
+
+        Matrix *AB = matrix_multiply_f64_naive(A, B);
+        Matrix *Ref = new_matrix(M, N, sizeof(double));
+        for (size_t i = 0; i < M * N; ++i) {
+            ((double*)Ref->data)[i] = 2.5 * ((double*)AB->data)[i] - 0.5 * ((double*)C->data)[i];
+        }
+        MAT_EXPECT(matrix_multiply_into_f64(C, A, B, 2.5, -0.5) == 1, "into f64 must succeed");
+        MAT_EXPECT(all_nearly_equal_f64(C, Ref, 1e-12), "into f64 must compute alpha*A*B + beta*C");
+
+        /* beta == 0 never reads C: NaN in C must not leak */
+        const double nan_value = NAN;
+        matrix_fill_scalar(C, (void*)&nan_value);
+        MAT_EXPECT(matrix_multiply_into(C, A, B, 1.0, 0.0) == 1, "facade into must succeed on doubles");
+        MAT_EXPECT(all_nearly_equal_f64(C, AB, 1e-12), "beta=0 must overwrite C, ignoring NaN");
+
+        /* beta == 1 accumulates */
+        MAT_EXPECT(matrix_multiply_into_f64(C, A, B, 1.0, 1.0) == 1, "accumulate must succeed");
+        for (size_t i = 0; i < M * N; ++i) ((double*)Ref->data)[i] = 2.0 * ((double*)AB->data)[i];
+        MAT_EXPECT(all_nearly_equal_f64(C, Ref, 1e-12), "beta=1 must accumulate into C");
+
+        destroy_matrix(AB); destroy_matrix(Ref);
+        destroy_matrix(A); destroy_matrix(B); destroy_matrix(C);
+    }
+
+    /* integers are exact */
+    const int64_t Ai[6] = {1,2,3, 4,5,6};
+    const int64_t Bi[6] = {7,8, 9,10, 11,12};
+    const int64_t C0[4] = {1,-1, 2,-2};
+    const int64_t Cref[4] = {3*58 + 2*1, 3*64 - 2*1, 3*139 + 2*2, 3*154 - 2*2};
+    Matrix *MA = make_i64(2,3,Ai), *MB = make_i64(3,2,Bi), *MC = make_i64(2,2,C0);
+    MAT_EXPECT(matrix_multiply_into_i64(MC, MA, MB, 3, 2) == 1, "into i64 must succeed");
+    expect_equal_i64(MC, Cref, 2,2, "into i64: 3*A*B + 2*C exact");
+
+    /* rejections leave C untouched */
+    Matrix *Wrong = new_matrix(3, 3, sizeof(int64_t));
+    MAT_EXPECT(matrix_multiply_into_i64(Wrong, MA, MB, 1, 0) == 0, "into must reject a mis-shaped C");
+    MAT_EXPECT(matrix_multiply_into_i64(NULL, MA, MB, 1, 0) == 0, "into must reject a NULL C");
+    Matrix *Sq = make_i64(2,2,C0);
+    MAT_EXPECT(matrix_multiply_into_i64(Sq, Sq, Sq, 1, 0) == 0, "into must reject C aliasing A/B");
+    MAT_EXPECT(memcmp(Sq->data, C0, sizeof C0) == 0, "rejected call must not touch C");
+    destroy_matrix(Sq); destroy_matrix(Wrong);
+    destroy_matrix(MA); destroy_matrix(MB); destroy_matrix(MC);
+}
+
+/* ----- Perf: allocate-per-call multiply vs multiply_into in an iterative loop ----- */
+static void test_multiply_into_perf(void) {
+    START_TEST("multiply vs multiply_into perf (double): 100000 x 8x8, 8 x 256x256");
+
+    enum { ITERS = 100000 };
+    const size_t S = 8;
+    Matrix *A = new_matrix(S, S, sizeof(double)), *B = new_matrix(S, S, sizeof(double));
+    Matrix *C = new_matrix(S, S, sizeof(double));
+    fill_random_f64_seed(A, 0x10u);
+    fill_random_f64_seed(B, 0x20u);
+
+    double checksum_new = 0.0, checksum_into = 0.0;
+    double t0 = mm_now_ms();
+    for (int it = 0; it < ITERS; ++it) {
+        Matrix *R = matrix_multiply_f64_blocked(A, B, 64);
+        checksum_new += ((double*)R->data)[it % (S * S)];
+        destroy_matrix(R);
+    }
+    double t1 = mm_now_ms();
+    for (int it = 0; it < ITERS; ++it) {
+        matrix_multiply_into_f64(C, A, B, 1.0, 0.0);
+        checksum_into += ((double*)C->data)[it % (S * S)];
+    }
+    double t2 = mm_now_ms();
+
+    MAT_EXPECT(nearly_equal(checksum_new, checksum_into, 1e-12), "both loops must compute the same products");
+    printf("  timings: %d products: new C each call=%.3f ms, into reused C=%.3f ms, speedup x%.2f\n",
+           ITERS, t1 - t0, t2 - t1, (t2 - t1 > 0.0) ? (t1 - t0) / (t2 - t1) : 0.0);
+
+    destroy_matrix(A); destroy_matrix(B); destroy_matrix(C);
+
+    /* Large shape: both calls take the packed path (which packs per call, see matrix.h),
+       so reusing C only saves the result allocation; expect a speedup near x1. */
+    enum { BIG_ITERS = 8 };
+    const size_t N = 256;
+    A = new_matrix(N, N, sizeof(double)); B = new_matrix(N, N, sizeof(double));
+    C = new_matrix(N, N, sizeof(double));
+    fill_random_f64_seed(A, 0x30u);
+    fill_random_f64_seed(B, 0x40u);
+
+    checksum_new = 0.0; checksum_into = 0.0;
+    t0 = mm_now_ms();
+    for (int it = 0; it < BIG_ITERS; ++it) {
+        Matrix *R = matrix_multiply(A, B);
+        checksum_new += ((double*)R->data)[(size_t)it * (N + 1)];
+        destroy_matrix(R);
+    }
+    t1 = mm_now_ms();
+    for (int it = 0; it < BIG_ITERS; ++it) {
+        matrix_multiply_into_f64(C, A, B, 1.0, 0.0);
+        checksum_into += ((double*)C->data)[(size_t)it * (N + 1)];
+    }
+    t2 = mm_now_ms();
+
+    MAT_EXPECT(nearly_equal(checksum_new, checksum_into, 1e-9), "large multiply and multiply_into must agree");
+    printf("  timings: %d products 256x256x256: matrix_multiply=%.3f ms, into reused C=%.3f ms, speedup x%.2f\n",
+           BIG_ITERS, t1 - t0, t2 - t1, (t2 - t1 > 0.0) ? (t1 - t0) / (t2 - t1) : 0.0);
+
+    destroy_matrix(A); destroy_matrix(B); destroy_matrix(C);
+}
+
+/* ============================ VIEWS ============================ */
+
+/* Copy a view into a fresh contiguous Matrix (reference for the view kernels). */
+static Matrix* view_to_matrix(const MatrixView *v) {
+    Matrix *M = new_matrix(v->rows, v->cols, v->size_of_element);
+    if (!M) return NULL;
+    for (size_t i = 0; i < v->rows; ++i) {
+        for (size_t j = 0; j < v->cols; ++j) {
+            memcpy((char*)M->data + (i * v->cols + j) * v->size_of_element,
+                   matrix_view_at(v, i, j), v->size_of_element);
+        }
+    }
+    return M;
+}
+
+/* 1 if every element of Y outside rows [r0,r0+rows) x cols [c0,c0+cols) equals Y0. */
+static int outside_window_untouched(const Matrix *Y, const Matrix *Y0, size_t r0, size_t c0, size_t rows, size_t cols) {
+    const double *y = (const double*)Y->data, *y0 = (const double*)Y0->data;
+    for (size_t i = 0; i < Y->rows; ++i) {
+        for (size_t j = 0; j < Y->cols; ++j) {
+            const int inside = i >= r0 && i < r0 + rows && j >= c0 && j < c0 + cols;
+            if (!inside && y[i * Y->cols + j] != y0[i * Y->cols + j]) return 0;
+        }
+    }
+    return 1;
+}
+
+/* ----- View constructors ----- */
+static void test_view_constructors(void) {
+    START_TEST("views: sub, rows, transpose, at");
+
+    const int64_t vals[12] = { 0,1,2,3, 10,11,12,13, 20,21,22,23 };   /* 3x4 */
+    Matrix *M = make_i64(3,4,vals);
+    MatrixView v = matrix_view_of(M);
+    MAT_EXPECT(v.rows == 3 && v.cols == 4 && v.row_stride == 4 && !v.transposed, "view_of must cover the matrix");
+
+    MatrixView s = matrix_view_sub(&v, 1, 1, 2, 2);
+    MAT_EXPECT(*(int64_t*)matrix_view_at(&s, 0, 0) == 11 && *(int64_t*)matrix_view_at(&s, 1, 1) == 22, "sub must offset into the parent");
+    MatrixView t = matrix_view_transpose(&v);
+    MAT_EXPECT(t.rows == 4 && t.cols == 3 && *(int64_t*)matrix_view_at(&t, 3, 2) == 23, "transpose must swap indices");
+    MatrixView ts = matrix_view_sub(&t, 2, 1, 2, 2);                   /* rows 2..3 of M^T = cols 2..3 of M */
+    MAT_EXPECT(*(int64_t*)matrix_view_at(&ts, 0, 0) == 12 && *(int64_t*)matrix_view_at(&ts, 1, 1) == 23, "sub of a transpose");
+    MatrixView r = matrix_view_rows(&v, 2, 1);
+    MAT_EXPECT(r.rows == 1 && *(int64_t*)matrix_view_at(&r, 0, 3) == 23, "row range");
+
+    mat_silence_stderr_begin();
+    MatrixView bad = matrix_view_sub(&v, 2, 0, 2, 4);
+    MatrixView none = matrix_view_of(NULL);
+    mat_silence_stderr_end();
+    MAT_EXPECT(bad.data == NULL && none.data == NULL, "out-of-range window and NULL matrix give invalid views");
+    MAT_EXPECT(matrix_view_at(&v, 3, 0) == NULL, "view_at must bounds-check");
+
+    destroy_matrix(M);
+}
+
+/* ----- Multiply on sub-blocks and transposes vs copied-out reference ----- */
+static void test_view_multiply_matches_copies(void) {
+    START_TEST("views: multiply on sub-blocks/transposes, no copies");
+
+    Matrix *X = new_matrix(200, 180, sizeof(double));
+    fill_random_f64_seed(X, 0x51Eu);
+    MatrixView xv = matrix_view_of(X);
+
+    /* {m, p, n}: typed strided kernel and packed kernel */
+    const size_t shapes[][3] = { {9, 7, 5}, {70, 90, 60} };
+    for (size_t s = 0; s < 2; ++s) {
+        const size_t M = shapes[s][0], P = shapes[s][1], N = shapes[s][2];
+        MatrixView A  = matrix_view_sub(&xv, 10, 5, M, P);
+        MatrixView Bs = matrix_view_sub(&xv, 100, 20, N, P);           /* stored N x P ... */
+        MatrixView B  = matrix_view_transpose(&Bs);                    /* ... used as P x N */
+
+        for (int c_transposed = 0; c_transposed <= 1; ++c_transposed) {
+            Matrix *Y = new_matrix(150, 150, sizeof(double));
+            fill_random_f64_seed(Y, 0x7E5u + s);
+            Matrix *Y0 = new_matrix(150, 150, sizeof(double));
+            memcpy(Y0->data, Y->data, 150 * 150 * sizeof(double));
+            MatrixView yv = matrix_view_of(Y);
+            MatrixView Cs = c_transposed ? matrix_view_sub(&yv, 7, 11, N, M) : matrix_view_sub(&yv, 7, 11, M, N);
+            MatrixView C  = c_transposed ? matrix_view_transpose(&Cs) : Cs;
+
+            Matrix *Ac = view_to_matrix(&A), *Bc = view_to_matrix(&B), *Cc = view_to_matrix(&C);
+            Matrix *AB = matrix_multiply_f64_naive(Ac, Bc);
+            for (size_t i = 0; i < M * N; ++i) {
+                ((double*)Cc->data)[i] = 1.5 * ((double*)AB->data)[i] + 0.5 * ((double*)Cc->data)[i];
+            }
+
+            MAT_EXPECT(matrix_multiply_view_into_f64(&C, &A, &B, 1.5, 0.5) == 1, "view multiply must succeed");
+            Matrix *Got = view_to_matrix(&C);
+            MAT_EXPECT(all_nearly_equal_f64(Got, Cc, 1e-12), "view multiply must match the copied-out product");
+            MAT_EXPECT(c_transposed ? outside_window_untouched(Y, Y0, 7, 11, N, M)
+                                    : outside_window_untouched(Y, Y0, 7, 11, M, N),
+                       "view multiply must only write inside C's window");
+
+            destroy_matrix(Got); destroy_matrix(AB); destroy_matrix(Ac); destroy_matrix(Bc); destroy_matrix(Cc);
+            destroy_matrix(Y); destroy_matrix(Y0);
+        }
+    }
+
+    /* beta == 0 with a transposed B: the strided first k-step overwrites NaN in C */
+    {
+        MatrixView A  = matrix_view_sub(&xv, 3, 4, 9, 7);
+        MatrixView Bs = matrix_view_sub(&xv, 50, 60, 5, 7);
+        MatrixView B  = matrix_view_transpose(&Bs);
+        Matrix *C = new_matrix(9, 5, sizeof(double));
+        const double nan_value = NAN;
+        matrix_fill_scalar(C, (void*)&nan_value);
+        MatrixView cv = matrix_view_of(C);
+        Matrix *Ac = view_to_matrix(&A), *Bc = view_to_matrix(&B);
+        Matrix *AB = matrix_multiply_f64_naive(Ac, Bc);
+        MAT_EXPECT(matrix_multiply_view_into_f64(&cv, &A, &B, 1.0, 0.0) == 1 && all_nearly_equal_f64(C, AB, 1e-12),
+                   "beta=0 on a strided B must overwrite C, ignoring NaN");
+        destroy_matrix(AB); destroy_matrix(Ac); destroy_matrix(Bc); destroy_matrix(C);
+    }
+
+    /* integer transposes on the typed strided kernel, and the ops path, are exact */
+    Matrix *I = new_matrix(40, 40, sizeof(int64_t));
+    uint64_t st = 0x1D5u;
+    for (size_t i = 0; i < 1600; ++i) ((int64_t*)I->data)[i] = (int64_t)(mm_xorshift64s(&st) % 201) - 100;
+    MatrixView iv = matrix_view_of(I);
+    MatrixView Ai  = matrix_view_transpose(&iv);                    /* I^T */
+    MatrixView Ai2 = matrix_view_sub(&Ai, 3, 0, 12, 40);
+    MatrixView Bi  = matrix_view_sub(&iv, 0, 30, 40, 9);
+    Matrix *Ci = new_matrix(12, 9, sizeof(int64_t)), *Co = new_matrix(12, 9, sizeof(int64_t));
+    MatrixView civ = matrix_view_of(Ci), cov = matrix_view_of(Co);
+    Matrix *Aic = view_to_matrix(&Ai2), *Bic = view_to_matrix(&Bi);
+    Matrix *Ri = matrix_multiply_i64_naive(Aic, Bic);
+    MAT_EXPECT(matrix_multiply_view_into_i64(&civ, &Ai2, &Bi, 1, 0) == 1 && same_bytes(Ci, Ri), "i64 transposed view product exact");
+    MAT_EXPECT(matrix_multiply_view_ops(&cov, &Ai2, &Bi, &USER_I64_OPS) == 1 && same_bytes(Co, Ri), "ops on views exact");
+
+    /* C overlapping an operand is rejected and left untouched */
+    MatrixView overlap_c = matrix_view_sub(&iv, 0, 0, 12, 9);
+    int64_t before = *(int64_t*)matrix_view_at(&overlap_c, 0, 0);
+    mat_silence_stderr_begin();
+    MAT_EXPECT(matrix_multiply_view_into_i64(&overlap_c, &Ai2, &Bi, 1, 0) == 0, "C overlapping A/B must be rejected");
+    mat_silence_stderr_end();
+    MAT_EXPECT(*(int64_t*)matrix_view_at(&overlap_c, 0, 0) == before, "rejected view multiply must not write");
+
+    destroy_matrix(Aic); destroy_matrix(Bic); destroy_matrix(Ri);
+    destroy_matrix(Ci); destroy_matrix(Co); destroy_matrix(I); destroy_matrix(X);
+}
+
+/* ----- Perf: copy sub-blocks out then multiply vs multiply the views in place ----- */
+static void test_view_perf(void) {
+    START_TEST("copy-out vs view perf (double): 384x384 block times transposed block of 1024x1024");
+
+    const size_t S = 1024, K = 384;
+    Matrix *X = new_matrix(S, S, sizeof(double));
+    fill_random_f64_seed(X, 0xB10Cu);
+    MatrixView xv = matrix_view_of(X);
+    MatrixView A  = matrix_view_sub(&xv, 100, 200, K, K);
+    MatrixView Bs = matrix_view_sub(&xv, 500, 300, K, K);
+    MatrixView B  = matrix_view_transpose(&Bs);
+    Matrix *C = new_matrix(K, K, sizeof(double));
+    MatrixView cv = matrix_view_of(C);
+
+    double t0 = mm_now_ms();
+    Matrix *Ac = view_to_matrix(&A), *Bc = view_to_matrix(&B);
+    Matrix *Rc = matrix_multiply_f64_packed(Ac, Bc);
+    double t1 = mm_now_ms();
+    int ok = matrix_multiply_view_into_f64(&cv, &A, &B, 1.0, 0.0);
+    double t2 = mm_now_ms();
+
+    MAT_EXPECT(ok && same_bytes(C, Rc), "view product must equal the copied-out product");
+    printf("  timings: copy-out + multiply=%.3f ms, views in place=%.3f ms, speedup x%.2f\n",
+           t1 - t0, t2 - t1, (t2 - t1 > 0.0) ? (t1 - t0) / (t2 - t1) : 0.0);
+
+    destroy_matrix(Ac); destroy_matrix(Bc); destroy_matrix(Rc); destroy_matrix(C); destroy_matrix(X);
+}
+
 /* Public thin wrapper (optional): can call this standalone if needed. */
 void run_matrix_large_perf_smoke(void) {
     test_large_rectangular_perf();
@@ -720,7 +1316,19 @@ void run_all_matrix_tests(void) {
     test_ops_mod100_u32();
     test_vector_matrix_cases();
     test_large_rectangular_perf();
-
+    test_typed_f32_i32_wrappers();
+    test_typed_kernels_match_generic_ops();
+    test_typed_kernel_perf();
+    test_packed_matches_naive();
+    test_packed_perf();
+    test_thread_pool_runs_each_task_once();
+    test_parallel_multiply_matches_serial();
+    test_parallel_perf();
+    test_multiply_into_alpha_beta();
+    test_multiply_into_perf();
+    test_view_constructors();
+    test_view_multiply_matches_copies();
+    test_view_perf();
 
     /* mat_silence_stderr_end(); */
 
@@ -0,0 +1,314 @@
+#include "read_mostly_hashmap_tests.h"
+
+static int rm_passed = 0;
+static int rm_failed = 0;
+
+#define RM_EXPECT(cond, msg)                                                    \
+    do {                                                                        \
+        if ((cond)) {                                                           \
+            rm_passed++;                                                        \
+        } else {                                                                \
+            rm_failed++;                                                        \
+            fprintf(stderr, "[RM FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg);  \
+        }                                                                       \
+    } while (0)
+
+/* Worker threads record problems in their args; only the main thread touches the counters. */
+
+/* -------- Helpers -------- */
+
+static double rm_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static uint64_t rm_xorshift64s(uint64_t* s) {
+    uint64_t x = *s;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    *s = x;
+    return x * 2685821657736338717ULL;
+}
+
+static int g_rm_free_count = 0;
+static void rm_data_free_counter(void* p) {
+    if (p) {
+        g_rm_free_count++;
+        free(p);
+    }
+}
+
+/* -------- Individual tests -------- */
+
+static void test_single_thread_semantics(void) {
+    ReadMostlyHashMap* m = build_read_mostly_hash_map();
+    ReadMostlyHashMapReader* r = read_mostly_hash_map_register_reader(m);
+    g_rm_free_count = 0;
+
+    int* v1 = malloc(sizeof(int)); *v1 = 1;
+    int* v2 = malloc(sizeof(int)); *v2 = 2;
+    RM_EXPECT(read_mostly_hash_map_put(m, "k", 1, v1, sizeof(int), rm_data_free_counter) == 0, "First put must insert");
+    RM_EXPECT(read_mostly_hash_map_put(m, "k", 1, v2, sizeof(int), rm_data_free_counter) == 1, "Second put must update");
+    RM_EXPECT(read_mostly_hash_map_size(m) == 1, "Update must not change the size");
+
+    read_mostly_hash_map_read_lock(m, r);
+    const ReadMostlyHashMapEntry* e = read_mostly_hash_map_get(m, "k", 1);
+    RM_EXPECT(e != NULL && e->data == v2 && e->data_size == sizeof(int), "Get must return the latest value");
+    RM_EXPECT(e != NULL && e->key_size == 1 && e->key[0] == 'k', "Key must be deep-copied into the entry");
+    RM_EXPECT(read_mostly_hash_map_get(m, "missing", 7) == NULL, "Get on missing key must return NULL");
+    read_mostly_hash_map_read_unlock(r);
+
+    RM_EXPECT(read_mostly_hash_map_reclaim(m) == 0, "Nothing may stay pending once no reader is inside");
+    RM_EXPECT(g_rm_free_count == 1, "Owned old value must be freed once reclaimed");
+
+    RM_EXPECT(read_mostly_hash_map_remove(m, "k", 1, rm_data_free_counter) == 1, "Remove must find the key");
+    RM_EXPECT(read_mostly_hash_map_remove(m, "k", 1, rm_data_free_counter) == 0, "Second remove must miss");
+    RM_EXPECT(g_rm_free_count == 2, "Owned value must be freed on remove");
+    RM_EXPECT(read_mostly_hash_map_size(m) == 0, "Map must be empty after remove");
+
+    read_mostly_hash_map_unregister_reader(m, r);
+    read_mostly_hash_map_destroy(m, rm_data_free_counter);
+}
+
+static void test_reader_delays_reclamation(void) {
+    ReadMostlyHashMap* m = build_read_mostly_hash_map();
+    ReadMostlyHashMapReader* r = read_mostly_hash_map_register_reader(m);
+    g_rm_free_count = 0;
+
+    int* v = malloc(sizeof(int)); *v = 42;
+    (void)read_mostly_hash_map_put(m, "held", 4, v, sizeof(int), rm_data_free_counter);
+
+    read_mostly_hash_map_read_lock(m, r);
+    const ReadMostlyHashMapEntry* e = read_mostly_hash_map_get(m, "held", 4);
+    RM_EXPECT(e != NULL, "Entry must be found");
+
+    /* A writer removes the key (and churns enough to grow the table) while the reader holds it */
+    (void)read_mostly_hash_map_remove(m, "held", 4, rm_data_free_counter);
+    for (unsigned i = 0; i < 100; ++i) (void)read_mostly_hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+
+    RM_EXPECT(read_mostly_hash_map_reclaim(m) > 0, "Retired objects must wait for the active reader");
+    RM_EXPECT(g_rm_free_count == 0, "Owned value must not be freed under an active reader");
+    RM_EXPECT(e != NULL && *(int*)e->data == 42 && e->key_size == 4, "Held entry must stay intact");
+    read_mostly_hash_map_read_unlock(r);
+
+    RM_EXPECT(read_mostly_hash_map_reclaim(m) == 0, "Everything must be reclaimed after unlock");
+    RM_EXPECT(g_rm_free_count == 1, "Owned value must be freed after the reader left");
+
+    read_mostly_hash_map_unregister_reader(m, r);
+    read_mostly_hash_map_destroy(m, NULL);
+}
+
+static void test_growth_and_tombstone_churn(void) {
+    ReadMostlyHashMap* m = build_read_mostly_hash_map();
+    ReadMostlyHashMapReader* r = read_mostly_hash_map_register_reader(m);
+    const uint32_t N = 20000;
+
+    for (uint32_t i = 0; i < N; ++i) (void)read_mostly_hash_map_put(m, &i, sizeof i, (void*)(uintptr_t)(i + 1), 0, NULL);
+    RM_EXPECT(read_mostly_hash_map_size(m) == N, "Size must count every insert");
+
+    read_mostly_hash_map_read_lock(m, r);
+    int all_found = 1;
+    for (uint32_t i = 0; i < N; ++i) {
+        const ReadMostlyHashMapEntry* e = read_mostly_hash_map_get(m, &i, sizeof i);
+        if (e == NULL || e->data != (void*)(uintptr_t)(i + 1)) all_found = 0;
+    }
+    read_mostly_hash_map_read_unlock(r);
+    RM_EXPECT(all_found, "All entries must survive growth");
+
+    /* insert/remove churn over a small live set must not grow the table without bound */
+    ReadMostlyHashMapTable* before = atomic_load(&m->table);
+    size_t capacity_before = before->capacity;
+    for (uint32_t i = 0; i < 10 * N; ++i) {
+        uint32_t k = N + i;
+        (void)read_mostly_hash_map_put(m, &k, sizeof k, NULL, 0, NULL);
+        (void)read_mostly_hash_map_remove(m, &k, sizeof k, NULL);
+    }
+    RM_EXPECT(atomic_load(&m->table)->capacity <= capacity_before * 2, "Tombstones must be cleaned by rehash, not by growth");
+    RM_EXPECT(read_mostly_hash_map_size(m) == N, "Churn must leave the size unchanged");
+
+    read_mostly_hash_map_unregister_reader(m, r);
+    read_mostly_hash_map_destroy(m, NULL);
+}
+
+/* -------- Readers racing with a writer (value/key consistency, no use-after-free) -------- */
+
+#define RM_RACE_KEYS    512
+#define RM_RACE_READERS 3
+
+typedef struct {
+    ReadMostlyHashMap* map;
+    unsigned           id;
+    _Atomic int*       stop;
+    int                errors;
+    unsigned long      hits;
+} RmRaceArgs;
+
+static void* rm_race_reader(void* p) {
+    RmRaceArgs* a = (RmRaceArgs*)p;
+    ReadMostlyHashMapReader* r = read_mostly_hash_map_register_reader(a->map);
+    uint64_t rng = 0xA0761D6478BD642FULL ^ (a->id + 1);
+
+    while (!atomic_load(a->stop)) {
+        read_mostly_hash_map_read_lock(a->map, r);
+        for (unsigned i = 0; i < 64; ++i) {
+            uint32_t key = (uint32_t)(rm_xorshift64s(&rng) % RM_RACE_KEYS);
+            const ReadMostlyHashMapEntry* e = read_mostly_hash_map_get(a->map, &key, sizeof key);
+            if (e == NULL) continue;
+            a->hits++;
+            /* values are "key + 1000 * generation": must belong to this key */
+            if (e->key_size != sizeof key || memcmp(e->key, &key, sizeof key) != 0 ||
+                *(const uint32_t*)e->data % 1000u != key % 1000u) {
+                a->errors++;
+            }
+        }
+        read_mostly_hash_map_read_unlock(r);
+    }
+
+    read_mostly_hash_map_unregister_reader(a->map, r);
+    return NULL;
+}
+
+static void test_readers_race_with_writer(void) {
+    ReadMostlyHashMap* m = build_read_mostly_hash_map();
+    _Atomic int stop = 0;
+    pthread_t threads[RM_RACE_READERS];
+    RmRaceArgs args[RM_RACE_READERS];
+
+    unsigned started = 0;
+    for (unsigned t = 0; t < RM_RACE_READERS; ++t) {
+        args[t] = (RmRaceArgs){ m, t, &stop, 0, 0 };
+        if (pthread_create(&threads[t], NULL, rm_race_reader, &args[t]) == 0) started++;
+    }
+    RM_EXPECT(started == RM_RACE_READERS, "Reader threads must start");
+
+    /* writer: updates, removes and (through the growing key set) table swaps */
+    uint64_t rng = 0x1234567887654321ULL;
+    for (uint32_t gen = 0; gen < 60000; ++gen) {
+        uint64_t x = rm_xorshift64s(&rng);
+        uint32_t key = (uint32_t)(x % RM_RACE_KEYS);
+        if ((x >> 40) % 4 == 0) {
+            (void)read_mostly_hash_map_remove(m, &key, sizeof key, free);
+        } else {
+            uint32_t* v = malloc(sizeof(uint32_t));
+            *v = key % 1000u + 1000u * (gen % 1000u);
+            (void)read_mostly_hash_map_put(m, &key, sizeof key, v, sizeof *v, free);
+        }
+    }
+    atomic_store(&stop, 1);
+    for (unsigned t = 0; t < started; ++t) pthread_join(threads[t], NULL);
+
+    int errors = 0;
+    for (unsigned t = 0; t < started; ++t) errors += args[t].errors;
+    RM_EXPECT(errors == 0, "Readers must only observe complete entries of the requested key");
+    RM_EXPECT(read_mostly_hash_map_reclaim(m) == 0, "All retired objects must be reclaimable after readers leave");
+
+    read_mostly_hash_map_destroy(m, free);
+}
+
+/* -------- Read scaling benchmark: read-mostly map vs striped ConcurrentHashMap -------- */
+
+#define RM_BENCH_KEYS        (1u << 16)
+#define RM_BENCH_OPS_PER_THR 200000u
+#define RM_BENCH_MAX_THREADS 8
+
+typedef struct {
+    ReadMostlyHashMap* rm;      /* used when non-NULL */
+    ConcurrentHashMap* striped; /* otherwise */
+    unsigned           id;
+} RmBenchArgs;
+
+/* 95% get / 5% put; read sections wrap a single lookup (worst case for the epoch scheme). */
+static void* rm_bench_worker(void* p) {
+    RmBenchArgs* a = (RmBenchArgs*)p;
+    ReadMostlyHashMapReader* r = a->rm ? read_mostly_hash_map_register_reader(a->rm) : NULL;
+    uint64_t rng = 0xD1B54A32D192ED03ULL ^ (a->id + 1);
+    uintptr_t sink = 0;
+
+    for (unsigned i = 0; i < RM_BENCH_OPS_PER_THR; ++i) {
+        uint64_t x = rm_xorshift64s(&rng);
+        uint32_t key = (uint32_t)(x & (RM_BENCH_KEYS - 1));
+        int is_put = ((x >> 32) % 20) == 0;
+
+        if (a->rm != NULL) {
+            if (is_put) {
+                (void)read_mostly_hash_map_put(a->rm, &key, sizeof key, (void*)(uintptr_t)i, 0, NULL);
+            } else {
+                read_mostly_hash_map_read_lock(a->rm, r);
+                const ReadMostlyHashMapEntry* e = read_mostly_hash_map_get(a->rm, &key, sizeof key);
+                if (e) sink += (uintptr_t)e->data;
+                read_mostly_hash_map_read_unlock(r);
+            }
+        } else {
+            if (is_put) {
+                (void)concurrent_hash_map_put(a->striped, &key, sizeof key, (void*)(uintptr_t)i, 0, NULL);
+            } else {
+                void* out = NULL;
+                (void)concurrent_hash_map_get(a->striped, &key, sizeof key, &out, NULL);
+                sink += (uintptr_t)out;
+            }
+        }
+    }
+
+    if (r) read_mostly_hash_map_unregister_reader(a->rm, r);
+    return (void*)sink;
+}
+
+static double rm_bench_run(ReadMostlyHashMap* rm, ConcurrentHashMap* striped, unsigned n) {
+    pthread_t threads[RM_BENCH_MAX_THREADS];
+    RmBenchArgs args[RM_BENCH_MAX_THREADS];
+    unsigned started = 0;
+
+    double t0 = rm_now_ms();
+    for (unsigned t = 0; t < n; ++t) {
+        args[t] = (RmBenchArgs){ rm, striped, t };
+        if (pthread_create(&threads[t], NULL, rm_bench_worker, &args[t]) == 0) started++;
+    }
+    for (unsigned t = 0; t < started; ++t) pthread_join(threads[t], NULL);
+    double t1 = rm_now_ms();
+    RM_EXPECT(started == n, "Benchmark threads must start");
+
+    double secs = (t1 - t0) / 1000.0;
+    return secs > 0.0 ? (double)started * RM_BENCH_OPS_PER_THR / secs : 0.0;
+}
+
+static void test_read_scaling_benchmark(void) {
+    ReadMostlyHashMap* rm = build_read_mostly_hash_map();
+    ConcurrentHashMap* striped = build_concurrent_hash_map(0);
+
+    for (uint32_t key = 0; key < RM_BENCH_KEYS; ++key) {
+        (void)read_mostly_hash_map_put(rm, &key, sizeof key, NULL, 0, NULL);
+        (void)concurrent_hash_map_put(striped, &key, sizeof key, NULL, 0, NULL);
+    }
+
+    printf("  bench: 95%% get / 5%% put, %u keys, %u ops per thread\n", RM_BENCH_KEYS, RM_BENCH_OPS_PER_THR);
+    for (unsigned n = 1; n <= RM_BENCH_MAX_THREADS; n *= 2) {
+        double rm_ops = rm_bench_run(rm, NULL, n);
+        double striped_ops = rm_bench_run(NULL, striped, n);
+        printf("  bench: threads=%u read-mostly=%.2f Mops/s striped=%.2f Mops/s (x%.2f)\n",
+               n, rm_ops / 1e6, striped_ops / 1e6, striped_ops > 0.0 ? rm_ops / striped_ops : 0.0);
+    }
+
+    RM_EXPECT(read_mostly_hash_map_size(rm) == RM_BENCH_KEYS, "Benchmark must not change the key set");
+
+    concurrent_hash_map_destroy(striped, NULL);
+    read_mostly_hash_map_destroy(rm, NULL);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_read_mostly_hashmap_tests(void) {
+    rm_passed = rm_failed = 0;
+    printf("[TEST] testing read-mostly hashmap...\n");
+
+    test_single_thread_semantics();
+    test_reader_delays_reclamation();
+    test_growth_and_tombstone_churn();
+    test_readers_race_with_writer();
+    test_read_scaling_benchmark();
+
+    if (rm_failed == 0) {
+        printf("[TEST OK]  read-mostly hashmap: passed=%d failed=%d\n", rm_passed, rm_failed);
+    } else {
+        printf("[TEST FAIL] read-mostly hashmap: passed=%d failed=%d\n", rm_passed, rm_failed);
+    }
+}
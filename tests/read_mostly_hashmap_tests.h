@@ -0,0 +1,16 @@
+#ifndef READ_MOSTLY_HASHMAP_TESTS_H
+#define READ_MOSTLY_HASHMAP_TESTS_H
+
+#include "../hashmap/concurrent_hashmap.h"   /* first: sets the POSIX feature level */
+#include "../hashmap/read_mostly_hashmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>      /* timespec_get, struct timespec */
+
+/* Entry point for ReadMostlyHashMap tests (includes a 1..N threads read benchmark). */
+void run_all_read_mostly_hashmap_tests(void);
+
+#endif /* READ_MOSTLY_HASHMAP_TESTS_H */
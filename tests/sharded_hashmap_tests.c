@@ -0,0 +1,285 @@
+#include "sharded_hashmap_tests.h"
+
+static int shd_passed = 0;
+static int shd_failed = 0;
+
+#define SHD_EXPECT(cond, msg)                                                   \
+    do {                                                                        \
+        if ((cond)) {                                                           \
+            shd_passed++;                                                       \
+        } else {                                                                \
+            shd_failed++;                                                       \
+            fprintf(stderr, "[SHD FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                       \
+    } while (0)
+
+/*
+ * Worker threads never touch the counters above: they record problems in
+ * their own args and the main thread checks them after join.
+ */
+
+#define SHD_THREADS       4
+#define SHD_KEYS_PER_THR  20000
+
+/* -------- Helpers -------- */
+
+static double shd_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* --- stderr silencer (test-only) --- */
+static int shd_saved_stderr_fd = -1;
+
+static void shd_silence_stderr_begin(void) {
+    fflush(stderr);
+    shd_saved_stderr_fd = shd_dup(shd_fileno(stderr));
+    if (shd_saved_stderr_fd < 0) return;
+
+    int devnull = shd_open(SHD_DEV_NULL, SHD_O_WRONLY);
+    if (devnull >= 0) {
+        shd_dup2(devnull, shd_fileno(stderr));
+        shd_close(devnull);
+    }
+}
+
+static void shd_silence_stderr_end(void) {
+    if (shd_saved_stderr_fd >= 0) {
+        fflush(stderr);
+        shd_dup2(shd_saved_stderr_fd, shd_fileno(stderr));
+        shd_close(shd_saved_stderr_fd);
+        shd_saved_stderr_fd = -1;
+    }
+}
+
+static int shd_free_count = 0;
+static void shd_free_counter(void* p) {
+    if (p != NULL) {
+        free(p);
+        shd_free_count++;
+    }
+}
+
+static size_t shd_placed_bytes(const ShardedHashMap* m) {
+    size_t total = 0;
+    for (size_t i = 0; i < m->shard_count; ++i) total += m->shards[i].placed_bytes;
+    return total;
+}
+
+/* Counting allocator hook for a plain HashMap. */
+typedef struct ShdCountingAllocator {
+    size_t live_bytes;
+    size_t allocations;
+} ShdCountingAllocator;
+
+static void* shd_counting_alloc(size_t size, void* ctx) {
+    ShdCountingAllocator* a = ctx;
+    a->live_bytes += size;
+    a->allocations++;
+    return malloc(size);
+}
+
+static void shd_counting_release(void* ptr, size_t size, void* ctx) {
+    ShdCountingAllocator* a = ctx;
+    a->live_bytes -= size;
+    free(ptr);
+}
+
+/* -------- Individual tests -------- */
+
+static void test_hash_map_allocator_hook(void) {
+    ShdCountingAllocator counter = { 0, 0 };
+    HashMapAllocator hook = { shd_counting_alloc, shd_counting_release, &counter };
+    HashMap* m = build_hash_map_with_allocator(&hook);
+
+    for (int i = 0; i < 10000; ++i) (void)hash_map_put(m, &i, sizeof i, NULL, (size_t)i, NULL);
+    int ok = 1;
+    for (int i = 0; i < 10000; ++i) {
+        const HashMapItem* it = hash_map_get(m, &i, sizeof i);
+        if (it == NULL || it->data_size != (size_t)i) ok = 0;
+    }
+    SHD_EXPECT(ok && m->size == 10000, "Map with an allocator hook must behave like a plain map");
+    SHD_EXPECT(counter.allocations > 2, "Growth must allocate through the hook");
+    SHD_EXPECT(counter.live_bytes == m->capacity * sizeof(HashMapItem) + m->capacity + HASH_MAP_GROUP_WIDTH,
+               "Only the current table must be live in the hook");
+
+    hash_map_destroy(m, NULL);
+    SHD_EXPECT(counter.live_bytes == 0, "Destroy must release every table through the hook");
+}
+
+static void test_sharded_basics_and_ownership(void) {
+    ShardedHashMap* m = build_sharded_hash_map(5, NULL, 0);
+    shd_free_count = 0;
+    SHD_EXPECT(m->shard_count == 8, "Shard count must round up to a power of two");
+
+    int* a = malloc(sizeof(int)); *a = 1;
+    int* b = malloc(sizeof(int)); *b = 2;
+    SHD_EXPECT(sharded_hash_map_put(m, "alpha", 5, a, sizeof(int), shd_free_counter) == 0, "First put must insert");
+    SHD_EXPECT(sharded_hash_map_put(m, "alpha", 5, b, sizeof(int), shd_free_counter) == 1, "Second put must update");
+    SHD_EXPECT(shd_free_count == 1, "Update must free the replaced owned value");
+
+    void* out = NULL;
+    size_t out_size = 0;
+    SHD_EXPECT(sharded_hash_map_get(m, "alpha", 5, &out, &out_size) == 1 && *(int*)out == 2 && out_size == sizeof(int),
+               "Get must return the updated value");
+    SHD_EXPECT(sharded_hash_map_get(m, "beta", 4, NULL, NULL) == 0, "Missing key must not be found");
+
+    for (int i = 0; i < 1000; ++i) (void)sharded_hash_map_put(m, &i, sizeof i, NULL, 0, NULL);
+    SHD_EXPECT(sharded_hash_map_size(m) == 1001, "Size must sum every shard");
+    size_t used_shards = 0;
+    for (size_t i = 0; i < m->shard_count; ++i) used_shards += m->map->segments[i].map->size > 0;
+    SHD_EXPECT(used_shards == m->shard_count, "Keys must spread over every shard");
+
+    SHD_EXPECT(sharded_hash_map_remove(m, "alpha", 5, shd_free_counter) == 1, "Remove must find the key");
+    SHD_EXPECT(sharded_hash_map_remove(m, "alpha", 5, shd_free_counter) == 0, "Second remove must report not found");
+    SHD_EXPECT(shd_free_count == 2 && sharded_hash_map_size(m) == 1000, "Remove must free the owned value");
+
+    sharded_hash_map_destroy(m, NULL);
+
+    shd_silence_stderr_begin();
+    sharded_hash_map_destroy(NULL, NULL);  /* documented no-op */
+    int null_remove = sharded_hash_map_remove(NULL, "alpha", 5, NULL);
+    shd_silence_stderr_end();
+    SHD_EXPECT(null_remove == 0, "Remove on a NULL map must return 0 like the other maps");
+    SHD_EXPECT(sharded_hash_map_get(NULL, "alpha", 5, NULL, NULL) == 0 && sharded_hash_map_size(NULL) == 0,
+               "Get/size on a NULL map must report nothing");
+}
+
+static void test_sharded_node_placement(void) {
+    int nodes = sharded_hash_map_node_count();
+    SHD_EXPECT(nodes >= 1, "At least one node must be reported");
+    int here = sharded_hash_map_current_node();
+    SHD_EXPECT(here >= 0 && here < nodes, "Current node must be an online node");
+
+    /* every shard homed (round-robin); big enough for tables above the placement threshold */
+    ShardedHashMap* placed = build_sharded_hash_map(4, NULL, 0);
+    int homed = 1;
+    for (size_t i = 0; i < placed->shard_count; ++i) {
+        if (placed->shards[i].node != (int)(i % (size_t)nodes)) homed = 0;
+    }
+    SHD_EXPECT(homed, "Shards must be homed round-robin over the online nodes");
+
+    for (uint32_t i = 0; i < 40000; ++i) (void)sharded_hash_map_put(placed, &i, sizeof i, NULL, i, NULL);
+    SHD_EXPECT(shd_placed_bytes(placed) > 0, "Large shard tables must go through the node-placement path");
+
+    int ok = 1;
+    for (uint32_t i = 0; i < 40000; ++i) {
+        size_t v = 0;
+        if (!sharded_hash_map_get(placed, &i, sizeof i, NULL, &v) || v != i) ok = 0;
+        if (sharded_hash_map_node_of(placed, &i, sizeof i) < 0) ok = 0;
+    }
+    SHD_EXPECT(ok, "Every key must be found in its node-placed shard");
+
+    /* explicit list: unplaced shards never use the placement path; out-of-range ids wrap */
+    const int list[2] = { SHARDED_HASH_MAP_NODE_ANY, nodes + 3 };
+    ShardedHashMap* mixed = build_sharded_hash_map(4, list, 2);
+    SHD_EXPECT(mixed->shards[0].node == SHARDED_HASH_MAP_NODE_ANY && mixed->shards[1].node == (nodes + 3) % nodes,
+               "Node list must repeat over the shards, wrapping unknown ids");
+    for (uint32_t i = 0; i < 40000; ++i) (void)sharded_hash_map_put(mixed, &i, sizeof i, NULL, i, NULL);
+    SHD_EXPECT(mixed->shards[0].placed_bytes == 0 && mixed->shards[2].placed_bytes == 0,
+               "Unplaced shards must use plain memory");
+    SHD_EXPECT(mixed->shards[1].placed_bytes > 0, "Homed shards must use the placement path");
+
+    sharded_hash_map_destroy(placed, NULL);
+    sharded_hash_map_destroy(mixed, NULL);
+}
+
+/* -------- Multithreaded, node-pinned workers -------- */
+
+typedef struct ShdWorkerArgs {
+    ShardedHashMap* map;
+    int             thread_id;
+    int             bound;     /* result of bind_thread_to_node */
+    int             on_node;   /* current_node matched the bound node */
+    int             errors;
+} ShdWorkerArgs;
+
+static void* shd_worker(void* p) {
+    ShdWorkerArgs* args = p;
+    int node = args->thread_id % sharded_hash_map_node_count();
+    args->bound = sharded_hash_map_bind_thread_to_node(node);
+    args->on_node = args->bound != 0 || sharded_hash_map_current_node() == node;
+
+    for (uint32_t i = 0; i < SHD_KEYS_PER_THR; ++i) {
+        uint32_t key = (uint32_t)args->thread_id * SHD_KEYS_PER_THR + i;
+        (void)sharded_hash_map_put(args->map, &key, sizeof key, NULL, key, NULL);
+    }
+    for (uint32_t i = 0; i < SHD_KEYS_PER_THR; ++i) {
+        uint32_t key = (uint32_t)args->thread_id * SHD_KEYS_PER_THR + i;
+        size_t v = 0;
+        if (!sharded_hash_map_get(args->map, &key, sizeof key, NULL, &v) || v != key) args->errors++;
+        if (i % 2 == 0 && sharded_hash_map_remove(args->map, &key, sizeof key, NULL) != 1) args->errors++;
+    }
+    return NULL;
+}
+
+static void test_sharded_concurrent_workers(void) {
+    ShardedHashMap* m = build_sharded_hash_map(16, NULL, 0);
+    pthread_t threads[SHD_THREADS];
+    ShdWorkerArgs args[SHD_THREADS];
+    size_t started = 0;
+
+    for (int t = 0; t < SHD_THREADS; ++t) {
+        args[t] = (ShdWorkerArgs){ m, t, -1, 0, 0 };
+        if (pthread_create(&threads[t], NULL, shd_worker, &args[t]) != 0) break;
+        started++;
+    }
+    for (size_t t = 0; t < started; ++t) pthread_join(threads[t], NULL);
+
+    int errors = 0, on_node = 1;
+    for (size_t t = 0; t < started; ++t) {
+        errors += args[t].errors;
+        if (!args[t].on_node) on_node = 0;
+    }
+    SHD_EXPECT(started == SHD_THREADS, "All worker threads must start");
+    SHD_EXPECT(errors == 0, "Workers must see their own writes");
+    SHD_EXPECT(on_node, "A thread bound to a node must run on that node");
+    SHD_EXPECT(sharded_hash_map_size(m) == started * SHD_KEYS_PER_THR / 2, "Half of every worker's keys must remain");
+
+    sharded_hash_map_destroy(m, NULL);
+}
+
+/* Single-thread put+get: sharded (node-placed tables) vs ConcurrentHashMap. */
+static void test_sharded_vs_concurrent_perf(void) {
+    enum { N = 200000 };
+
+    double t0 = shd_now_ms();
+    ShardedHashMap* s = build_sharded_hash_map(16, NULL, 0);
+    for (uint32_t i = 0; i < N; ++i) (void)sharded_hash_map_put(s, &i, sizeof i, NULL, 0, NULL);
+    size_t hits = 0;
+    for (uint32_t i = 0; i < N; ++i) hits += (size_t)sharded_hash_map_get(s, &i, sizeof i, NULL, NULL);
+    double t1 = shd_now_ms();
+
+    ConcurrentHashMap* c = build_concurrent_hash_map(16);
+    for (uint32_t i = 0; i < N; ++i) (void)concurrent_hash_map_put(c, &i, sizeof i, NULL, 0, NULL);
+    for (uint32_t i = 0; i < N; ++i) hits += (size_t)concurrent_hash_map_get(c, &i, sizeof i, NULL, NULL);
+    double t2 = shd_now_ms();
+
+    SHD_EXPECT(hits == 2 * (size_t)N, "Every key must be found in both maps");
+    printf("  timings: %d keys put+get (1 thread, %d node(s)): sharded=%.3f ms, concurrent=%.3f ms; "
+           "node-placed table bytes %zu\n",
+           N, s->node_count, t1 - t0, t2 - t1, shd_placed_bytes(s));
+
+    sharded_hash_map_destroy(s, NULL);
+    concurrent_hash_map_destroy(c, NULL);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_sharded_hashmap_tests(void) {
+    shd_passed = shd_failed = 0;
+    printf("[TEST] testing sharded hashmap...\n");
+
+    test_hash_map_allocator_hook();
+    test_sharded_basics_and_ownership();
+    test_sharded_node_placement();
+    test_sharded_concurrent_workers();
+    test_sharded_vs_concurrent_perf();
+
+    if (shd_failed == 0) {
+        printf("[TEST OK]  sharded hashmap: passed=%d failed=%d\n", shd_passed, shd_failed);
+    } else {
+        printf("[TEST FAIL] sharded hashmap: passed=%d failed=%d\n", shd_passed, shd_failed);
+    }
+}
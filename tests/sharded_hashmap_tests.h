@@ -0,0 +1,39 @@
+#ifndef SHARDED_HASHMAP_TESTS_H
+#define SHARDED_HASHMAP_TESTS_H
+
+#include "../hashmap/sharded_hashmap.h"
+#include "../hashmap/concurrent_hashmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>      /* timespec_get, struct timespec */
+#include <pthread.h>
+
+/* --- stderr silencer platform shims (same pattern as the BST tests) --- */
+#if defined(_WIN32)
+  #include <io.h>
+  #include <fcntl.h>
+  #define SHD_DEV_NULL  "NUL"
+  #define shd_dup       _dup
+  #define shd_dup2      _dup2
+  #define shd_open      _open
+  #define shd_close     _close
+  #define shd_fileno    _fileno
+  #define SHD_O_WRONLY  _O_WRONLY
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #define SHD_DEV_NULL  "/dev/null"
+  #define shd_dup       dup
+  #define shd_dup2      dup2
+  #define shd_open      open
+  #define shd_close     close
+  #define shd_fileno    fileno
+  #define SHD_O_WRONLY  O_WRONLY
+#endif
+
+/* Entry point for ShardedHashMap tests. */
+void run_all_sharded_hashmap_tests(void);
+
+#endif /* SHARDED_HASHMAP_TESTS_H */
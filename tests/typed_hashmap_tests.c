@@ -0,0 +1,200 @@
+#include "typed_hashmap_tests.h"
+
+static int thm_passed = 0;
+static int thm_failed = 0;
+
+#define THM_EXPECT(cond, msg)                                                   \
+    do {                                                                        \
+        if ((cond)) {                                                           \
+            thm_passed++;                                                       \
+        } else {                                                                \
+            thm_failed++;                                                       \
+            fprintf(stderr, "[THM FAIL] %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        }                                                                       \
+    } while (0)
+
+/* -------- Helpers -------- */
+
+static double thm_now_ms(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+/* --- stderr silencer (test-only) --- */
+static int thm_saved_stderr_fd = -1;
+
+static void thm_silence_stderr_begin(void) {
+    fflush(stderr);
+    thm_saved_stderr_fd = thm_dup(thm_fileno(stderr));
+    if (thm_saved_stderr_fd < 0) return;
+
+    int devnull = thm_open(THM_DEV_NULL, THM_O_WRONLY);
+    if (devnull >= 0) {
+        thm_dup2(devnull, thm_fileno(stderr));
+        thm_close(devnull);
+    }
+}
+
+static void thm_silence_stderr_end(void) {
+    if (thm_saved_stderr_fd >= 0) {
+        fflush(stderr);
+        thm_dup2(thm_saved_stderr_fd, thm_fileno(stderr));
+        thm_close(thm_saved_stderr_fd);
+        thm_saved_stderr_fd = -1;
+    }
+}
+
+static int thm_free_count = 0;
+static void thm_free_counter(void* p) {
+    if (p != NULL) {
+        free(p);
+        thm_free_count++;
+    }
+}
+
+static void thm_sum_visit(const HashMapU64Item* item, void* ctx) {
+    *(uint64_t*)ctx += item->key;
+}
+
+/* -------- Individual tests -------- */
+
+static void test_u64_upsert_and_ownership(void) {
+    HashMapU64* m = build_hash_map_u64();
+    thm_free_count = 0;
+
+    int* a = malloc(sizeof(int)); *a = 1;
+    int* b = malloc(sizeof(int)); *b = 2;
+    THM_EXPECT(hash_map_u64_put(m, 42, a, sizeof(int), thm_free_counter) == 0, "First put must insert");
+    THM_EXPECT(hash_map_u64_put(m, 42, b, sizeof(int), thm_free_counter) == 1, "Second put must update");
+    THM_EXPECT(thm_free_count == 1 && m->size == 1, "Update must free the old owned value exactly once");
+
+    const HashMapU64Item* it = hash_map_u64_get(m, 42);
+    THM_EXPECT(it != NULL && it->key == 42 && *(int*)it->data == 2, "Get must return the updated value");
+    THM_EXPECT(hash_map_u64_get(m, 43) == NULL, "Missing key must not be found");
+
+    /* extreme keys are ordinary keys */
+    THM_EXPECT(hash_map_u64_put(m, 0, NULL, 0, NULL) == 0, "Key 0 must insert");
+    THM_EXPECT(hash_map_u64_put(m, UINT64_MAX, NULL, 0, NULL) == 0, "Key UINT64_MAX must insert");
+    THM_EXPECT(hash_map_u64_get(m, 0) != NULL && hash_map_u64_get(m, UINT64_MAX) != NULL, "Extreme keys must be found");
+
+    THM_EXPECT(hash_map_u64_remove(m, 42, thm_free_counter) == 1, "Remove must find the key");
+    THM_EXPECT(hash_map_u64_remove(m, 42, thm_free_counter) == 0, "Second remove must report not found");
+    THM_EXPECT(thm_free_count == 2 && m->size == 2, "Remove must free the owned value");
+
+    hash_map_u64_destroy(m, thm_free_counter);
+
+    thm_silence_stderr_begin();
+    hash_map_u64_destroy(NULL, NULL);  /* documented no-op */
+    thm_silence_stderr_end();
+}
+
+/* Random churn checked against a plain array of expected values. */
+static void test_u64_churn_matches_reference(void) {
+    enum { KEYS = 4096, OPS = 200000 };
+    static size_t expected[KEYS];   /* 0 = absent, else data_size stored */
+    memset(expected, 0, sizeof expected);
+
+    HashMapU64* m = build_hash_map_u64_with_seed(hash_map_random_seed());
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    size_t live = 0;
+    int ok = 1;
+
+    for (int op = 0; op < OPS; ++op) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        size_t k = (size_t)(rng % KEYS);
+        uint64_t key = (uint64_t)k * 0x100000001ULL;  /* spread keys over both halves */
+
+        if ((rng >> 32) % 3 == 0) {
+            int removed = hash_map_u64_remove(m, key, NULL);
+            if (removed != (expected[k] != 0)) ok = 0;
+            if (removed) live--;
+            expected[k] = 0;
+        } else {
+            size_t v = (size_t)op + 1;
+            int updated = hash_map_u64_put(m, key, NULL, v, NULL);
+            if (updated != (expected[k] != 0)) ok = 0;
+            if (!updated) live++;
+            expected[k] = v;
+        }
+    }
+    for (size_t k = 0; k < KEYS; ++k) {
+        const HashMapU64Item* it = hash_map_u64_get(m, (uint64_t)k * 0x100000001ULL);
+        if ((it != NULL) != (expected[k] != 0)) ok = 0;
+        if (it != NULL && it->data_size != expected[k]) ok = 0;
+    }
+    THM_EXPECT(ok && m->size == live, "Typed map must agree with the reference after churn");
+    THM_EXPECT(m->size + m->tombstones <= m->capacity / 8 * 7, "Load limit must hold");
+
+    uint64_t sum = 0, expected_sum = 0;
+    hash_map_u64_for_each(m, thm_sum_visit, &sum);
+    for (size_t k = 0; k < KEYS; ++k) {
+        if (expected[k] != 0) expected_sum += (uint64_t)k * 0x100000001ULL;
+    }
+    THM_EXPECT(sum == expected_sum, "for_each must visit every live key once");
+
+    hash_map_u64_destroy(m, NULL);
+}
+
+static void test_u32_growth(void) {
+    HashMapU32* m = build_hash_map_u32();
+    for (uint32_t i = 0; i < 50000; ++i) (void)hash_map_u32_put(m, i * 2654435761u, NULL, i, NULL);
+
+    int all_found = 1;
+    for (uint32_t i = 0; i < 50000; ++i) {
+        const HashMapU32Item* it = hash_map_u32_get(m, i * 2654435761u);
+        if (it == NULL || it->data_size != i) all_found = 0;
+    }
+    THM_EXPECT(all_found && m->size == 50000, "HashMapU32 must keep every key across growth");
+    THM_EXPECT(sizeof(HashMapU32Item) < sizeof(HashMapItem), "Typed slots must be smaller than generic ones");
+    hash_map_u32_destroy(m, NULL);
+}
+
+/* Put + get of sequential ids: typed map vs generic HashMap (default and integer hash). */
+static void test_u64_vs_generic_perf(void) {
+    enum { N = 200000 };
+
+    double t0 = thm_now_ms();
+    HashMapU64* typed = build_hash_map_u64();
+    for (uint64_t i = 0; i < N; ++i) (void)hash_map_u64_put(typed, i, NULL, 0, NULL);
+    size_t hits = 0;
+    for (uint64_t i = 0; i < N; ++i) hits += hash_map_u64_get(typed, i) != NULL;
+    double t1 = thm_now_ms();
+
+    HashMap* murmur = build_hash_map();
+    for (uint64_t i = 0; i < N; ++i) (void)hash_map_put(murmur, &i, sizeof i, NULL, 0, NULL);
+    for (uint64_t i = 0; i < N; ++i) hits += hash_map_get(murmur, &i, sizeof i) != NULL;
+    double t2 = thm_now_ms();
+
+    HashMap* mixed = build_hash_map_with_hash(HASH_MAP_HASH_INT64, TYPED_HASH_MAP_DEFAULT_SEED);
+    for (uint64_t i = 0; i < N; ++i) (void)hash_map_put(mixed, &i, sizeof i, NULL, 0, NULL);
+    for (uint64_t i = 0; i < N; ++i) hits += hash_map_get(mixed, &i, sizeof i) != NULL;
+    double t3 = thm_now_ms();
+
+    THM_EXPECT(hits == 3 * (size_t)N, "Every id must be found in every map");
+    printf("  timings: %d u64 ids put+get: HashMapU64=%.3f ms, HashMap murmur3=%.3f ms, HashMap int64=%.3f ms; "
+           "slot bytes %zu vs %zu\n",
+           N, t1 - t0, t2 - t1, t3 - t2, sizeof(HashMapU64Item), sizeof(HashMapItem));
+
+    hash_map_u64_destroy(typed, NULL);
+    hash_map_destroy(murmur, NULL);
+    hash_map_destroy(mixed, NULL);
+}
+
+/* -------- Entry point -------- */
+
+void run_all_typed_hashmap_tests(void) {
+    thm_passed = thm_failed = 0;
+    printf("[TEST] testing typed hashmap...\n");
+
+    test_u64_upsert_and_ownership();
+    test_u64_churn_matches_reference();
+    test_u32_growth();
+    test_u64_vs_generic_perf();
+
+    if (thm_failed == 0) {
+        printf("[TEST OK]  typed hashmap: passed=%d failed=%d\n", thm_passed, thm_failed);
+    } else {
+        printf("[TEST FAIL] typed hashmap: passed=%d failed=%d\n", thm_passed, thm_failed);
+    }
+}
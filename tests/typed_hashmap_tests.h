@@ -0,0 +1,37 @@
+#ifndef TYPED_HASHMAP_TESTS_H
+#define TYPED_HASHMAP_TESTS_H
+
+#include "../hashmap/typed_hashmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>      /* timespec_get, struct timespec */
+
+/* --- stderr silencer platform shims (same pattern as the BST tests) --- */
+#if defined(_WIN32)
+  #include <io.h>
+  #include <fcntl.h>
+  #define THM_DEV_NULL  "NUL"
+  #define thm_dup       _dup
+  #define thm_dup2      _dup2
+  #define thm_open      _open
+  #define thm_close     _close
+  #define thm_fileno    _fileno
+  #define THM_O_WRONLY  _O_WRONLY
+#else
+  #include <unistd.h>
+  #include <fcntl.h>
+  #define THM_DEV_NULL  "/dev/null"
+  #define thm_dup       dup
+  #define thm_dup2      dup2
+  #define thm_open      open
+  #define thm_close     close
+  #define thm_fileno    fileno
+  #define THM_O_WRONLY  O_WRONLY
+#endif
+
+/* Entry point for typed (HashMapU64 / HashMapU32) hash map tests. */
+void run_all_typed_hashmap_tests(void);
+
+#endif /* TYPED_HASHMAP_TESTS_H */